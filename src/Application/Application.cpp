@@ -49,15 +49,20 @@ void Application<TPlatform, TGraphics, TUI>::Update() {
     HandleInput();
     HandleMenuBar();
     HandleFileTree();
+    HandleDuplicatesWindow();
+    HandleComparisonWindow();
+    HandleJobs();
+    HandleTraceOverlay();
 }
 
 template<typename TPlatform, typename TGraphics, typename TUI>
 void Application<TPlatform, TGraphics, TUI>::Shutdown() {
-    for (auto& [type, tex] : mFileIcons)
-        if (tex.id != 0)
-            mGraphics->DeleteTexture(tex);
+    if (mIconAtlas.id != 0)
+        mGraphics->DeleteTexture(mIconAtlas);
 
+    mIconAtlas = {};
     mFileIcons.clear();
+    mFolderIcon = {};
 }
 
 template<typename TPlatform, typename TGraphics, typename TUI>
@@ -85,25 +90,32 @@ TUI* Application<TPlatform, TGraphics, TUI>::GetUI() const
 }
 
 template<typename TPlatform, typename TGraphics, typename TUI>
-const Texture& Application<TPlatform, TGraphics, TUI>::GetFileIcon(PCKAssetFile::Type type) const {
-    static Texture empty{};
+const TextureRegion& Application<TPlatform, TGraphics, TUI>::GetFileIcon(PCKAssetFile::Type type) const {
+    static TextureRegion empty{};
     auto it = mFileIcons.find(type);
     return it != mFileIcons.end() ? it->second : empty;
 }
 
 template<typename TPlatform, typename TGraphics, typename TUI>
-void Application<TPlatform, TGraphics, TUI>::SetFileIcon(PCKAssetFile::Type type, const Texture& texture) {
-    mFileIcons[type] = texture;
+void Application<TPlatform, TGraphics, TUI>::SetFileIcon(PCKAssetFile::Type type, const TextureRegion& region) {
+    mFileIcons[type] = region;
 }
 
 template<typename TPlatform, typename TGraphics, typename TUI>
-const Texture& Application<TPlatform, TGraphics, TUI>::GetFolderIcon() const {
+const TextureRegion& Application<TPlatform, TGraphics, TUI>::GetFolderIcon() const {
     return mFolderIcon;
 }
 
 template<typename TPlatform, typename TGraphics, typename TUI>
-void Application<TPlatform, TGraphics, TUI>::SetFolderIcon(const Texture& texture) {
-    mFolderIcon = texture;
+void Application<TPlatform, TGraphics, TUI>::SetFolderIcon(const TextureRegion& region) {
+    mFolderIcon = region;
+}
+
+template<typename TPlatform, typename TGraphics, typename TUI>
+void Application<TPlatform, TGraphics, TUI>::SetIconAtlas(const Texture& texture) {
+    if (mIconAtlas.id != 0)
+        mGraphics->DeleteTexture(mIconAtlas);
+    mIconAtlas = texture;
 }
 
 template<typename TPlatform, typename TGraphics, typename TUI>
@@ -49,11 +49,15 @@ public:
     // Gets UI framework from the appliction
     TUI* GetUI() const;
 
-    const Texture& GetFileIcon(PCKAssetFile::Type type) const;
-    void SetFileIcon(PCKAssetFile::Type type, const Texture& texture);
+    // Icons are regions of one shared atlas texture
+    const TextureRegion& GetFileIcon(PCKAssetFile::Type type) const;
+    void SetFileIcon(PCKAssetFile::Type type, const TextureRegion& region);
 
-    const Texture& GetFolderIcon() const;
-    void SetFolderIcon(const Texture& texture);
+    const TextureRegion& GetFolderIcon() const;
+    void SetFolderIcon(const TextureRegion& region);
+
+    // Sets the atlas texture holding every icon; owned by the application
+    void SetIconAtlas(const Texture& texture);
 
     const Texture& GetPreviewTexture() const;
     void SetPreviewTexture(const Texture& texture);
@@ -67,10 +71,12 @@ private:
     std::unique_ptr<RendererBackend> mRendererBackend{};
     bool initialized{ false };
 
+    // Texture all icons are packed into
+    Texture mIconAtlas{};
     // Icons for File Tree Nodes, indexed via PCK filetypes
-    std::map<PCKAssetFile::Type, Texture> mFileIcons{};
-    // Texture for folders
-    Texture mFolderIcon{};
+    std::map<PCKAssetFile::Type, TextureRegion> mFileIcons{};
+    // Icon for folders
+    TextureRegion mFolderIcon{};
     // Current texture for the preview window
     Texture mPreviewTexture{};
 };
@@ -21,6 +21,12 @@ public:
         ImGui_ImplOpenGL2_NewFrame();
     }
 
+    // Re-uploads the font texture after the font atlas was rebuilt
+    void ReloadFonts() override {
+        ImGui_ImplOpenGL2_DestroyFontsTexture();
+        ImGui_ImplOpenGL2_CreateFontsTexture();
+    }
+
     // Runs the shut down / cleanup event
     void Shutdown() override {
         ImGui_ImplOpenGL2_Shutdown();
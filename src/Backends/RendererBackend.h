@@ -13,6 +13,9 @@ public:
 	// Runs the new frame event
 	virtual void NewFrame() = 0;
 
+	// Re-uploads the font texture after the font atlas was rebuilt
+	virtual void ReloadFonts() = 0;
+
 	// Runs the shut down / cleanup event
 	virtual void Shutdown() = 0;
 };
\ No newline at end of file
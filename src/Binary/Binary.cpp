@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <locale>
 #include <codecvt>
 #include "Binary/Binary.h"
@@ -15,6 +16,32 @@ uint32_t Binary::SwapInt32(uint32_t value)
 		((value & 0xFF000000) >> 24);
 }
 
+bool Binary::DetectVersionEndianness(uint32_t rawVersion, uint32_t minVersion, uint32_t maxVersion, uint32_t& version, Endianness& endianness)
+{
+	uint32_t versionSwapped = SwapInt32(rawVersion);
+
+	if (versionSwapped >= minVersion && versionSwapped <= maxVersion)
+	{
+		version = versionSwapped;
+		endianness = Endianness::BIG;
+		return true;
+	}
+
+	if (rawVersion >= minVersion && rawVersion <= maxVersion)
+	{
+		version = rawVersion;
+		endianness = Endianness::LITTLE;
+		return true;
+	}
+
+	return false;
+}
+
+size_t Binary::BoundedCapacity(uint32_t count, size_t bytesLeft, size_t minElementSize)
+{
+	return std::min<size_t>(count, bytesLeft / minElementSize);
+}
+
 void Binary::SwapUTF16Bytes(char16_t* buffer, size_t count) {
 	for (size_t i = 0; i < count; ++i) {
 		char16_t& c = buffer[i];
@@ -30,6 +30,13 @@ namespace Binary
 	// Swaps endianness of Int32 value
 	uint32_t SwapInt32(const uint32_t value);
 
+	// Works out the endianness of a file from the version it starts with, as read in either byte order, by which order puts it between minVersion and maxVersion;
+	// big endian is checked first, so versions that read the same both ways count as big endian. Returns false if neither order does
+	bool DetectVersionEndianness(uint32_t rawVersion, uint32_t minVersion, uint32_t maxVersion, uint32_t& version, Endianness& endianness);
+
+	// Bounds a count read from a file by how many elements of at least minElementSize the bytes left could hold, so a broken count can't reserve more than the file could ever fill
+	size_t BoundedCapacity(uint32_t count, size_t bytesLeft, size_t minElementSize);
+
 	// Swap endianness of UTF16 string
 	void SwapUTF16Bytes(char16_t* buffer, size_t count);
 
@@ -1,3 +1,4 @@
+#include <cstring>
 #include "Binary/BinaryReader.h"
 
 BinaryReader::BinaryReader(const std::string& filepath)
@@ -8,6 +9,11 @@ BinaryReader::BinaryReader(const std::string& filepath)
 	}
 }
 
+BinaryReader::BinaryReader(const unsigned char* data, size_t size)
+	: mData(data), mSize(size)
+{
+}
+
 void BinaryReader::SetEndianness(Binary::Endianness endianness)
 {
 	mEndianness = endianness;
@@ -38,6 +44,14 @@ uint32_t BinaryReader::ReadInt32()
 	return value;
 }
 
+float BinaryReader::ReadFloat()
+{
+	uint32_t bits = ReadInt32();
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
 std::u16string BinaryReader::ReadU16String(size_t length)
 {
 	std::u16string utf16str;
@@ -62,8 +76,57 @@ std::u16string BinaryReader::ReadU16String(size_t length)
 
 void BinaryReader::ReadData(void* buffer, size_t size)
 {
+	if (mData)
+	{
+		if (size > mSize - mPosition) {
+			throw std::runtime_error("Failed to read from memory.");
+		}
+		std::memcpy(buffer, mData + mPosition, size);
+		mPosition += size;
+		return;
+	}
+
 	mStream.read(reinterpret_cast<char*>(buffer), size);
 	if (mStream.gcount() != size) {
 		throw std::runtime_error("Failed to read from file.");
 	}
+}
+
+void BinaryReader::Skip(size_t size)
+{
+	if (mData)
+	{
+		if (size > mSize - mPosition) {
+			throw std::runtime_error("Failed to skip in memory.");
+		}
+		mPosition += size;
+		return;
+	}
+
+	mStream.seekg(size, std::ios::cur);
+	if (!mStream) {
+		throw std::runtime_error("Failed to skip in file.");
+	}
+}
+
+size_t BinaryReader::GetPosition()
+{
+	return mData ? mPosition : static_cast<size_t>(mStream.tellg());
+}
+
+void BinaryReader::Seek(size_t position)
+{
+	if (mData)
+	{
+		if (position > mSize) {
+			throw std::runtime_error("Failed to seek in memory.");
+		}
+		mPosition = position;
+		return;
+	}
+
+	mStream.seekg(position, std::ios::beg);
+	if (!mStream) {
+		throw std::runtime_error("Failed to seek in file.");
+	}
 }
\ No newline at end of file
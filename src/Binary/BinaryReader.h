@@ -7,6 +7,10 @@ class BinaryReader
 {
 public:
 	BinaryReader(const std::string& filepath);
+
+	// Reads from memory instead of a file; the data has to outlive the reader
+	BinaryReader(const unsigned char* data, size_t size);
+
 	~BinaryReader()
 	{
 		if (mStream)
@@ -25,13 +29,28 @@ public:
 	// Reads 32 bit unsigned int
 	uint32_t ReadInt32();
 
+	// Reads 32 bit float
+	float ReadFloat();
+
 	// Reads a U16 string by length
 	std::u16string ReadU16String(size_t length);
 
 	// Reads data into buffer of a given size
 	void ReadData(void* buffer, size_t size);
 
+	// Skips over a given amount of bytes without reading them
+	void Skip(size_t size);
+
+	// Gets how many bytes in the reader is
+	size_t GetPosition();
+
+	// Moves the reader to a given byte
+	void Seek(size_t position);
+
 private:
 	std::ifstream mStream;
+	const unsigned char* mData{ nullptr }; // only set when reading from memory
+	size_t mSize{ 0 };
+	size_t mPosition{ 0 };
 	Binary::Endianness mEndianness = Binary::Endianness::LITTLE; // default to little since Little is used by more editions of the game
 };
\ No newline at end of file
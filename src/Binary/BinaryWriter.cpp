@@ -1,3 +1,4 @@
+#include <cstring>
 #include "Binary/BinaryWriter.h"
 
 BinaryWriter::BinaryWriter(const std::string& filepath)
@@ -8,6 +9,11 @@ BinaryWriter::BinaryWriter(const std::string& filepath)
 	}
 }
 
+BinaryWriter::BinaryWriter(std::vector<unsigned char>& buffer)
+	: mBuffer(&buffer)
+{
+}
+
 const void BinaryWriter::SetEndianness(Binary::Endianness endianness)
 {
 	mEndianness = endianness;
@@ -32,6 +38,13 @@ void BinaryWriter::WriteInt32(uint32_t value)
 	WriteData(&value, sizeof(value));
 }
 
+void BinaryWriter::WriteFloat(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	WriteInt32(bits);
+}
+
 void BinaryWriter::WriteU16String(const std::u16string& utf16str)
 {
 	for (char16_t ch : utf16str)
@@ -53,6 +66,13 @@ void BinaryWriter::WriteU16String(const std::u16string& utf16str)
 
 const void BinaryWriter::WriteData(const void* buffer, size_t size)
 {
+	if (mBuffer)
+	{
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(buffer);
+		mBuffer->insert(mBuffer->end(), bytes, bytes + size);
+		return;
+	}
+
 	if (!mStream.write(reinterpret_cast<const char*>(buffer), size)) {
 		throw std::runtime_error("Failed to write to file.");
 	}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include "Binary/Binary.h"
 
 // Barebones binary writer because it's nice I guess; inspired by miku666/NessieHax/nullptr's EndiannessAwareBinaryWriter from the OMI/PCK Studio code <3
@@ -7,6 +8,10 @@ class BinaryWriter
 {
 public:
 	BinaryWriter(const std::string& filepath);
+
+	// Writes to the end of a buffer instead of a file; the buffer has to outlive the writer
+	BinaryWriter(std::vector<unsigned char>& buffer);
+
 	~BinaryWriter()
 	{
 		if (mStream)
@@ -25,6 +30,9 @@ public:
 	// Writes 32 bit unsigned int
 	void WriteInt32(const uint32_t value);
 
+	// Writes 32 bit float
+	void WriteFloat(const float value);
+
 	// Writes U16 string of length
 	void WriteU16String(const std::u16string& utf16str);
 
@@ -33,5 +41,6 @@ public:
 
 private:
 	std::ofstream mStream;
+	std::vector<unsigned char>* mBuffer{ nullptr }; // only set when writing to memory
 	Binary::Endianness mEndianness = Binary::Endianness::LITTLE; // default to little since Little is used by more editions of the game
 };
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <stdexcept>
+#include "Binary/BinaryReader.h"
+#include "Binary/BinaryWriter.h"
+#include "Formats/BehavioursFile.h"
+#include "Util/Log.h"
+
+void BehavioursFile::Read(const unsigned char* data, size_t size)
+{
+	mBehaviours.clear();
+
+	BinaryReader reader(data, size);
+
+	uint32_t version;
+	reader.ReadData(&version, 4);
+
+	if (!Binary::DetectVersionEndianness(version, 0, 0xFF, mVersion, mEndianness))
+		throw std::runtime_error("Invalid behaviours.bin version");
+
+	reader.SetEndianness(mEndianness);
+
+	uint32_t count = reader.ReadInt32();
+	mBehaviours.reserve(Binary::BoundedCapacity(count, size - reader.GetPosition(), 6));
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		Behaviour& behaviour = mBehaviours.emplace_back();
+		behaviour.name = ReadString(reader);
+
+		uint32_t overrideCount = reader.ReadInt32();
+		behaviour.overrides.reserve(Binary::BoundedCapacity(overrideCount, size - reader.GetPosition(), 14));
+
+		for (uint32_t j = 0; j < overrideCount; ++j)
+		{
+			PositionOverride& positionOverride = behaviour.overrides.emplace_back();
+			positionOverride.tamed = reader.ReadInt8();
+			positionOverride.saddled = reader.ReadInt8();
+			positionOverride.x = reader.ReadFloat();
+			positionOverride.y = reader.ReadFloat();
+			positionOverride.z = reader.ReadFloat();
+		}
+	}
+
+	if (reader.GetPosition() != size)
+		throw std::runtime_error("behaviours.bin has " + std::to_string(size - reader.GetPosition()) + " bytes after its behaviours");
+
+	LOG_DEBUG("behaviours.bin version %u, %zu behaviours", mVersion, mBehaviours.size());
+}
+
+void BehavioursFile::Write(std::vector<unsigned char>& out) const
+{
+	BinaryWriter writer(out);
+	writer.SetEndianness(mEndianness);
+
+	writer.WriteInt32(mVersion);
+	writer.WriteInt32(static_cast<uint32_t>(mBehaviours.size()));
+
+	for (const auto& behaviour : mBehaviours)
+	{
+		WriteString(writer, behaviour.name);
+		writer.WriteInt32(static_cast<uint32_t>(behaviour.overrides.size()));
+
+		for (const auto& positionOverride : behaviour.overrides)
+		{
+			writer.WriteInt8(positionOverride.tamed);
+			writer.WriteInt8(positionOverride.saddled);
+			writer.WriteFloat(positionOverride.x);
+			writer.WriteFloat(positionOverride.y);
+			writer.WriteFloat(positionOverride.z);
+		}
+	}
+}
+
+uint32_t BehavioursFile::getVersion() const
+{
+	return mVersion;
+}
+
+Binary::Endianness BehavioursFile::getEndianness() const
+{
+	return mEndianness;
+}
+
+const std::vector<BehavioursFile::Behaviour>& BehavioursFile::getBehaviours() const
+{
+	return mBehaviours;
+}
+
+std::vector<BehavioursFile::Behaviour>& BehavioursFile::getBehaviours()
+{
+	return mBehaviours;
+}
+
+std::string BehavioursFile::ReadString(BinaryReader& reader)
+{
+	std::string value(reader.ReadInt16(), '\0');
+	reader.ReadData(value.data(), value.size());
+	return value;
+}
+
+void BehavioursFile::WriteString(BinaryWriter& writer, const std::string& value)
+{
+	if (value.size() > 0xFFFF)
+		throw std::runtime_error("behaviours.bin strings can't be longer than 65535 bytes");
+
+	writer.WriteInt16(static_cast<uint16_t>(value.size()));
+	writer.WriteData(value.data(), value.size());
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Binary/Binary.h"
+
+class BinaryReader;
+class BinaryWriter;
+
+// Behaviours File research done by NessieHax/Miku666/nullptr, PhoenixARC, and many others over the years.
+
+// Entity behaviours of texture packs (behaviours.bin); so far only where riders sit on an entity, depending on its state
+class BehavioursFile
+{
+public:
+	// Where a rider sits while the entity is tamed and/or saddled
+	struct PositionOverride
+	{
+		uint8_t tamed{ 0 }; // kept as read, so flags that aren't 0 or 1 still write back the same
+		uint8_t saddled{ 0 };
+		float x{}, y{}, z{};
+
+		// Gets whether the entity has to be tamed
+		bool isTamed() const { return tamed != 0; }
+
+		// Gets whether the entity has to be saddled
+		bool isSaddled() const { return saddled != 0; }
+
+		// Sets whether the entity has to be tamed, leaving the byte alone if it already says so
+		void setTamed(bool value) { if (isTamed() != value) tamed = value ? 1 : 0; }
+
+		// Sets whether the entity has to be saddled, leaving the byte alone if it already says so
+		void setSaddled(bool value) { if (isSaddled() != value) saddled = value ? 1 : 0; }
+	};
+
+	struct Behaviour
+	{
+		std::string name{}; // the entity, like "horse"
+		std::vector<PositionOverride> overrides{};
+	};
+
+	// Reads a Behaviours File from memory
+	void Read(const unsigned char* data, size_t size);
+
+	// Writes the Behaviours File to the end of a buffer, in the version and endianness it was read in
+	void Write(std::vector<unsigned char>& out) const;
+
+	// Gets the Behaviours File version
+	uint32_t getVersion() const;
+
+	// Gets the Behaviours File Endianness
+	Binary::Endianness getEndianness() const;
+
+	// Gets every behaviour, in file order
+	const std::vector<Behaviour>& getBehaviours() const;
+
+	// Gets every behaviour to change; names have to stay under 65536 bytes to be written
+	std::vector<Behaviour>& getBehaviours();
+
+private:
+	// Reads a string's length and then its UTF-8 bytes
+	static std::string ReadString(BinaryReader& reader);
+
+	// Writes a string's length and then its UTF-8 bytes; throws if it's too long to have its length written
+	static void WriteString(BinaryWriter& writer, const std::string& value);
+
+	uint32_t mVersion{ 0 };
+	Binary::Endianness mEndianness{ Binary::Endianness::BIG };
+	std::vector<Behaviour> mBehaviours{};
+};
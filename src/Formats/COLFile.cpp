@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "Binary/BinaryReader.h"
+#include "Formats/COLFile.h"
+#include "Util/Log.h"
+#include "Util/Trace.h"
+
+void COLFile::Read(const unsigned char* data, size_t size)
+{
+	TRACE_SCOPE("COLFile::Read");
+
+	mData.assign(data, data + size);
+	mModified = false;
+	mNames.clear();
+	mColours.clear();
+	mOffsets.clear();
+	mIndex.clear();
+	mWaterNames.clear();
+	mWaterColours.clear();
+	mWaterOffsets.clear();
+	mWaterIndex.clear();
+
+	BinaryReader reader(mData.data(), mData.size());
+
+	uint32_t version;
+	reader.ReadData(&version, 4);
+
+	if (!Binary::DetectVersionEndianness(version, 0, 1, mVersion, mEndianness))
+		throw std::runtime_error("Invalid COL version");
+
+	reader.SetEndianness(mEndianness);
+
+	// every colour is at least 6 bytes
+	uint32_t colourCount = reader.ReadInt32();
+	size_t capacity = Binary::BoundedCapacity(colourCount, mData.size() - reader.GetPosition(), 6);
+	mNames.reserve(capacity);
+	mColours.reserve(capacity);
+	mOffsets.reserve(capacity);
+	mIndex.reserve(capacity);
+
+	for (uint32_t i = 0; i < colourCount; ++i)
+	{
+		mNames.push_back(ReadString(reader));
+		mOffsets.push_back(static_cast<uint32_t>(reader.GetPosition()));
+		mColours.push_back(reader.ReadInt32());
+		mIndex.emplace(mNames.back(), i); // duplicate names find the first, like the game
+	}
+
+	if (mVersion > 0)
+	{
+		uint32_t waterCount = reader.ReadInt32();
+		capacity = Binary::BoundedCapacity(waterCount, mData.size() - reader.GetPosition(), 14);
+		mWaterNames.reserve(capacity);
+		mWaterColours.reserve(capacity * 3);
+		mWaterOffsets.reserve(capacity);
+		mWaterIndex.reserve(capacity);
+
+		for (uint32_t i = 0; i < waterCount; ++i)
+		{
+			mWaterNames.push_back(ReadString(reader));
+			mWaterOffsets.push_back(static_cast<uint32_t>(reader.GetPosition()));
+			mWaterColours.push_back(reader.ReadInt32());
+			mWaterColours.push_back(reader.ReadInt32());
+			mWaterColours.push_back(reader.ReadInt32());
+			mWaterIndex.emplace(mWaterNames.back(), i);
+		}
+	}
+
+	if (reader.GetPosition() != mData.size())
+		LOG_WARNING("COL File has %zu bytes after its colours", mData.size() - reader.GetPosition());
+
+	LOG_DEBUG("COL version %u, %zu colours, %zu water colours", mVersion, mNames.size(), mWaterNames.size());
+}
+
+void COLFile::Write(std::vector<unsigned char>& out) const
+{
+	out.insert(out.end(), mData.begin(), mData.end());
+}
+
+uint32_t COLFile::getVersion() const
+{
+	return mVersion;
+}
+
+Binary::Endianness COLFile::getEndianness() const
+{
+	return mEndianness;
+}
+
+size_t COLFile::getColourCount() const
+{
+	return mNames.size();
+}
+
+std::string_view COLFile::getColourName(size_t index) const
+{
+	return mNames[index];
+}
+
+uint32_t COLFile::getColour(size_t index) const
+{
+	return mColours[index];
+}
+
+void COLFile::setColour(size_t index, uint32_t argb)
+{
+	if (index >= mColours.size())
+		throw std::out_of_range("Invalid COL colour index");
+
+	if (mColours[index] == argb)
+		return;
+
+	mColours[index] = argb;
+	PatchColour(mOffsets[index], argb);
+}
+
+int COLFile::findColour(std::string_view name) const
+{
+	auto it = mIndex.find(name);
+	return it != mIndex.end() ? static_cast<int>(it->second) : -1;
+}
+
+size_t COLFile::getWaterColourCount() const
+{
+	return mWaterNames.size();
+}
+
+std::string_view COLFile::getWaterColourName(size_t index) const
+{
+	return mWaterNames[index];
+}
+
+uint32_t COLFile::getWaterColour(size_t index, WaterColour colour) const
+{
+	return mWaterColours[index * 3 + static_cast<size_t>(colour)];
+}
+
+void COLFile::setWaterColour(size_t index, WaterColour colour, uint32_t argb)
+{
+	if (index >= mWaterNames.size())
+		throw std::out_of_range("Invalid COL water colour index");
+
+	uint32_t& value = mWaterColours[index * 3 + static_cast<size_t>(colour)];
+	if (value == argb)
+		return;
+
+	value = argb;
+	PatchColour(mWaterOffsets[index] + static_cast<size_t>(colour) * 4, argb);
+}
+
+int COLFile::findWaterColour(std::string_view name) const
+{
+	auto it = mWaterIndex.find(name);
+	return it != mWaterIndex.end() ? static_cast<int>(it->second) : -1;
+}
+
+bool COLFile::isModified() const
+{
+	return mModified;
+}
+
+std::string_view COLFile::ReadString(BinaryReader& reader)
+{
+	uint16_t length = reader.ReadInt16();
+	size_t position = reader.GetPosition();
+	reader.Skip(length);
+
+	return std::string_view(reinterpret_cast<const char*>(mData.data() + position), length);
+}
+
+void COLFile::PatchColour(size_t offset, uint32_t argb)
+{
+	if (mEndianness == Binary::Endianness::BIG)
+		argb = Binary::SwapInt32(argb);
+
+	std::memcpy(mData.data() + offset, &argb, 4);
+	mModified = true;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Binary/Binary.h"
+
+class BinaryReader;
+
+// COL File research done by NessieHax/Miku666/nullptr, PhoenixARC, and many others over the years.
+
+// Colour tables (colours.col); named ARGB colours, and named water colours from version 1 on
+class COLFile
+{
+public:
+	// Which of a water colour's three colours
+	enum class WaterColour
+	{
+		SURFACE,
+		UNDERWATER,
+		FOG
+	};
+
+	COLFile() = default;
+
+	// names are views into the data, which moves along with the COL File but wouldn't be copied along with it
+	COLFile(const COLFile&) = delete;
+	COLFile& operator=(const COLFile&) = delete;
+	COLFile(COLFile&&) = default;
+	COLFile& operator=(COLFile&&) = default;
+
+	// Reads a COL File from memory, keeping its own copy of the data so changed colours can be written straight into it
+	void Read(const unsigned char* data, size_t size);
+
+	// Writes the COL File to the end of a buffer; colours are changed in place, so this is just a copy of the data
+	void Write(std::vector<unsigned char>& out) const;
+
+	// Gets the COL version; 1 has water colours
+	uint32_t getVersion() const;
+
+	// Gets the COL File Endianness
+	Binary::Endianness getEndianness() const;
+
+	// Gets how many colours there are
+	size_t getColourCount() const;
+
+	// Gets a colour's name, like "Sky_Ocean"
+	std::string_view getColourName(size_t index) const;
+
+	// Gets a colour as ARGB
+	uint32_t getColour(size_t index) const;
+
+	// Changes a colour, given as ARGB
+	void setColour(size_t index, uint32_t argb);
+
+	// Finds the index of a colour by name; -1 if there's no such colour
+	int findColour(std::string_view name) const;
+
+	// Gets how many water colours there are
+	size_t getWaterColourCount() const;
+
+	// Gets a water colour's name, which is the name of the biome it's for
+	std::string_view getWaterColourName(size_t index) const;
+
+	// Gets one of a water colour's colours as ARGB
+	uint32_t getWaterColour(size_t index, WaterColour colour) const;
+
+	// Changes one of a water colour's colours, given as ARGB
+	void setWaterColour(size_t index, WaterColour colour, uint32_t argb);
+
+	// Finds the index of a water colour by name; -1 if there's no such water colour
+	int findWaterColour(std::string_view name) const;
+
+	// Checks if any colour was changed since the COL File was read
+	bool isModified() const;
+
+private:
+	// Reads a string's length and points a view at its bytes, without copying them
+	std::string_view ReadString(BinaryReader& reader);
+
+	// Writes a colour over the one at an offset in the data
+	void PatchColour(size_t offset, uint32_t argb);
+
+	std::vector<unsigned char> mData{};
+	uint32_t mVersion{ 0 };
+	Binary::Endianness mEndianness{ Binary::Endianness::BIG };
+	bool mModified{ false };
+
+	// kept as parallel arrays, since the editor and lookups only ever want one of them at a time
+	std::vector<std::string_view> mNames{};
+	std::vector<uint32_t> mColours{};
+	std::vector<uint32_t> mOffsets{}; // where each colour is in the data
+	std::unordered_map<std::string_view, uint32_t> mIndex{};
+
+	std::vector<std::string_view> mWaterNames{};
+	std::vector<uint32_t> mWaterColours{}; // surface, underwater and fog of each water colour, one after another
+	std::vector<uint32_t> mWaterOffsets{}; // where each water colour's surface colour is in the data
+	std::unordered_map<std::string_view, uint32_t> mWaterIndex{};
+};
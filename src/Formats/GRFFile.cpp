@@ -0,0 +1,415 @@
+#include <algorithm>
+#include <stdexcept>
+#include "Binary/BinaryReader.h"
+#include "Binary/BinaryWriter.h"
+#include "Formats/GRFFile.h"
+#include "Util/Hash.h"
+#include "Util/Log.h"
+#include "Util/Trace.h"
+#include "Util/Zlib.h"
+
+namespace
+{
+	// deep enough for any real rules, and keeps broken files from running the stack out
+	constexpr int MAX_RULE_DEPTH = 512;
+
+	// where the CRC is in the header, after the version and compression
+	constexpr size_t CRC_OFFSET = 3;
+
+	// 4J's run length encoding; 255 starts a run, followed by the run length - 1 and then the byte, unless the run is of 255s short enough to not need the byte
+	class RLEDecoder
+	{
+	public:
+		explicit RLEDecoder(std::vector<unsigned char>& out) : mOut(out) {}
+
+		void Decode(const unsigned char* data, size_t size)
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				unsigned char value = data[i];
+
+				switch (mState)
+				{
+				case State::LITERAL:
+					if (value == 255)
+						mState = State::COUNT;
+					else
+						mOut.push_back(value);
+					break;
+				case State::COUNT:
+					mCount = value;
+					if (mCount < 3)
+					{
+						mOut.insert(mOut.end(), mCount + 1, 255);
+						mState = State::LITERAL;
+					}
+					else
+						mState = State::VALUE;
+					break;
+				case State::VALUE:
+					mOut.insert(mOut.end(), mCount + 1, value);
+					mState = State::LITERAL;
+					break;
+				}
+			}
+		}
+
+		// Checks that the data didn't stop in the middle of a run
+		bool isComplete() const { return mState == State::LITERAL; }
+
+	private:
+		enum class State { LITERAL, COUNT, VALUE };
+
+		std::vector<unsigned char>& mOut;
+		State mState{ State::LITERAL };
+		unsigned int mCount{ 0 };
+	};
+
+	void RLEEncode(const unsigned char* data, size_t size, std::vector<unsigned char>& out)
+	{
+		out.reserve(out.size() + size);
+
+		size_t i = 0;
+		while (i < size)
+		{
+			unsigned char value = data[i];
+			size_t count = 1;
+			while (count < 256 && i + count < size && data[i + count] == value)
+				++count;
+
+			if (count <= 3)
+			{
+				if (value == 255)
+				{
+					out.push_back(255);
+					out.push_back(static_cast<unsigned char>(count - 1));
+				}
+				else
+					out.insert(out.end(), count, value);
+			}
+			else
+			{
+				out.push_back(255);
+				out.push_back(static_cast<unsigned char>(count - 1));
+				out.push_back(value);
+			}
+
+			i += count;
+		}
+	}
+}
+
+void GRFFile::Read(const unsigned char* data, size_t size)
+{
+	TRACE_SCOPE("GRFFile::Read");
+
+	mHeader.clear();
+	mRules.clear();
+	mStrings.clear();
+	mEdits.clear();
+	mRoot = Rule();
+
+	BinaryReader reader(data, size);
+	reader.SetEndianness(Binary::Endianness::BIG);
+
+	mVersion = reader.ReadInt16();
+	uint8_t compression = reader.ReadInt8();
+	if (compression > static_cast<uint8_t>(Compression::COMPRESSED_RLE_CRC))
+		throw std::runtime_error("Invalid GRF compression type");
+	mCompression = static_cast<Compression>(compression);
+	mCRCSource = CRCSource::NONE;
+	uint32_t crc = reader.ReadInt32();
+	reader.Skip(4); // unknown, always 0 in every file so far
+
+	mHeader.assign(data, data + reader.GetPosition());
+
+	if (mCompression == Compression::NONE)
+	{
+		mRules.assign(data + reader.GetPosition(), data + size);
+	}
+	else
+	{
+		uint32_t rulesSize = reader.ReadInt32();
+		uint32_t compressedSize = reader.ReadInt32();
+
+		size_t position = reader.GetPosition();
+		if (compressedSize > size - position)
+			throw std::runtime_error("GRF compressed size is past the end of the file");
+
+		const unsigned char* compressed = data + position;
+
+		// rules sizes are straight from the file, so don't trust them with more than the data could decompress to
+		mRules.reserve(std::min<size_t>(rulesSize, static_cast<size_t>(compressedSize) * 1032));
+
+		RLEDecoder decoder(mRules);
+
+		if (mCompression == Compression::RLE)
+		{
+			decoder.Decode(compressed, compressedSize);
+		}
+		else
+		{
+			if (compressedSize < 2 || (compressed[0] & 0x0F) != 8)
+				throw std::runtime_error("Only zlib compressed GRF Files are supported; Xbox 360 GRF Files use LZX");
+
+			// decoded as it's inflated, so the RLE data never has to be held all at once
+			Zlib::Inflate(compressed, compressedSize, [&](const unsigned char* piece, size_t pieceSize) {
+				decoder.Decode(piece, pieceSize);
+			});
+		}
+
+		if (!decoder.isComplete())
+			throw std::runtime_error("GRF rules end in the middle of a run");
+
+		if (mRules.size() != rulesSize)
+			LOG_WARNING("GRF rules decompressed to %zu bytes, expected %u", mRules.size(), rulesSize);
+
+		// which data the CRC covers isn't known for sure, so it's checked against both; Write recomputes whichever one matched
+		if (mCompression == Compression::COMPRESSED_RLE_CRC)
+		{
+			if (Hash::CRC32(mRules.data(), mRules.size()) == crc)
+				mCRCSource = CRCSource::RULES;
+			else if (Hash::CRC32(compressed, compressedSize) == crc)
+				mCRCSource = CRCSource::PAYLOAD;
+			else
+				LOG_WARNING("GRF CRC %08X doesn't match the rules, so the file can't be written back", crc);
+		}
+	}
+
+	BinaryReader rulesReader(mRules.data(), mRules.size());
+	rulesReader.SetEndianness(Binary::Endianness::BIG);
+
+	uint32_t stringCount = rulesReader.ReadInt32();
+	mStrings.reserve(Binary::BoundedCapacity(stringCount, mRules.size() - rulesReader.GetPosition(), 2));
+	for (uint32_t i = 0; i < stringCount; ++i)
+	{
+		uint16_t length = rulesReader.ReadInt16();
+		size_t position = rulesReader.GetPosition();
+		rulesReader.Skip(length);
+		mStrings.emplace_back(reinterpret_cast<const char*>(mRules.data() + position), length);
+	}
+
+	// the rules are skimmed through once to find where they end and make sure they're all there, but only the top level is kept
+	mRoot.start = rulesReader.GetPosition();
+	mRoot.childCount = rulesReader.ReadInt32();
+	mRoot.childrenStart = rulesReader.GetPosition();
+	for (uint32_t i = 0; i < mRoot.childCount; ++i)
+		SkipRule(rulesReader, 1);
+	mRoot.end = rulesReader.GetPosition();
+
+	expandRule(mRoot);
+
+	LOG_DEBUG("GRF version %u, compression %u, %zu bytes of rules, %zu strings, %u top level rules", mVersion, compression, mRules.size(), mStrings.size(), mRoot.childCount);
+}
+
+void GRFFile::Write(std::vector<unsigned char>& out, unsigned int threadCount) const
+{
+	TRACE_SCOPE("GRFFile::Write");
+
+	if (!canWrite())
+		throw std::runtime_error("GRF CRC doesn't match the rules, so writing it back would leave a file the game rejects");
+
+	std::vector<unsigned char> rules;
+
+	if (!mRoot.modified)
+	{
+		rules = mRules;
+	}
+	else
+	{
+		rules.reserve(mRules.size());
+		rules.insert(rules.end(), mRules.begin(), mRules.begin() + mRoot.start);
+
+		BinaryWriter writer(rules);
+		writer.SetEndianness(Binary::Endianness::BIG);
+		writer.WriteInt32(mRoot.childCount);
+		for (const auto& child : mRoot.children)
+			WriteRule(writer, child);
+
+		// whatever comes after the rules, like the files of world templates
+		rules.insert(rules.end(), mRules.begin() + mRoot.end, mRules.end());
+	}
+
+	if (mCompression == Compression::NONE)
+	{
+		out.insert(out.end(), mHeader.begin(), mHeader.end());
+		out.insert(out.end(), rules.begin(), rules.end());
+		return;
+	}
+
+	std::vector<unsigned char> encoded;
+	RLEEncode(rules.data(), rules.size(), encoded);
+
+	if (mCompression != Compression::RLE)
+		encoded = Zlib::Deflate(encoded.data(), encoded.size(), threadCount);
+
+	size_t headerStart = out.size();
+	out.insert(out.end(), mHeader.begin(), mHeader.end());
+
+	// the compressed data never comes out the same twice, so the CRC always has to be redone
+	if (mCompression == Compression::COMPRESSED_RLE_CRC)
+	{
+		uint32_t crc = mCRCSource == CRCSource::RULES ? Hash::CRC32(rules.data(), rules.size()) : Hash::CRC32(encoded.data(), encoded.size());
+		for (size_t i = 0; i < 4; ++i)
+			out[headerStart + CRC_OFFSET + i] = static_cast<unsigned char>(crc >> (24 - i * 8));
+	}
+
+	BinaryWriter writer(out);
+	writer.SetEndianness(Binary::Endianness::BIG);
+	writer.WriteInt32(static_cast<uint32_t>(rules.size()));
+	writer.WriteInt32(static_cast<uint32_t>(encoded.size()));
+	writer.WriteData(encoded.data(), encoded.size());
+}
+
+uint16_t GRFFile::getVersion() const
+{
+	return mVersion;
+}
+
+GRFFile::Compression GRFFile::getCompression() const
+{
+	return mCompression;
+}
+
+size_t GRFFile::getRulesSize() const
+{
+	return mRules.size();
+}
+
+size_t GRFFile::getStringCount() const
+{
+	return mStrings.size();
+}
+
+std::string_view GRFFile::getString(uint32_t id) const
+{
+	return id < mStrings.size() ? mStrings[id] : std::string_view();
+}
+
+GRFFile::Rule& GRFFile::getRoot()
+{
+	return mRoot;
+}
+
+void GRFFile::expandRule(Rule& rule)
+{
+	if (rule.expanded)
+		return;
+
+	// the whole tree was checked when it was read, so this can't run off the end
+	BinaryReader reader(mRules.data(), mRules.size());
+	reader.SetEndianness(Binary::Endianness::BIG);
+	reader.Seek(rule.childrenStart);
+
+	rule.children.resize(rule.childCount);
+	for (auto& child : rule.children)
+	{
+		ReadRule(reader, child, 0);
+		child.parent = &rule;
+	}
+
+	rule.expanded = true;
+}
+
+void GRFFile::setAttribute(Rule& rule, size_t index, std::string value)
+{
+	if (index >= rule.attributes.size())
+		throw std::out_of_range("Invalid GRF attribute index");
+	if (value.size() > 0xFFFF)
+		throw std::runtime_error("GRF attribute values can't be longer than 65535 bytes");
+
+	Attribute& attribute = rule.attributes[index];
+
+	if (attribute.edit < 0)
+	{
+		attribute.edit = static_cast<int>(mEdits.size());
+		mEdits.push_back(std::move(value));
+	}
+	else
+		mEdits[attribute.edit] = std::move(value);
+
+	attribute.value = mEdits[attribute.edit];
+
+	for (Rule* changed = &rule; changed && !changed->modified; changed = changed->parent)
+		changed->modified = true;
+}
+
+bool GRFFile::isModified() const
+{
+	return mRoot.modified;
+}
+
+bool GRFFile::canWrite() const
+{
+	return mCompression != Compression::COMPRESSED_RLE_CRC || mCRCSource != CRCSource::NONE;
+}
+
+void GRFFile::ReadRule(BinaryReader& reader, Rule& rule, int depth)
+{
+	rule.start = reader.GetPosition();
+	rule.nameID = reader.ReadInt32();
+
+	uint32_t attributeCount = reader.ReadInt32();
+	rule.attributes.reserve(Binary::BoundedCapacity(attributeCount, mRules.size() - reader.GetPosition(), 6));
+	for (uint32_t i = 0; i < attributeCount; ++i)
+	{
+		Attribute attribute;
+		attribute.nameID = reader.ReadInt32();
+		uint16_t length = reader.ReadInt16();
+		size_t position = reader.GetPosition();
+		reader.Skip(length);
+		attribute.value = std::string_view(reinterpret_cast<const char*>(mRules.data() + position), length);
+		rule.attributes.push_back(attribute);
+	}
+
+	rule.childCount = reader.ReadInt32();
+	rule.childrenStart = reader.GetPosition();
+	for (uint32_t i = 0; i < rule.childCount; ++i)
+		SkipRule(reader, depth + 1);
+	rule.end = reader.GetPosition();
+}
+
+void GRFFile::SkipRule(BinaryReader& reader, int depth)
+{
+	if (depth > MAX_RULE_DEPTH)
+		throw std::runtime_error("GRF rules are nested too deep");
+
+	reader.Skip(4); // name
+	uint32_t attributeCount = reader.ReadInt32();
+	for (uint32_t i = 0; i < attributeCount; ++i)
+	{
+		reader.Skip(4); // name
+		reader.Skip(reader.ReadInt16());
+	}
+
+	uint32_t childCount = reader.ReadInt32();
+	for (uint32_t i = 0; i < childCount; ++i)
+		SkipRule(reader, depth + 1);
+}
+
+void GRFFile::WriteRule(BinaryWriter& writer, const Rule& rule) const
+{
+	if (!rule.modified)
+	{
+		writer.WriteData(mRules.data() + rule.start, rule.end - rule.start);
+		return;
+	}
+
+	writer.WriteInt32(rule.nameID);
+	writer.WriteInt32(static_cast<uint32_t>(rule.attributes.size()));
+	for (const auto& attribute : rule.attributes)
+	{
+		writer.WriteInt32(attribute.nameID);
+		writer.WriteInt16(static_cast<uint16_t>(attribute.value.size()));
+		writer.WriteData(attribute.value.data(), attribute.value.size());
+	}
+
+	writer.WriteInt32(rule.childCount);
+	if (rule.expanded)
+	{
+		for (const auto& child : rule.children)
+			WriteRule(writer, child);
+	}
+	else
+		writer.WriteData(mRules.data() + rule.childrenStart, rule.end - rule.childrenStart);
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class BinaryReader;
+class BinaryWriter;
+
+// GRF File research done by NessieHax/Miku666/nullptr, PhoenixARC, and many others over the years.
+
+// Game rules of world templates and mini games (.grf, and .grh which is never compressed); a tree of named rules with string attributes
+class GRFFile
+{
+public:
+	// How the rules are stored; compressed ones use the platform's compressor, which is zlib everywhere but the Xbox 360
+	enum class Compression : uint8_t
+	{
+		NONE,
+		RLE,
+		COMPRESSED_RLE,
+		COMPRESSED_RLE_CRC
+	};
+
+	struct Attribute
+	{
+		uint32_t nameID{ 0 };
+		std::string_view value{};
+		int edit{ -1 }; // index into the changed values once changed
+	};
+
+	// A rule and its attributes; the children are only read once the rule is expanded
+	struct Rule
+	{
+		uint32_t nameID{ 0 };
+		std::vector<Attribute> attributes{};
+		uint32_t childCount{ 0 };
+		size_t start{ 0 }; // where the rule starts in the rules data
+		size_t childrenStart{ 0 };
+		size_t end{ 0 };
+		bool expanded{ false };
+		bool modified{ false }; // the rule or anything under it changed
+		Rule* parent{ nullptr };
+		std::vector<Rule> children{};
+	};
+
+	GRFFile() = default;
+
+	// rules point at their parents, so the file can't be moved around
+	GRFFile(const GRFFile&) = delete;
+	GRFFile& operator=(const GRFFile&) = delete;
+
+	// Reads a GRF File from memory, decompressing the rules as they're read; only the top level rules are read until more are expanded
+	void Read(const unsigned char* data, size_t size);
+
+	// Writes the GRF File to the end of a buffer; rules that didn't change are copied through as they were, and the rules are compressed on a thread pool. 0 threads uses one per hardware thread.
+	// The CRC is recomputed for what's written; throws if it can't be, see canWrite
+	void Write(std::vector<unsigned char>& out, unsigned int threadCount = 0) const;
+
+	// Gets the GRF version
+	uint16_t getVersion() const;
+
+	// Gets how the rules are stored
+	Compression getCompression() const;
+
+	// Gets the size of the rules once decompressed
+	size_t getRulesSize() const;
+
+	// Gets how many strings are in the string table
+	size_t getStringCount() const;
+
+	// Gets a string from the string table, like the name of a rule or attribute; empty if there's no such string
+	std::string_view getString(uint32_t id) const;
+
+	// Gets the rule every top level rule is a child of; it has no name or attributes of its own
+	Rule& getRoot();
+
+	// Reads the children of a rule, if they weren't already
+	void expandRule(Rule& rule);
+
+	// Changes the value of one of a rule's attributes
+	void setAttribute(Rule& rule, size_t index, std::string value);
+
+	// Checks if anything was changed since the GRF File was read
+	bool isModified() const;
+
+	// Checks if the GRF File can be written back; not if it has a CRC that doesn't match anything it could be recomputed from
+	bool canWrite() const;
+
+private:
+	// What the CRC in the header was found to be taken over
+	enum class CRCSource : uint8_t
+	{
+		NONE, // no CRC, or one that didn't match anything
+		RULES, // the decompressed rules
+		PAYLOAD // the rules as stored, after the sizes
+	};
+
+	// Reads a rule and its attributes, skipping over its children
+	void ReadRule(BinaryReader& reader, Rule& rule, int depth);
+
+	// Skips over a rule and everything under it
+	void SkipRule(BinaryReader& reader, int depth);
+
+	// Writes a rule; copied straight from the rules data if nothing in it changed
+	void WriteRule(BinaryWriter& writer, const Rule& rule) const;
+
+	std::vector<unsigned char> mHeader{}; // written back as it was
+	uint16_t mVersion{ 0 };
+	Compression mCompression{ Compression::NONE };
+	CRCSource mCRCSource{ CRCSource::NONE };
+	std::vector<unsigned char> mRules{}; // decompressed
+	std::vector<std::string_view> mStrings{};
+	Rule mRoot{};
+	std::deque<std::string> mEdits{}; // changed values; a deque so the views into it stay valid as it grows
+};
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <cstdio>
+#include "Binary/BinaryReader.h"
+#include "Binary/BinaryWriter.h"
+#include "Formats/LOCFile.h"
+#include "Util/Log.h"
+#include "Util/Trace.h"
+
+void LOCFile::Read(const unsigned char* data, size_t size)
+{
+	TRACE_SCOPE("LOCFile::Read");
+
+	mData = data;
+	mSize = size;
+	mKeys.clear();
+	mKeyIndex.clear();
+	mKeyNames.clear();
+	mLanguages.clear();
+	mEdits.clear();
+
+	BinaryReader reader(data, size);
+
+	uint32_t version;
+	reader.ReadData(&version, 4);
+
+	if (!Binary::DetectVersionEndianness(version, 1, 2, mVersion, mEndianness))
+		throw std::runtime_error("Invalid LOC version");
+
+	reader.SetEndianness(mEndianness);
+
+	uint32_t languageCount = reader.ReadInt32();
+
+	if (mVersion == 2)
+	{
+		bool useUniqueIDs = reader.ReadInt8() != 0;
+		uint32_t keyCount = reader.ReadInt32();
+
+		mKeys.reserve(Binary::BoundedCapacity(keyCount, size - reader.GetPosition(), 2));
+
+		if (useUniqueIDs)
+		{
+			// formatted all at once, so growing the vector can't move strings out from under the views
+			mKeyNames.reserve(Binary::BoundedCapacity(keyCount, size - reader.GetPosition(), 4));
+			for (uint32_t i = 0; i < keyCount; ++i)
+			{
+				char name[9];
+				std::snprintf(name, sizeof(name), "%08X", reader.ReadInt32());
+				mKeyNames.emplace_back(name);
+			}
+			for (const auto& name : mKeyNames)
+				mKeys.push_back(name);
+		}
+		else
+		{
+			for (uint32_t i = 0; i < keyCount; ++i)
+				mKeys.push_back(ReadString(reader));
+		}
+
+		// strings go by position in version 2, so duplicate keys keep their rows and lookups find the first
+		mKeyIndex.reserve(mKeys.size());
+		for (size_t i = 0; i < mKeys.size(); ++i)
+			mKeyIndex.emplace(mKeys[i], i);
+	}
+
+	mLanguages.resize(languageCount);
+
+	for (auto& language : mLanguages)
+	{
+		language.name = ReadString(reader);
+		language.sizeOffset = reader.GetPosition();
+		language.size = reader.ReadInt32();
+	}
+
+	for (auto& language : mLanguages)
+	{
+		if (reader.ReadInt32() > 0)
+			reader.ReadInt8(); // unknown
+
+		ReadString(reader); // same name as in the header
+		uint32_t stringCount = reader.ReadInt32();
+
+		if (mVersion == 2 && stringCount > mKeys.size())
+			throw std::runtime_error("More LOC strings than keys in " + std::string(language.name));
+
+		language.strings.reserve(Binary::BoundedCapacity(stringCount, size - reader.GetPosition(), 2));
+		language.index.assign(mKeys.size(), -1);
+
+		for (uint32_t i = 0; i < stringCount; ++i)
+		{
+			size_t row = mVersion == 2 ? i : AddKey(ReadString(reader));
+
+			String string;
+			string.text = ReadString(reader, &string.offset);
+			string.length = static_cast<uint16_t>(string.text.size());
+
+			// version 1 keys can show up in any language, so the index grows with them
+			if (row >= language.index.size())
+				language.index.resize(mKeys.size(), -1);
+
+			language.index[row] = static_cast<int>(language.strings.size());
+			language.strings.push_back(string);
+		}
+
+		LOG_DEBUG("LOC Language: %.*s, %u strings", (int)language.name.size(), language.name.data(), stringCount);
+	}
+
+	// keys added by later languages aren't in the earlier ones' indexes yet
+	for (auto& language : mLanguages)
+		language.index.resize(mKeys.size(), -1);
+}
+
+void LOCFile::Write(std::vector<unsigned char>& out) const
+{
+	TRACE_SCOPE("LOCFile::Write");
+
+	// the only things that change are the changed strings and the sizes of the languages they're in
+	struct Patch
+	{
+		size_t offset;
+		size_t length; // bytes replaced in the data
+		const String* string; // null for a language size
+		uint32_t size;
+	};
+
+	std::vector<Patch> patches;
+
+	for (const auto& language : mLanguages)
+	{
+		int64_t sizeChange = 0;
+
+		for (const auto& string : language.strings)
+		{
+			if (string.edit < 0)
+				continue;
+
+			patches.push_back({ string.offset, 2u + string.length, &string, 0 });
+			sizeChange += (int64_t)string.text.size() - string.length;
+		}
+
+		if (sizeChange != 0)
+			patches.push_back({ language.sizeOffset, 4, nullptr, static_cast<uint32_t>(language.size + sizeChange) });
+	}
+
+	std::sort(patches.begin(), patches.end(), [](const Patch& a, const Patch& b) { return a.offset < b.offset; });
+
+	out.reserve(out.size() + mSize);
+
+	BinaryWriter writer(out);
+	writer.SetEndianness(mEndianness);
+
+	size_t position = 0;
+	for (const auto& patch : patches)
+	{
+		writer.WriteData(mData + position, patch.offset - position);
+
+		if (patch.string)
+		{
+			writer.WriteInt16(static_cast<uint16_t>(patch.string->text.size()));
+			writer.WriteData(patch.string->text.data(), patch.string->text.size());
+		}
+		else
+			writer.WriteInt32(patch.size);
+
+		position = patch.offset + patch.length;
+	}
+	writer.WriteData(mData + position, mSize - position);
+}
+
+uint32_t LOCFile::getVersion() const
+{
+	return mVersion;
+}
+
+Binary::Endianness LOCFile::getEndianness() const
+{
+	return mEndianness;
+}
+
+size_t LOCFile::getKeyCount() const
+{
+	return mKeys.size();
+}
+
+std::string_view LOCFile::getKey(size_t index) const
+{
+	return index < mKeys.size() ? mKeys[index] : std::string_view();
+}
+
+int LOCFile::findKey(std::string_view key) const
+{
+	auto it = mKeyIndex.find(key);
+	return it != mKeyIndex.end() ? static_cast<int>(it->second) : -1;
+}
+
+size_t LOCFile::getLanguageCount() const
+{
+	return mLanguages.size();
+}
+
+std::string_view LOCFile::getLanguage(size_t language) const
+{
+	return language < mLanguages.size() ? mLanguages[language].name : std::string_view();
+}
+
+int LOCFile::findLanguage(std::string_view name) const
+{
+	for (size_t i = 0; i < mLanguages.size(); ++i)
+	{
+		if (mLanguages[i].name == name)
+			return static_cast<int>(i);
+	}
+	return -1;
+}
+
+bool LOCFile::hasString(size_t language, size_t key) const
+{
+	return language < mLanguages.size() && key < mLanguages[language].index.size() && mLanguages[language].index[key] >= 0;
+}
+
+std::string_view LOCFile::getString(size_t language, size_t key) const
+{
+	if (!hasString(language, key))
+		return {};
+
+	const Language& lang = mLanguages[language];
+	return lang.strings[lang.index[key]].text;
+}
+
+void LOCFile::setString(size_t language, size_t key, std::string value)
+{
+	if (!hasString(language, key))
+		throw std::runtime_error("No LOC string to change");
+
+	if (value.size() > 0xFFFF)
+		throw std::runtime_error("LOC strings can't be longer than 65535 bytes");
+
+	Language& lang = mLanguages[language];
+	String& string = lang.strings[lang.index[key]];
+
+	if (string.edit < 0)
+	{
+		string.edit = static_cast<int>(mEdits.size());
+		mEdits.push_back(std::move(value));
+	}
+	else
+		mEdits[string.edit] = std::move(value);
+
+	string.text = mEdits[string.edit];
+}
+
+bool LOCFile::isModified() const
+{
+	return !mEdits.empty();
+}
+
+std::string_view LOCFile::ReadString(BinaryReader& reader, size_t* offset)
+{
+	if (offset)
+		*offset = reader.GetPosition();
+
+	uint16_t length = reader.ReadInt16();
+	size_t position = reader.GetPosition();
+	reader.Skip(length);
+
+	return std::string_view(reinterpret_cast<const char*>(mData + position), length);
+}
+
+size_t LOCFile::AddKey(std::string_view key)
+{
+	auto [it, inserted] = mKeyIndex.emplace(key, mKeys.size());
+	if (inserted)
+		mKeys.push_back(key);
+	return it->second;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Binary/Binary.h"
+
+class BinaryReader;
+
+// LOC File research done by NessieHax/Miku666/nullptr, PhoenixARC, and many others over the years.
+
+// Localisation tables (languages.loc); every language has a string for each key
+class LOCFile
+{
+public:
+	// Reads a LOC File from memory. Strings are views into the data instead of copies, so the data has to outlive the LOC File, or at least until it's read again
+	void Read(const unsigned char* data, size_t size);
+
+	// Writes the LOC File to the end of a buffer; everything but the changed strings and their language sizes is copied straight from the data it was read from
+	void Write(std::vector<unsigned char>& out) const;
+
+	// Gets the LOC version; 2 has one key table shared by every language, 1 has keys for every string
+	uint32_t getVersion() const;
+
+	// Gets the LOC File Endianness
+	Binary::Endianness getEndianness() const;
+
+	// Gets how many keys there are, across every language
+	size_t getKeyCount() const;
+
+	// Gets a key by index; unique IDs are shown as 8 hex digits
+	std::string_view getKey(size_t index) const;
+
+	// Finds the index of a key; -1 if there's no such key
+	int findKey(std::string_view key) const;
+
+	// Gets how many languages there are
+	size_t getLanguageCount() const;
+
+	// Gets a language's name, like "en-EN"
+	std::string_view getLanguage(size_t language) const;
+
+	// Finds the index of a language by name; -1 if there's no such language
+	int findLanguage(std::string_view name) const;
+
+	// Checks if a language has a string for a key; LOC version 1 languages don't need to have every key
+	bool hasString(size_t language, size_t key) const;
+
+	// Gets a language's string for a key; empty if it has none
+	std::string_view getString(size_t language, size_t key) const;
+
+	// Changes a language's string for a key; only strings the language already has can be changed
+	void setString(size_t language, size_t key, std::string value);
+
+	// Checks if any string was changed since the LOC File was read
+	bool isModified() const;
+
+private:
+	struct String
+	{
+		std::string_view text{};
+		size_t offset{ 0 }; // where the string's length is in the data
+		uint16_t length{ 0 }; // length in the data, since the text may be changed
+		int edit{ -1 }; // index into mEdits once changed
+	};
+
+	struct Language
+	{
+		std::string_view name{};
+		size_t sizeOffset{ 0 }; // where the language's size is in the data
+		uint32_t size{ 0 };
+		std::vector<String> strings{};
+		std::vector<int> index{}; // string index of every key; -1 where the language has none
+	};
+
+	// Reads a string's length and points a view at its bytes, without copying them
+	std::string_view ReadString(BinaryReader& reader, size_t* offset = nullptr);
+
+	// Gets the row of a key, adding it if it's new
+	size_t AddKey(std::string_view key);
+
+	const unsigned char* mData{ nullptr };
+	size_t mSize{ 0 };
+	uint32_t mVersion{ 2 };
+	Binary::Endianness mEndianness{ Binary::Endianness::BIG };
+	std::vector<std::string_view> mKeys{};
+	std::unordered_map<std::string_view, size_t> mKeyIndex{};
+	std::vector<std::string> mKeyNames{}; // unique IDs formatted for display, since they aren't strings in the data
+	std::vector<Language> mLanguages{};
+	std::deque<std::string> mEdits{}; // changed strings; a deque so the views into it stay valid as it grows
+};
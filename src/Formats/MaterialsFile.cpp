@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <stdexcept>
+#include "Binary/BinaryReader.h"
+#include "Binary/BinaryWriter.h"
+#include "Formats/MaterialsFile.h"
+#include "Util/Log.h"
+
+void MaterialsFile::Read(const unsigned char* data, size_t size)
+{
+	mMaterials.clear();
+
+	BinaryReader reader(data, size);
+
+	uint32_t version;
+	reader.ReadData(&version, 4);
+
+	if (!Binary::DetectVersionEndianness(version, 0, 0xFF, mVersion, mEndianness))
+		throw std::runtime_error("Invalid entityMaterials.bin version");
+
+	reader.SetEndianness(mEndianness);
+
+	// every material is at least 4 bytes
+	uint32_t count = reader.ReadInt32();
+	mMaterials.reserve(Binary::BoundedCapacity(count, size - reader.GetPosition(), 4));
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		Material& material = mMaterials.emplace_back();
+		material.name = ReadString(reader);
+		material.type = ReadString(reader);
+	}
+
+	if (reader.GetPosition() != size)
+		throw std::runtime_error("entityMaterials.bin has " + std::to_string(size - reader.GetPosition()) + " bytes after its materials");
+
+	LOG_DEBUG("entityMaterials.bin version %u, %zu materials", mVersion, mMaterials.size());
+}
+
+void MaterialsFile::Write(std::vector<unsigned char>& out) const
+{
+	BinaryWriter writer(out);
+	writer.SetEndianness(mEndianness);
+
+	writer.WriteInt32(mVersion);
+	writer.WriteInt32(static_cast<uint32_t>(mMaterials.size()));
+
+	for (const auto& material : mMaterials)
+	{
+		WriteString(writer, material.name);
+		WriteString(writer, material.type);
+	}
+}
+
+uint32_t MaterialsFile::getVersion() const
+{
+	return mVersion;
+}
+
+Binary::Endianness MaterialsFile::getEndianness() const
+{
+	return mEndianness;
+}
+
+const std::vector<MaterialsFile::Material>& MaterialsFile::getMaterials() const
+{
+	return mMaterials;
+}
+
+std::vector<MaterialsFile::Material>& MaterialsFile::getMaterials()
+{
+	return mMaterials;
+}
+
+const std::vector<std::string>& MaterialsFile::getKnownTypes()
+{
+	static const std::vector<std::string> types{
+		"entity", "entity_alphatest", "entity_alphablend", "entity_emissive", "entity_emissive_alpha",
+		"entity_change_color", "entity_glint", "entity_nocull", "entity_dissolve_layer0", "entity_dissolve_layer1"
+	};
+	return types;
+}
+
+std::string MaterialsFile::ReadString(BinaryReader& reader)
+{
+	std::string value(reader.ReadInt16(), '\0');
+	reader.ReadData(value.data(), value.size());
+	return value;
+}
+
+void MaterialsFile::WriteString(BinaryWriter& writer, const std::string& value)
+{
+	if (value.size() > 0xFFFF)
+		throw std::runtime_error("entityMaterials.bin strings can't be longer than 65535 bytes");
+
+	writer.WriteInt16(static_cast<uint16_t>(value.size()));
+	writer.WriteData(value.data(), value.size());
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Binary/Binary.h"
+
+class BinaryReader;
+class BinaryWriter;
+
+// Materials File research done by NessieHax/Miku666/nullptr, PhoenixARC, and many others over the years.
+
+// Entity render materials of texture packs (entityMaterials.bin); which material, like "entity_alphatest", every entity is drawn with
+class MaterialsFile
+{
+public:
+	struct Material
+	{
+		std::string name{}; // the entity, like "creeper"
+		std::string type{};
+	};
+
+	// Reads a Materials File from memory
+	void Read(const unsigned char* data, size_t size);
+
+	// Writes the Materials File to the end of a buffer, in the version and endianness it was read in
+	void Write(std::vector<unsigned char>& out) const;
+
+	// Gets the Materials File version
+	uint32_t getVersion() const;
+
+	// Gets the Materials File Endianness
+	Binary::Endianness getEndianness() const;
+
+	// Gets every material, in file order
+	const std::vector<Material>& getMaterials() const;
+
+	// Gets every material to change; names and types have to stay under 65536 bytes to be written
+	std::vector<Material>& getMaterials();
+
+	// Gets the material types the game is known to have
+	static const std::vector<std::string>& getKnownTypes();
+
+private:
+	// Reads a string's length and then its UTF-8 bytes
+	static std::string ReadString(BinaryReader& reader);
+
+	// Writes a string's length and then its UTF-8 bytes; throws if it's too long to have its length written
+	static void WriteString(BinaryWriter& writer, const std::string& value);
+
+	uint32_t mVersion{ 0 };
+	Binary::Endianness mEndianness{ Binary::Endianness::BIG };
+	std::vector<Material> mMaterials{};
+};
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "Binary/BinaryReader.h"
+#include "Formats/ModelsFile.h"
+#include "Util/Log.h"
+#include "Util/Trace.h"
+
+namespace
+{
+	constexpr float DEGREES_TO_RADIANS = 3.14159265358979f / 180.0f;
+
+	// Rotates a point around the origin by X, then Y, then Z; the game does it as Z, Y, X matrix rotations, which hit the point in reverse
+	void Rotate(float& x, float& y, float& z, float rotationX, float rotationY, float rotationZ)
+	{
+		if (rotationX != 0.0f)
+		{
+			float c = std::cos(rotationX), s = std::sin(rotationX);
+			float ry = y * c - z * s;
+			z = y * s + z * c;
+			y = ry;
+		}
+		if (rotationY != 0.0f)
+		{
+			float c = std::cos(rotationY), s = std::sin(rotationY);
+			float rx = x * c + z * s;
+			z = -x * s + z * c;
+			x = rx;
+		}
+		if (rotationZ != 0.0f)
+		{
+			float c = std::cos(rotationZ), s = std::sin(rotationZ);
+			float rx = x * c - y * s;
+			y = x * s + y * c;
+			x = rx;
+		}
+	}
+}
+
+void ModelsFile::Read(const unsigned char* data, size_t size)
+{
+	TRACE_SCOPE("ModelsFile::Read");
+
+	mModels.clear();
+	mParts.clear();
+	mBoxes.clear();
+
+	BinaryReader reader(data, size);
+
+	uint32_t version;
+	reader.ReadData(&version, 4);
+
+	if (!Binary::DetectVersionEndianness(version, 0, 2, mVersion, mEndianness))
+		throw std::runtime_error("Invalid models.bin version");
+
+	reader.SetEndianness(mEndianness);
+
+	uint32_t modelCount = reader.ReadInt32();
+	mModels.reserve(Binary::BoundedCapacity(modelCount, size - reader.GetPosition(), 14));
+
+	for (uint32_t i = 0; i < modelCount; ++i)
+	{
+		Model& model = mModels.emplace_back();
+		model.name = ReadString(reader);
+		model.textureWidth = static_cast<int>(reader.ReadInt32());
+		model.textureHeight = static_cast<int>(reader.ReadInt32());
+		model.partCount = reader.ReadInt32();
+		model.firstPart = static_cast<uint32_t>(mParts.size());
+
+		if (model.textureWidth <= 0 || model.textureHeight <= 0)
+			throw std::runtime_error("Invalid texture size for model " + model.name);
+
+		for (uint32_t j = 0; j < model.partCount; ++j)
+		{
+			Part& part = mParts.emplace_back();
+			part.name = ReadString(reader);
+			if (mVersion > 1)
+				part.parent = ReadString(reader);
+
+			part.pivotX = reader.ReadFloat();
+			part.pivotY = reader.ReadFloat();
+			part.pivotZ = reader.ReadFloat();
+			part.rotationX = reader.ReadFloat();
+			part.rotationY = reader.ReadFloat();
+			part.rotationZ = reader.ReadFloat();
+
+			// the extra rotation is applied on top of the first, so they're just added together
+			if (mVersion > 0)
+			{
+				part.rotationX += reader.ReadFloat();
+				part.rotationY += reader.ReadFloat();
+				part.rotationZ += reader.ReadFloat();
+			}
+
+			part.boxCount = reader.ReadInt32();
+			part.firstBox = static_cast<uint32_t>(mBoxes.size());
+
+			for (uint32_t k = 0; k < part.boxCount; ++k)
+			{
+				Box& box = mBoxes.emplace_back();
+				box.x = reader.ReadFloat();
+				box.y = reader.ReadFloat();
+				box.z = reader.ReadFloat();
+				box.width = static_cast<float>(static_cast<int32_t>(reader.ReadInt32()));
+				box.height = static_cast<float>(static_cast<int32_t>(reader.ReadInt32()));
+				box.depth = static_cast<float>(static_cast<int32_t>(reader.ReadInt32()));
+				box.u = reader.ReadFloat();
+				box.v = reader.ReadFloat();
+				box.inflate = reader.ReadFloat();
+				box.mirrored = reader.ReadInt8() != 0;
+			}
+		}
+	}
+
+	LOG_DEBUG("models.bin version %u, %zu models, %zu parts, %zu boxes", mVersion, mModels.size(), mParts.size(), mBoxes.size());
+}
+
+uint32_t ModelsFile::getVersion() const
+{
+	return mVersion;
+}
+
+Binary::Endianness ModelsFile::getEndianness() const
+{
+	return mEndianness;
+}
+
+const std::vector<ModelsFile::Model>& ModelsFile::getModels() const
+{
+	return mModels;
+}
+
+const std::vector<ModelsFile::Part>& ModelsFile::getParts() const
+{
+	return mParts;
+}
+
+const std::vector<ModelsFile::Box>& ModelsFile::getBoxes() const
+{
+	return mBoxes;
+}
+
+int ModelsFile::findModel(std::string_view name) const
+{
+	for (size_t i = 0; i < mModels.size(); ++i)
+		if (mModels[i].name == name)
+			return static_cast<int>(i);
+	return -1;
+}
+
+void ModelsFile::AppendVertices(const Model& model, std::vector<SkinVertex>& out) const
+{
+	out.reserve(out.size() + getVertexCount(model));
+
+	for (uint32_t i = model.firstPart; i < model.firstPart + model.partCount; ++i)
+	{
+		const Part& part = mParts[i];
+		size_t partStart = out.size();
+
+		// boxes are built around the pivot, then moved out to it once rotated
+		for (uint32_t j = part.firstBox; j < part.firstBox + part.boxCount; ++j)
+		{
+			const Box& box = mBoxes[j];
+			SkinBox skinBox("", box.x, box.y, box.z, box.width, box.height, box.depth, box.u, box.v, 0, box.mirrored, box.inflate);
+			skinBox.calculateUVs(model.textureWidth, model.textureHeight);
+			skinBox.AppendVertices(out);
+		}
+
+		// the vertices have Y flipped to point up, which flips the direction of rotations around X and Z too
+		float rotationX = -part.rotationX * DEGREES_TO_RADIANS;
+		float rotationY = part.rotationY * DEGREES_TO_RADIANS;
+		float rotationZ = -part.rotationZ * DEGREES_TO_RADIANS;
+
+		for (size_t v = partStart; v < out.size(); ++v)
+		{
+			SkinVertex& vertex = out[v];
+			Rotate(vertex.x, vertex.y, vertex.z, rotationX, rotationY, rotationZ);
+			vertex.x += part.pivotX;
+			vertex.y -= part.pivotY;
+			vertex.z += part.pivotZ;
+		}
+	}
+}
+
+size_t ModelsFile::getVertexCount(const Model& model) const
+{
+	size_t boxCount = 0;
+	for (uint32_t i = model.firstPart; i < model.firstPart + model.partCount; ++i)
+		boxCount += mParts[i].boxCount;
+	return boxCount * 24;
+}
+
+std::string ModelsFile::ReadString(BinaryReader& reader)
+{
+	std::string value(reader.ReadInt16(), '\0');
+	reader.ReadData(value.data(), value.size());
+	return value;
+}
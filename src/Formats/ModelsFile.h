@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Binary/Binary.h"
+#include "Skin/SkinBox.h"
+
+class BinaryReader;
+
+// Models File research done by NessieHax/Miku666/nullptr, PhoenixARC, and many others over the years.
+
+// Custom entity models of texture packs (models.bin); every model is parts with pivots and rotations, and every part is boxes like the ones skins use
+class ModelsFile
+{
+public:
+	struct Box
+	{
+		float x{}, y{}, z{};
+		float width{}, height{}, depth{};
+		float u{}, v{};
+		float inflate{ 0.0f };
+		bool mirrored{ false };
+	};
+
+	struct Part
+	{
+		std::string name{};
+		std::string parent{}; // empty for parts that aren't attached to another, and for everything before version 2
+		float pivotX{}, pivotY{}, pivotZ{};
+		float rotationX{}, rotationY{}, rotationZ{}; // degrees
+		uint32_t firstBox{ 0 }; // into the boxes of the whole file
+		uint32_t boxCount{ 0 };
+	};
+
+	struct Model
+	{
+		std::string name{};
+		int textureWidth{ 64 };
+		int textureHeight{ 32 };
+		uint32_t firstPart{ 0 }; // into the parts of the whole file
+		uint32_t partCount{ 0 };
+	};
+
+	// Reads a Models File from memory
+	void Read(const unsigned char* data, size_t size);
+
+	// Gets the models.bin version; 1 added a second rotation to parts, 2 added part parents
+	uint32_t getVersion() const;
+
+	// Gets the Models File Endianness
+	Binary::Endianness getEndianness() const;
+
+	// Gets every model, in file order
+	const std::vector<Model>& getModels() const;
+
+	// Gets the parts of every model, one model's after another
+	const std::vector<Part>& getParts() const;
+
+	// Gets the boxes of every part, one part's after another
+	const std::vector<Box>& getBoxes() const;
+
+	// Finds the index of a model by name, like "pig"; -1 if there's no such model
+	int findModel(std::string_view name) const;
+
+	// Appends every box of a model to a vertex buffer, moved and rotated around its part's pivot
+	void AppendVertices(const Model& model, std::vector<SkinVertex>& out) const;
+
+	// Counts the vertices AppendVertices would append for a model
+	size_t getVertexCount(const Model& model) const;
+
+private:
+	// Reads a string's length and then its UTF-8 bytes
+	static std::string ReadString(BinaryReader& reader);
+
+	uint32_t mVersion{ 0 };
+	Binary::Endianness mEndianness{ Binary::Endianness::BIG };
+	std::vector<Model> mModels{};
+	std::vector<Part> mParts{};
+	std::vector<Box> mBoxes{};
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include "Backends/RendererBackend.h"
 
@@ -10,6 +11,14 @@ struct Texture
     int height{0};
 };
 
+// Part of a texture in UV space, like one icon of an atlas
+struct TextureRegion
+{
+    unsigned int id{0};
+    float u0{0.0f}, v0{0.0f};
+    float u1{1.0f}, v1{1.0f};
+};
+
 enum class TextureFilter
 {
     NEAREST,
@@ -42,9 +51,18 @@ public:
     // Loads texture from memory/data
     virtual Texture LoadTextureFromMemory(const void* data, size_t size, TextureFilter filter) = 0;
 
+    // Loads texture from raw RGBA pixels
+    virtual Texture LoadTextureFromPixels(const void* pixels, int width, int height, TextureFilter filter) = 0;
+
     // Loads texture from file
     virtual Texture LoadTextureFromFile(const std::string& path, TextureFilter filter) = 0;
 
     // Deletes texture
     virtual void DeleteTexture(const Texture& texture) = 0;
+
+    // Gets a texture decoded from memory, only decoding it again once the revision changes; key is whatever the image belongs to, like its asset
+    virtual const Texture& GetCachedTexture(const void* key, uint32_t revision, const void* data, size_t size, TextureFilter filter) = 0;
+
+    // Deletes every cached texture
+    virtual void ClearTextureCache() = 0;
 };
\ No newline at end of file
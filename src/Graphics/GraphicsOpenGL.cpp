@@ -1,10 +1,10 @@
-#include <iostream>
 #include <fstream>
 #include <vector>
 #include "Graphics/GraphicsOpenGL.h"
+#include "Util/Log.h"
+#include "Util/Trace.h"
 
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
+#include <stb_image.h> // implemented in Util/Image.cpp
 
 GraphicsOpenGL::GraphicsOpenGL() = default;
 
@@ -14,7 +14,7 @@ GraphicsOpenGL::~GraphicsOpenGL() {
 
 bool GraphicsOpenGL::Init() {
     if (!gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress)) {
-        std::cerr << "Failed to initialize GLAD\n";
+        LOG_ERROR("Failed to initialize GLAD");
         return false;
     }
 
@@ -39,12 +39,26 @@ void GraphicsOpenGL::Present() {
 
 Texture GraphicsOpenGL::LoadTextureFromMemory(const void* data, size_t size, TextureFilter filter) {
     int width, height, channels;
-    stbi_uc* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(data), static_cast<int>(size), &width, &height, &channels, 4);
+    stbi_uc* pixels;
+    {
+        TRACE_SCOPE("Texture decode");
+        pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(data), static_cast<int>(size), &width, &height, &channels, 4);
+    }
     if (!pixels) {
-        std::cerr << "Failed to load texture from memory\n";
+        LOG_ERROR("Failed to load texture from memory");
         return {};
     }
 
+    Texture texture = LoadTextureFromPixels(pixels, width, height, filter);
+
+    stbi_image_free(pixels);
+
+    return texture;
+}
+
+Texture GraphicsOpenGL::LoadTextureFromPixels(const void* pixels, int width, int height, TextureFilter filter) {
+    TRACE_SCOPE("Texture upload");
+
     GLuint texID;
     glGenTextures(1, &texID);
     glBindTexture(GL_TEXTURE_2D, texID);
@@ -68,15 +82,13 @@ Texture GraphicsOpenGL::LoadTextureFromMemory(const void* data, size_t size, Tex
 
     glBindTexture(GL_TEXTURE_2D, texID);
 
-    stbi_image_free(pixels);
-
     return { texID, width, height };
 }
 
 Texture GraphicsOpenGL::LoadTextureFromFile(const std::string& path, TextureFilter filter) {
     std::ifstream file(path, std::ios::binary | std::ios::ate);
     if (!file) {
-        printf("Failed to open image file: %s\n", path.c_str());
+        LOG_ERROR("Failed to open image file: %s", path.c_str());
         return {};
     }
 
@@ -85,11 +97,11 @@ Texture GraphicsOpenGL::LoadTextureFromFile(const std::string& path, TextureFilt
 
     std::vector<char> buffer(size);
     if (!file.read(buffer.data(), size)) {
-        printf("Failed to read image file: %s\n", path.c_str());
+        LOG_ERROR("Failed to read image file: %s", path.c_str());
         return {};
     }
 
-    printf("Loaded image file: %s\n", path.c_str());
+    LOG_DEBUG("Loaded image file: %s", path.c_str());
 
     return LoadTextureFromMemory(buffer.data(), size, filter);
 }
@@ -116,4 +128,31 @@ GLint GraphicsOpenGL::GetGLFilter(TextureFilter filter) const {
 void GraphicsOpenGL::DeleteTexture(const Texture& texture)
 {
     glDeleteTextures(1, &texture.id);
-}
\ No newline at end of file
+}
+const Texture& GraphicsOpenGL::GetCachedTexture(const void* key, uint32_t revision, const void* data, size_t size, TextureFilter filter)
+{
+    auto [it, inserted] = mTextureCache.try_emplace(key);
+    CachedTexture& cached = it->second;
+
+    if (inserted || cached.revision != revision)
+    {
+        if (cached.texture.id != 0)
+            DeleteTexture(cached.texture);
+
+        cached.revision = revision;
+        cached.texture = LoadTextureFromMemory(data, size, filter);
+    }
+
+    return cached.texture;
+}
+
+void GraphicsOpenGL::ClearTextureCache()
+{
+    for (const auto& [key, cached] : mTextureCache)
+    {
+        if (cached.texture.id != 0)
+            DeleteTexture(cached.texture);
+    }
+
+    mTextureCache.clear();
+}
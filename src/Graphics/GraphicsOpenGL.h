@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_map>
 #include <SDL3/SDL.h>
 #include <glad/glad.h>
 #include "Graphics/GraphicsBase.h"
@@ -27,14 +28,30 @@ public:
     // Loads textures from memory/data
     Texture LoadTextureFromMemory(const void* data, size_t size, TextureFilter filter = TextureFilter::NEAREST) override;
 
+    // Loads textures from raw RGBA pixels, uploaded as is
+    Texture LoadTextureFromPixels(const void* pixels, int width, int height, TextureFilter filter = TextureFilter::NEAREST) override;
+
     // Loads textures from file, like TGA, PNG
     Texture LoadTextureFromFile(const std::string& path, TextureFilter filter = TextureFilter::NEAREST) override;
 
     void DeleteTexture(const Texture& texture) override;
 
+    // Gets a texture decoded from memory, only decoding it again once the revision changes; shared by every preview, so no image is uploaded twice
+    const Texture& GetCachedTexture(const void* key, uint32_t revision, const void* data, size_t size, TextureFilter filter = TextureFilter::NEAREST) override;
+
+    // Deletes every cached texture, like when the PCK File they came from is closed
+    void ClearTextureCache() override;
+
     // convert filter to GL Filter
     GLint GetGLFilter(TextureFilter filter) const;
 
 private:
+    struct CachedTexture
+    {
+        uint32_t revision{};
+        Texture texture{}; // empty if the image couldn't be decoded, so it isn't tried again every frame
+    };
+
     bool mShouldClose = false;
+    std::unordered_map<const void*, CachedTexture> mTextureCache{};
 };
\ No newline at end of file
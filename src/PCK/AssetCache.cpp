@@ -0,0 +1,153 @@
+#include <stdexcept>
+#include "Formats/BehavioursFile.h"
+#include "Formats/COLFile.h"
+#include "Formats/GRFFile.h"
+#include "Formats/LOCFile.h"
+#include "Formats/MaterialsFile.h"
+#include "Formats/ModelsFile.h"
+#include "PCK/AssetCache.h"
+#include "Skin/SkinModel.h"
+#include "Util/Log.h"
+#include "Util/Trace.h"
+
+// Makes a decoder for the formats that read themselves straight out of the file data
+template<typename T>
+static std::function<std::shared_ptr<T>(const PCKAssetFile&)> ReadDecoder()
+{
+	return [](const PCKAssetFile& file) {
+		auto decoded = std::make_shared<T>();
+		decoded->Read(file.getData(), file.getFileSize());
+		return decoded;
+	};
+}
+
+AssetCache::AssetCache(size_t budget)
+	: mBudget(budget)
+{
+	registerDecoder<LOCFile>(PCKAssetFile::Type::LOCALISATION, ReadDecoder<LOCFile>());
+	registerDecoder<GRFFile>(PCKAssetFile::Type::GAME_RULES, ReadDecoder<GRFFile>());
+	registerDecoder<GRFFile>(PCKAssetFile::Type::GAME_RULES_HEADER, ReadDecoder<GRFFile>());
+	registerDecoder<COLFile>(PCKAssetFile::Type::COLOUR_TABLE, ReadDecoder<COLFile>());
+	registerDecoder<ModelsFile>(PCKAssetFile::Type::MODELS, ReadDecoder<ModelsFile>());
+	registerDecoder<MaterialsFile>(PCKAssetFile::Type::MATERIALS, ReadDecoder<MaterialsFile>());
+	registerDecoder<BehavioursFile>(PCKAssetFile::Type::BEHAVIOURS, ReadDecoder<BehavioursFile>());
+
+	// skins decode to their box model, built from the metadata the asset keeps parsed; the texture is the graphics' to cache
+	registerDecoder<SkinModel>(PCKAssetFile::Type::SKIN, [](const PCKAssetFile& file) {
+		auto model = std::make_shared<SkinModel>();
+		model->Build(*file.getSkinMetadata());
+		return model;
+	});
+}
+
+void AssetCache::setPinned(const PCKAssetFile& file, bool pinned)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto it = mEntries.find(&file);
+	if (it != mEntries.end() && it->second.revision == file.getRevision())
+		it->second.pinned = pinned;
+
+	if (!pinned)
+		Evict(nullptr);
+}
+
+void AssetCache::clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mEntries.clear();
+	mUses.clear();
+	mUsage = 0;
+}
+
+size_t AssetCache::getMemoryUsage() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mUsage;
+}
+
+void AssetCache::setBudget(size_t budget)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mBudget = budget;
+	Evict(nullptr);
+}
+
+std::shared_ptr<void> AssetCache::getDecoded(const PCKAssetFile& file, std::type_index type)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto decoder = mDecoders.find(file.getAssetType());
+	if (decoder == mDecoders.end())
+		return nullptr;
+
+	if (decoder->second.type != type)
+		throw std::logic_error(std::string("Asset type ") + PCKAssetFile::getAssetTypeString(file.getAssetType()) + " doesn't decode to " + type.name());
+
+	auto it = mEntries.find(&file);
+	if (it != mEntries.end() && (it->second.revision != file.getRevision() || it->second.type != type))
+	{
+		Erase(it);
+		it = mEntries.end();
+	}
+
+	if (it == mEntries.end())
+	{
+		TRACE_SCOPE("AssetCache decode");
+
+		Entry entry;
+		entry.revision = file.getRevision();
+		entry.type = type;
+		entry.size = file.getFileSize() + 1024; // rough, but decoded assets are mostly about as big as their data
+
+		try
+		{
+			std::shared_ptr<void> decoded = decoder->second.decode(file);
+
+			// shares ownership with the data it was decoded from, so views into it stay valid after the asset's data is replaced
+			auto owner = std::make_shared<std::pair<std::shared_ptr<const std::vector<unsigned char>>, std::shared_ptr<void>>>(file.getSharedData(), decoded);
+			entry.value = std::shared_ptr<void>(owner, decoded.get());
+		}
+		catch (...)
+		{
+			entry.error = std::current_exception();
+		}
+
+		mUses.push_front(&file);
+		entry.use = mUses.begin();
+		mUsage += entry.size;
+		it = mEntries.emplace(&file, std::move(entry)).first;
+
+		Evict(&file);
+	}
+	else
+		mUses.splice(mUses.begin(), mUses, it->second.use);
+
+	if (it->second.error)
+		std::rethrow_exception(it->second.error);
+
+	return it->second.value;
+}
+
+void AssetCache::Evict(const PCKAssetFile* keep)
+{
+	// whoever is still holding onto a dropped entry keeps it alive until they let go
+	auto it = mUses.end();
+	while (mUsage > mBudget && it != mUses.begin())
+	{
+		auto victim = std::prev(it);
+		auto entry = mEntries.find(*victim);
+
+		if (*victim == keep || entry->second.pinned)
+			it = victim;
+		else
+			Erase(entry);
+	}
+}
+
+void AssetCache::Erase(std::unordered_map<const PCKAssetFile*, Entry>::iterator it)
+{
+	mUsage -= it->second.size;
+	mUses.erase(it->second.use);
+	mEntries.erase(it);
+}
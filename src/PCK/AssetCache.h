@@ -0,0 +1,84 @@
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include "PCK/PCKAssetFile.h"
+
+// Decoded forms of assets, like the LOC File of a localisation asset or the model of a skin, so they aren't decoded again every time they're used.
+// Entries are keyed by the asset and its revision, which every change to the asset's data or properties bumps, so setData and the property setters invalidate them without being told to.
+class AssetCache
+{
+public:
+	// Registers the decoders for every asset type that has one; budget is roughly how many bytes of decoded assets are kept before the least recently used are dropped
+	explicit AssetCache(size_t budget = 64 * 1024 * 1024);
+
+	AssetCache(const AssetCache&) = delete;
+	AssetCache& operator=(const AssetCache&) = delete;
+
+	// Registers the decoder for an asset type, replacing any it had; every asset of the type decodes to a T
+	template<typename T>
+	void registerDecoder(PCKAssetFile::Type type, std::function<std::shared_ptr<T>(const PCKAssetFile&)> decoder)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mDecoders[type] = { typeid(T), [decoder = std::move(decoder)](const PCKAssetFile& file) -> std::shared_ptr<void> { return decoder(file); } };
+	}
+
+	// Gets the decoded form of an asset, decoding it if it isn't cached or the asset changed since; null if its type has no decoder. Throws whatever the decoder throws.
+	// Decoded forms may point into the asset's data, so they keep the data they were decoded from alive for as long as they're held onto
+	template<typename T>
+	std::shared_ptr<T> get(const PCKAssetFile& file)
+	{
+		return std::static_pointer_cast<T>(getDecoded(file, typeid(T)));
+	}
+
+	// Keeps the decoded form of an asset from being evicted, like while an editor has changes in it that weren't written back to the asset yet; dropped anyway once the asset changes
+	void setPinned(const PCKAssetFile& file, bool pinned);
+
+	// Drops every cached asset, like when the PCK File they came from is closed
+	void clear();
+
+	// Gets roughly how many bytes the cached assets take up
+	size_t getMemoryUsage() const;
+
+	// Sets how many bytes of decoded assets are kept, dropping the least recently used until they fit
+	void setBudget(size_t budget);
+
+private:
+	struct Decoder
+	{
+		std::type_index type{ typeid(void) };
+		std::function<std::shared_ptr<void>(const PCKAssetFile&)> decode{};
+	};
+
+	struct Entry
+	{
+		uint32_t revision{ 0 };
+		std::type_index type{ typeid(void) };
+		std::shared_ptr<void> value{};
+		std::exception_ptr error{}; // assets that fail to decode fail the same way until they change, instead of being decoded again on every use
+		size_t size{ 0 };
+		bool pinned{ false };
+		std::list<const PCKAssetFile*>::iterator use{}; // where the asset is in mUses
+	};
+
+	// Looks up or decodes an asset, checking the decoder makes the type asked for
+	std::shared_ptr<void> getDecoded(const PCKAssetFile& file, std::type_index type);
+
+	// Drops the least recently used entries until the cache fits its budget, keeping the one just used and any that are pinned
+	void Evict(const PCKAssetFile* keep);
+
+	// Drops one entry
+	void Erase(std::unordered_map<const PCKAssetFile*, Entry>::iterator it);
+
+	mutable std::mutex mMutex;
+	std::unordered_map<PCKAssetFile::Type, Decoder> mDecoders{};
+	std::unordered_map<const PCKAssetFile*, Entry> mEntries{}; // asset addresses are only compared, never followed; a new asset at an old address has a newer revision
+	std::list<const PCKAssetFile*> mUses{}; // most recently used first
+	size_t mBudget;
+	size_t mUsage{ 0 };
+};
@@ -1,15 +1,128 @@
+#include <atomic>
+#include <cstring>
 #include "PCK/PCKAssetFile.h"
+#include "PCK/PCKFile.h"
+#include "Skin/SkinMetadata.h"
+
+static std::atomic<uint32_t> gRevisionCounter{ 0 };
+
+PCKAssetFile::PCKAssetFile(const std::string& path, Type assetType)
+	: mAssetType(assetType), mPath(path) {
+}
+
+PCKAssetFile::PCKAssetFile(const std::string& path, const std::vector<unsigned char>& data, Type assetType)
+	: PCKAssetFile(path, assetType) {
+	setData(data);
+}
+
+PCKAssetFile::PCKAssetFile(const std::string& path, std::vector<unsigned char>&& data, Type assetType)
+	: PCKAssetFile(path, assetType) {
+	setData(std::move(data));
+}
+
+PCKAssetFile::~PCKAssetFile() = default;
+
+PCKAssetFile::PCKAssetFile(const PCKAssetFile& other)
+	: mAssetType(other.mAssetType), mBuffer(other.mBuffer), mOffset(other.mOffset), mSize(other.mSize),
+	mPath(other.mPath), mProperties(other.mProperties), mRevision(other.mRevision),
+	mNested(other.mNested ? std::make_unique<PCKFile>(*other.mNested) : nullptr), mNestedRevision(other.mNestedRevision),
+	mSkinMetadata(std::atomic_load(&other.mSkinMetadata)) {
+}
+
+PCKAssetFile::PCKAssetFile(PCKAssetFile&&) noexcept = default;
+
+PCKAssetFile& PCKAssetFile::operator=(const PCKAssetFile& other)
+{
+	if (this != &other)
+		*this = PCKAssetFile(other);
+	return *this;
+}
+
+PCKAssetFile& PCKAssetFile::operator=(PCKAssetFile&&) noexcept = default;
+
+uint32_t PCKAssetFile::NextRevision()
+{
+	return ++gRevisionCounter;
+}
+
+uint32_t PCKAssetFile::LatestRevision()
+{
+	return gRevisionCounter;
+}
 
 std::size_t PCKAssetFile::getFileSize() const {
-	return mData.size();
+	return mSize;
 }
 
-const std::vector<unsigned char>& PCKAssetFile::getData() const {
-	return mData;
+const unsigned char* PCKAssetFile::getData() const {
+	return mBuffer ? mBuffer->data() + mOffset : nullptr;
+}
+
+std::shared_ptr<const std::vector<unsigned char>> PCKAssetFile::getSharedData() const {
+	return mBuffer;
 }
 
 void PCKAssetFile::setData(const std::vector<unsigned char>& data) {
-	mData = data;
+	setData(std::vector<unsigned char>(data));
+}
+
+void PCKAssetFile::setData(std::vector<unsigned char>&& data) {
+	size_t size = data.size();
+	setSharedData(std::make_shared<const std::vector<unsigned char>>(std::move(data)), 0, size);
+}
+
+void PCKAssetFile::setSharedData(std::shared_ptr<const std::vector<unsigned char>> buffer, size_t offset, size_t size) {
+	if (!buffer || offset > buffer->size() || size > buffer->size() - offset)
+		throw std::runtime_error("File data out of range: " + mPath);
+
+	mBuffer = std::move(buffer);
+	mOffset = offset;
+	mSize = size;
+	mNested.reset(); // whatever was read out of the old data is gone with it
+	mRevision = NextRevision();
+}
+
+void PCKAssetFile::shareDataWith(const PCKAssetFile& other) {
+	if (other.mSize != mSize || (mSize > 0 && std::memcmp(other.getData(), getData(), mSize) != 0))
+		throw std::runtime_error("File data isn't identical: " + mPath + ", " + other.mPath);
+
+	// a nested PCK File read out of the data stays valid, since it only points into a buffer it holds onto itself
+	mBuffer = other.mBuffer;
+	mOffset = other.mOffset;
+}
+
+PCKFile* PCKAssetFile::getNestedPCK()
+{
+	if (!mNested && isPCKType())
+	{
+		auto nested = std::make_unique<PCKFile>();
+		nested->Read(mBuffer, mOffset, mSize);
+		mNestedRevision = nested->getRevision();
+		mNested = std::move(nested);
+	}
+	return mNested.get();
+}
+
+PCKFile* PCKAssetFile::getLoadedNestedPCK() const
+{
+	return mNested.get();
+}
+
+bool PCKAssetFile::updateNestedData()
+{
+	if (!mNested || mNested->getRevision() == mNestedRevision)
+		return false;
+
+	// written into a new buffer, so files still pointing into the old one stay valid
+	auto buffer = std::make_shared<std::vector<unsigned char>>();
+	mNested->Write(*buffer, mNested->getEndianness());
+
+	mBuffer = std::move(buffer);
+	mOffset = 0;
+	mSize = mBuffer->size();
+	mRevision = NextRevision();
+	mNestedRevision = mNested->getRevision(); // after writing, since anything nested deeper was written out along the way
+	return true;
 }
 
 const std::string& PCKAssetFile::getPath() const {
@@ -18,6 +131,7 @@ const std::string& PCKAssetFile::getPath() const {
 
 void PCKAssetFile::setPath(const std::string& inpath) {
 	mPath = inpath;
+	mRevision = NextRevision();
 }
 
 PCKAssetFile::Type PCKAssetFile::getAssetType() const {
@@ -26,23 +140,33 @@ PCKAssetFile::Type PCKAssetFile::getAssetType() const {
 
 void PCKAssetFile::addProperty(const std::string& key, const std::u16string& value) {
 	mProperties.push_back(PCKAssetFile::Property(key, value));
+	mRevision = NextRevision();
+	std::atomic_store(&mSkinMetadata, {});
 }
 
 void PCKAssetFile::removeProperty(int index)
 {
 	if (index >= 0 && index < (int)mProperties.size())
+	{
 		mProperties.erase(mProperties.begin() + index);
+		mRevision = NextRevision();
+		std::atomic_store(&mSkinMetadata, {});
+	}
 }
 
 void PCKAssetFile::setPropertyAtIndex(int index, const std::string& key, const std::u16string& value)
 {
 	if (index < 0 || index >= (int)mProperties.size()) return;
 	mProperties[index] = { key, value };
+	mRevision = NextRevision();
+	std::atomic_store(&mSkinMetadata, {});
 }
 
 void PCKAssetFile::clearProperties()
 {
 	mProperties.clear();
+	mRevision = NextRevision();
+	std::atomic_store(&mSkinMetadata, {});
 }
 
 const std::vector<PCKAssetFile::Property>& PCKAssetFile::getProperties() const
@@ -50,9 +174,33 @@ const std::vector<PCKAssetFile::Property>& PCKAssetFile::getProperties() const
 	return mProperties;
 }
 
+uint32_t PCKAssetFile::getRevision() const
+{
+	return mRevision;
+}
+
 const PCKAssetFile::Type IMAGE_ASSET_TYPES[]{ PCKAssetFile::Type::SKIN, PCKAssetFile::Type::CAPE, PCKAssetFile::Type::TEXTURE };
 
 bool PCKAssetFile::isImageType() const
 {
 	return std::find(std::begin(IMAGE_ASSET_TYPES), std::end(IMAGE_ASSET_TYPES), mAssetType) != std::end(IMAGE_ASSET_TYPES);
-}
\ No newline at end of file
+}
+
+const PCKAssetFile::Type PCK_ASSET_TYPES[]{ PCKAssetFile::Type::SKIN_DATA, PCKAssetFile::Type::AUDIO_DATA, PCKAssetFile::Type::TEXTURE_PACK_INFO };
+
+bool PCKAssetFile::isPCKType() const
+{
+	return std::find(std::begin(PCK_ASSET_TYPES), std::end(PCK_ASSET_TYPES), mAssetType) != std::end(PCK_ASSET_TYPES);
+}
+
+std::shared_ptr<const SkinMetadata> PCKAssetFile::getSkinMetadata() const
+{
+	std::shared_ptr<const SkinMetadata> metadata = std::atomic_load(&mSkinMetadata);
+	if (!metadata)
+	{
+		// threads racing to parse it all get the same result, so it doesn't matter whose is kept
+		metadata = std::make_shared<const SkinMetadata>(SkinMetadata::Parse(mProperties));
+		std::atomic_store(&mSkinMetadata, metadata);
+	}
+	return metadata;
+}
@@ -4,6 +4,10 @@
 #include <fstream>
 #include <vector>
 #include <filesystem>
+#include <memory>
+
+class PCKFile;
+struct SkinMetadata;
 
 // PCK Asset File and Asset File Types research done by NessieHax/Miku666/nullptr, myself (May/MattNL), and many others over the years.
 
@@ -196,28 +200,59 @@ public:
 		return Type::TEXTURE;
 	}
 
-	PCKAssetFile(const std::string& path, const std::vector<unsigned char>& data, Type assetType)
-		: mAssetType(assetType), mData(data), mPath(path) {
-	}
+	PCKAssetFile(const std::string& path, const std::vector<unsigned char>& data, Type assetType);
 
-	PCKAssetFile(const std::string& path, Type assetType)
-		: PCKAssetFile(path, {}, assetType) {
-	}
+	// Takes over the data instead of copying it
+	PCKAssetFile(const std::string& path, std::vector<unsigned char>&& data, Type assetType);
 
-	~PCKAssetFile() {
-		mData.clear();
-		mPath.clear();
-	}
+	PCKAssetFile(const std::string& path, Type assetType);
+
+	// these are all defined out of line since PCKFile is only forward declared here; copies get their own copy of a loaded nested PCK File
+	~PCKAssetFile();
+	PCKAssetFile(const PCKAssetFile& other);
+	PCKAssetFile(PCKAssetFile&&) noexcept;
+	PCKAssetFile& operator=(const PCKAssetFile& other);
+	PCKAssetFile& operator=(PCKAssetFile&&) noexcept;
+
+	// Gets a new revision, newer than every one handed out before; shared by every file so revisions can be compared across them
+	static uint32_t NextRevision();
+
+	// Gets the newest revision handed out so far; as long as it stays the same, nothing in any file or PCK File changed
+	static uint32_t LatestRevision();
 
 	// Gets the file size, in bytes
 	std::size_t getFileSize() const;
 
-	// Gets the file data as a const unsigned char vector
-	const std::vector<unsigned char>& getData() const;
+	// Gets the file data; getFileSize() bytes long, and null when empty
+	const unsigned char* getData() const;
+
+	// Gets the buffer the file data is in, which may be shared with other files; holding onto it keeps the data alive even after the file's data is replaced
+	std::shared_ptr<const std::vector<unsigned char>> getSharedData() const;
 
 	// Sets the file data with a const unsigned char vector
 	void setData(const std::vector<unsigned char>& data);
 
+	// Sets the file data, taking over the vector instead of copying it
+	void setData(std::vector<unsigned char>&& data);
+
+	// Points the file data at part of a buffer shared with other files instead of a copy of its own, like the payload of the PCK File it's nested in
+	void setSharedData(std::shared_ptr<const std::vector<unsigned char>> buffer, size_t offset, size_t size);
+
+	// Points the file data at another file's identical data, so the two share one buffer; nothing about the file changes, so neither does its revision. Throws if the data isn't identical
+	void shareDataWith(const PCKAssetFile& other);
+
+	// Checks if the file is a PCK File itself; Skin Data, Audio Data and Texture Pack Info
+	bool isPCKType() const;
+
+	// Gets the PCK File nested in this file, reading it out of the file data the first time; null if the file isn't a PCK type. Throws if the data isn't a valid PCK File
+	PCKFile* getNestedPCK();
+
+	// Gets the nested PCK File if it was already read, without reading it
+	PCKFile* getLoadedNestedPCK() const;
+
+	// Writes the nested PCK File back into the file data if anything in it changed since it was read or last written. Returns true if it was written
+	bool updateNestedData();
+
 	// Gets the file path
 	const std::string& getPath() const;
 
@@ -245,9 +280,21 @@ public:
 	// Returns the files properties as a... vector of a pair of a string and u16string
 	const std::vector<Property>& getProperties() const;
 
+	// Gets the revision of the file; bumped every time the data, path or properties are changed
+	uint32_t getRevision() const;
+
+	// Gets the ANIM, BOX and OFFSET properties parsed, parsing them the first time it's asked for; kept until the properties change. Safe to call from multiple threads at once
+	std::shared_ptr<const SkinMetadata> getSkinMetadata() const;
+
 private:
 	Type mAssetType{ Type::SKIN };
-	std::vector<unsigned char> mData;
+	std::shared_ptr<const std::vector<unsigned char>> mBuffer; // may be shared with other files; never written to, only replaced
+	size_t mOffset{ 0 };
+	size_t mSize{ 0 };
 	std::string mPath;
 	std::vector<Property> mProperties;
+	uint32_t mRevision{ 0 };
+	std::unique_ptr<PCKFile> mNested;
+	uint32_t mNestedRevision{ 0 }; // revision of the nested PCK File when it was last read or written into the data
+	mutable std::shared_ptr<const SkinMetadata> mSkinMetadata; // only ever swapped atomically, since it's filled in by getters
 };
\ No newline at end of file
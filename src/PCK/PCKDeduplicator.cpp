@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include "PCK/PCKDeduplicator.h"
+#include "Util/Hash.h"
+#include "Util/Log.h"
+#include "Util/ThreadPool.h"
+#include "Util/Trace.h"
+
+uint64_t PCKDeduplicator::Result::getWastedSize() const
+{
+	uint64_t wasted = 0;
+	for (const Group& group : groups)
+		wasted += group.getWastedSize();
+	return wasted;
+}
+
+size_t PCKDeduplicator::Result::getDuplicateCount() const
+{
+	size_t count = 0;
+	for (const Group& group : groups)
+		count += group.files.size() - 1;
+	return count;
+}
+
+void PCKDeduplicator::CollectFiles(PCKFile& pckFile, const std::string& pack, std::vector<Entry>& entries, const PCKAssetFile* container)
+{
+	for (PCKAssetFile& file : pckFile.getFiles())
+	{
+		entries.push_back({ &file, pack, container });
+
+		if (!file.isPCKType())
+			continue;
+
+		try
+		{
+			if (PCKFile* nested = file.getNestedPCK())
+				CollectFiles(*nested, pack + "/" + file.getPath(), entries, &file);
+		}
+		catch (const std::exception& e)
+		{
+			LOG_WARNING("Couldn't read nested PCK File %s/%s: %s", pack.c_str(), file.getPath().c_str(), e.what());
+		}
+	}
+}
+
+PCKDeduplicator::Result PCKDeduplicator::FindDuplicates(const std::vector<Entry>& entries, JobProgress* progress, unsigned int threadCount)
+{
+	TRACE_SCOPE("PCKDeduplicator::FindDuplicates");
+
+	Result result;
+	auto startTime = std::chrono::steady_clock::now();
+
+	// only files that share their size with another one can be duplicates, so nothing else is hashed
+	std::unordered_map<size_t, size_t> sizeCounts;
+	for (const Entry& entry : entries)
+	{
+		if (entry.file->getFileSize() > 0)
+			++sizeCounts[entry.file->getFileSize()];
+	}
+
+	std::vector<const Entry*> candidates;
+	uint64_t totalSize = 0;
+	for (const Entry& entry : entries)
+	{
+		size_t size = entry.file->getFileSize();
+		if (size > 0 && sizeCounts[size] > 1)
+		{
+			candidates.push_back(&entry);
+			totalSize += size;
+		}
+	}
+
+	// biggest first, so one huge file doesn't end up being hashed alone at the very end
+	std::stable_sort(candidates.begin(), candidates.end(), [](const Entry* a, const Entry* b) {
+		return a->file->getFileSize() > b->file->getFileSize();
+		});
+
+	if (progress)
+		progress->setTotal(totalSize);
+
+	std::vector<uint64_t> hashes(candidates.size());
+
+	if (!candidates.empty())
+	{
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+		threadCount = std::max(1u, std::min<unsigned int>(threadCount, static_cast<unsigned int>(candidates.size())));
+		result.threadCount = threadCount;
+
+		std::atomic<size_t> next{ 0 };
+		ThreadPool pool(threadCount);
+		for (unsigned int i = 0; i < threadCount; ++i)
+		{
+			pool.Submit([&] {
+				for (size_t index = next++; index < candidates.size(); index = next++)
+				{
+					if (progress && progress->isCancelled())
+						return;
+
+					const PCKAssetFile& file = *candidates[index]->file;
+					hashes[index] = Hash::XXH64(file.getData(), file.getFileSize());
+
+					if (progress)
+						progress->advance(file.getFileSize());
+				}
+				});
+		}
+		pool.Wait();
+
+		if (progress)
+			progress->throwIfCancelled();
+	}
+
+	result.filesHashed = candidates.size();
+	result.bytesHashed = totalSize;
+
+	// same size and hash is only very nearly certainly the same data, so every file is still compared with the group it lands in
+	std::unordered_map<uint64_t, std::vector<size_t>> byHash; // hash to indices into result.groups, usually just the one
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		const PCKAssetFile& file = *candidates[i]->file;
+		std::vector<size_t>& groupIndices = byHash[hashes[i]];
+
+		auto match = std::find_if(groupIndices.begin(), groupIndices.end(), [&](size_t groupIndex) {
+			const PCKAssetFile& first = *result.groups[groupIndex].files.front().file;
+			return first.getFileSize() == file.getFileSize() &&
+				(first.getData() == file.getData() || std::memcmp(first.getData(), file.getData(), file.getFileSize()) == 0);
+			});
+
+		if (match != groupIndices.end())
+			result.groups[*match].files.push_back(*candidates[i]);
+		else
+		{
+			groupIndices.push_back(result.groups.size());
+			result.groups.push_back({ hashes[i], file.getFileSize(), { *candidates[i] } });
+		}
+	}
+
+	// a copy of a nested pack is a copy of everything in it, so what's in it isn't counted again
+	std::unordered_map<const PCKAssetFile*, const PCKAssetFile*> containers;
+	for (const Entry& entry : entries)
+		containers[entry.file] = entry.container;
+
+	std::unordered_set<const PCKAssetFile*> copies;
+	for (const Group& group : result.groups)
+		for (size_t i = 1; i < group.files.size(); ++i)
+			copies.insert(group.files[i].file);
+
+	auto isInCopy = [&](const Entry& entry) {
+		for (const PCKAssetFile* container = entry.container; container; container = containers[container])
+			if (copies.count(container))
+				return true;
+		return false;
+	};
+
+	for (Group& group : result.groups)
+		group.files.erase(std::remove_if(group.files.begin(), group.files.end(), isInCopy), group.files.end());
+
+	result.groups.erase(std::remove_if(result.groups.begin(), result.groups.end(), [](const Group& group) {
+		return group.files.size() < 2;
+		}), result.groups.end());
+
+	std::stable_sort(result.groups.begin(), result.groups.end(), [](const Group& a, const Group& b) {
+		return a.getWastedSize() > b.getWastedSize();
+		});
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	LOG_INFO("Hashed %zu file(s), %llu bytes, on %u thread(s) in %.3f s; %zu duplicate(s) wasting %llu bytes", result.filesHashed,
+		(unsigned long long)result.bytesHashed, result.threadCount, result.seconds, result.getDuplicateCount(), (unsigned long long)result.getWastedSize());
+
+	return result;
+}
+
+uint64_t PCKDeduplicator::ShareDuplicates(const Result& result)
+{
+	TRACE_SCOPE("PCKDeduplicator::ShareDuplicates");
+
+	uint64_t freed = 0;
+	for (const Group& group : result.groups)
+	{
+		const PCKAssetFile& first = *group.files.front().file;
+		for (size_t i = 1; i < group.files.size(); ++i)
+		{
+			PCKAssetFile& file = *group.files[i].file;
+			if (file.getData() == first.getData())
+				continue; // already shared
+
+			// only a buffer nothing else holds is freed; the files of nested packs point into the data of the pack they're in, which stays held anyway
+			std::shared_ptr<const std::vector<unsigned char>> replaced = file.getSharedData();
+			file.shareDataWith(first);
+			if (replaced && replaced.use_count() == 1)
+				freed += replaced->size();
+		}
+	}
+
+	return freed;
+}
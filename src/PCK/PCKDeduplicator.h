@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "PCK/PCKFile.h"
+#include "Util/JobProgress.h"
+
+// Finds asset files with byte for byte identical data, in one pack or across many, like the same texture under several paths or the same skin in several packs
+class PCKDeduplicator
+{
+public:
+	// A file to look at, and where it's from
+	struct Entry
+	{
+		PCKAssetFile* file{ nullptr };
+		std::string pack{}; // the pack the file is in, for reports; nested packs are the path of the pack they're in, then their own path
+		const PCKAssetFile* container{ nullptr }; // the file of the nested pack it's in, if it's in one
+	};
+
+	// Files whose data is identical
+	struct Group
+	{
+		uint64_t hash{ 0 };
+		size_t size{ 0 }; // of each file's data
+		std::vector<Entry> files{};
+
+		// Gets the bytes taken up by every copy past the first
+		uint64_t getWastedSize() const { return static_cast<uint64_t>(size) * (files.size() - 1); }
+	};
+
+	// What a search found
+	struct Result
+	{
+		std::vector<Group> groups{}; // most wasted bytes first
+		size_t filesHashed{ 0 };
+		uint64_t bytesHashed{ 0 };
+		double seconds{ 0.0 };
+		unsigned int threadCount{ 0 };
+
+		// Gets the bytes taken up by every duplicate, in all groups
+		uint64_t getWastedSize() const;
+
+		// Gets how many files are copies of another one
+		size_t getDuplicateCount() const;
+	};
+
+	// Collects every file of a pack, and of every nested pack in it, reading the nested packs that weren't read yet; nested packs that don't read are only collected as the file they're in
+	static void CollectFiles(PCKFile& pckFile, const std::string& pack, std::vector<Entry>& entries, const PCKAssetFile* container = nullptr);
+
+	// Hashes the data of every file that has the same size as another one on a pool of threads, then groups those with identical data;
+	// files with the same hash are compared in full before they're grouped. Empty files are skipped, and so are the files of nested packs that are copies
+	// of another nested pack, since the pack being a copy already covers them. 0 threads uses one per hardware thread
+	static Result FindDuplicates(const std::vector<Entry>& entries, JobProgress* progress = nullptr, unsigned int threadCount = 0);
+
+	// Points every file of each group at the data of its first file, so identical data is only held in memory once. Returns the bytes of data that were actually freed,
+	// which leaves out files that only pointed into data something else still holds, like the files of nested packs
+	static uint64_t ShareDuplicates(const Result& result);
+};
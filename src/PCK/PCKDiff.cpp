@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <unordered_map>
+#include "PCK/PCKDiff.h"
+#include "Util/Trace.h"
+
+// Compares properties key by key; the order between different keys doesn't matter, only the order of values with the same key
+static std::vector<PCKDiff::PropertyChange> CompareProperties(const std::vector<PCKAssetFile::Property>& oldProperties, const std::vector<PCKAssetFile::Property>& newProperties)
+{
+	std::vector<PCKDiff::PropertyChange> changes;
+	if (oldProperties == newProperties)
+		return changes;
+
+	// keys in the order they first come up, so the changes read in the same order as the properties
+	std::vector<std::string> keys;
+	std::unordered_map<std::string, std::pair<std::vector<const std::u16string*>, std::vector<const std::u16string*>>> values;
+
+	for (const auto& [key, value] : oldProperties)
+	{
+		auto [it, inserted] = values.try_emplace(key);
+		if (inserted)
+			keys.push_back(key);
+		it->second.first.push_back(&value);
+	}
+
+	for (const auto& [key, value] : newProperties)
+	{
+		auto [it, inserted] = values.try_emplace(key);
+		if (inserted)
+			keys.push_back(key);
+		it->second.second.push_back(&value);
+	}
+
+	for (const std::string& key : keys)
+	{
+		const auto& [oldValues, newValues] = values[key];
+		for (size_t i = 0; i < std::max(oldValues.size(), newValues.size()); ++i)
+		{
+			bool hasOld = i < oldValues.size();
+			bool hasNew = i < newValues.size();
+			if (hasOld && hasNew && *oldValues[i] == *newValues[i])
+				continue;
+
+			changes.push_back({ key, hasOld ? *oldValues[i] : std::u16string(), hasNew ? *newValues[i] : std::u16string(), hasOld, hasNew });
+		}
+	}
+
+	return changes;
+}
+
+const char* PCKDiff::getChangeTypeString(ChangeType type)
+{
+	switch (type)
+	{
+	case ChangeType::ADDED: return "Added";
+	case ChangeType::REMOVED: return "Removed";
+	case ChangeType::RENAMED: return "Renamed";
+	case ChangeType::CHANGED: return "Changed";
+	default: return "Unknown";
+	}
+}
+
+void PCKDiff::Compare(std::vector<PCKFile::IndexEntry> oldFiles, std::vector<PCKFile::IndexEntry> newFiles)
+{
+	TRACE_SCOPE("PCKDiff::Compare");
+
+	mOldFiles = std::move(oldFiles);
+	mNewFiles = std::move(newFiles);
+	mChanges.clear();
+	mUnchangedCount = 0;
+
+	std::vector<bool> oldMatched(mOldFiles.size()), newMatched(mNewFiles.size());
+
+	auto compareFiles = [&](size_t oldIndex, size_t newIndex, ChangeType type) {
+		const PCKFile::IndexEntry& oldFile = mOldFiles[oldIndex];
+		const PCKFile::IndexEntry& newFile = mNewFiles[newIndex];
+		oldMatched[oldIndex] = true;
+		newMatched[newIndex] = true;
+
+		Change change;
+		change.type = type;
+		change.oldFile = oldIndex;
+		change.newFile = newIndex;
+		change.dataChanged = oldFile.size != newFile.size || oldFile.hash != newFile.hash;
+		change.typeChanged = oldFile.type != newFile.type;
+		change.properties = CompareProperties(oldFile.properties, newFile.properties);
+
+		if (type == ChangeType::CHANGED && !change.dataChanged && !change.typeChanged && change.properties.empty())
+			++mUnchangedCount;
+		else
+			mChanges.push_back(std::move(change));
+	};
+
+	// by path; a path that's in a pack more than once is matched by which time it comes up
+	std::unordered_map<std::string, std::pair<std::vector<size_t>, size_t>> newByPath; // indices with the path, then how many were matched
+	for (size_t i = 0; i < mNewFiles.size(); ++i)
+		newByPath[mNewFiles[i].path].first.push_back(i);
+
+	for (size_t i = 0; i < mOldFiles.size(); ++i)
+	{
+		auto it = newByPath.find(mOldFiles[i].path);
+		if (it != newByPath.end() && it->second.second < it->second.first.size())
+			compareFiles(i, it->second.first[it->second.second++], ChangeType::CHANGED);
+	}
+
+	// whatever's left with the same data on both sides was moved; empty files say nothing about where they went, so they're left alone
+	std::unordered_map<uint64_t, std::vector<size_t>> addedByHash;
+	for (size_t i = 0; i < mNewFiles.size(); ++i)
+	{
+		if (!newMatched[i] && mNewFiles[i].size > 0)
+			addedByHash[mNewFiles[i].hash].push_back(i);
+	}
+
+	for (size_t i = 0; i < mOldFiles.size(); ++i)
+	{
+		if (oldMatched[i])
+			continue;
+
+		auto it = addedByHash.find(mOldFiles[i].hash);
+		if (it == addedByHash.end())
+			continue;
+
+		for (size_t newIndex : it->second)
+		{
+			if (!newMatched[newIndex] && mNewFiles[newIndex].size == mOldFiles[i].size)
+			{
+				compareFiles(i, newIndex, ChangeType::RENAMED);
+				break;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < mOldFiles.size(); ++i)
+	{
+		if (!oldMatched[i])
+			mChanges.push_back({ ChangeType::REMOVED, i, NONE });
+	}
+
+	for (size_t i = 0; i < mNewFiles.size(); ++i)
+	{
+		if (!newMatched[i])
+			mChanges.push_back({ ChangeType::ADDED, NONE, i });
+	}
+}
+
+size_t PCKDiff::getChangeCount(ChangeType type) const
+{
+	return std::count_if(mChanges.begin(), mChanges.end(), [type](const Change& change) { return change.type == type; });
+}
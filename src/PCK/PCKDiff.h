@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PCK/PCKFile.h"
+
+// What changed between two versions of a PCK File: files are matched by path first, then what's left by the hash of their data to find renames
+class PCKDiff
+{
+public:
+	// How a file changed
+	enum class ChangeType
+	{
+		ADDED,
+		REMOVED,
+		RENAMED, // moved to another path with the same data; may have other changes too
+		CHANGED // same path, but different data, type or properties
+	};
+
+	// A property value that was added, removed or changed; values of the same key are compared in the order they're in, so repeated keys like BOX line up
+	struct PropertyChange
+	{
+		std::string key{};
+		std::u16string oldValue{};
+		std::u16string newValue{};
+		bool hasOld{ false };
+		bool hasNew{ false };
+	};
+
+	// A file that changed
+	struct Change
+	{
+		ChangeType type{ ChangeType::CHANGED };
+		size_t oldFile{ NONE }; // index into getOldFiles(), or NONE if it was added
+		size_t newFile{ NONE }; // index into getNewFiles(), or NONE if it was removed
+		bool dataChanged{ false };
+		bool typeChanged{ false };
+		std::vector<PropertyChange> properties{};
+	};
+
+	static constexpr size_t NONE = SIZE_MAX;
+
+	// Gets the name of a change type, for display
+	static const char* getChangeTypeString(ChangeType type);
+
+	// Compares two file lists, like ones from PCKFile::ReadIndex; the lists are kept, so changes can point into them
+	void Compare(std::vector<PCKFile::IndexEntry> oldFiles, std::vector<PCKFile::IndexEntry> newFiles);
+
+	// Gets the files of the old version
+	const std::vector<PCKFile::IndexEntry>& getOldFiles() const { return mOldFiles; }
+
+	// Gets the files of the new version
+	const std::vector<PCKFile::IndexEntry>& getNewFiles() const { return mNewFiles; }
+
+	// Gets every change; changed files first, then renamed, removed and added ones, each in the order the files are in
+	const std::vector<Change>& getChanges() const { return mChanges; }
+
+	// Gets how many changes there are of a type
+	size_t getChangeCount(ChangeType type) const;
+
+	// Gets how many files are exactly the same in both versions
+	size_t getUnchangedCount() const { return mUnchangedCount; }
+
+private:
+	std::vector<PCKFile::IndexEntry> mOldFiles{};
+	std::vector<PCKFile::IndexEntry> mNewFiles{};
+	std::vector<Change> mChanges{};
+	size_t mUnchangedCount{ 0 };
+};
@@ -0,0 +1,166 @@
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include "Binary/Binary.h"
+#include "PCK/PCKExtractor.h"
+#include "Util/ThreadPool.h"
+#include "Util/Trace.h"
+
+// more writers than this just fight over the disk
+static const unsigned int MAX_EXTRACT_THREADS = 8;
+
+// Writes a whole buffer with one unbuffered write, since the data is already in memory; on failure, error is the errno it failed with
+static bool WriteWholeFile(const std::filesystem::path& path, const void* data, size_t size, int& error)
+{
+#ifdef _WIN32
+	std::FILE* file = _wfopen(path.c_str(), L"wb");
+#else
+	std::FILE* file = std::fopen(path.c_str(), "wb");
+#endif
+	if (!file)
+	{
+		error = errno != 0 ? errno : EIO;
+		return false;
+	}
+
+	std::setvbuf(file, nullptr, _IONBF, 0);
+
+	bool written = size == 0 || std::fwrite(data, 1, size, file) == size;
+	if (!written)
+		error = errno != 0 ? errno : EIO;
+
+	if (std::fclose(file) != 0 && written)
+	{
+		error = errno != 0 ? errno : EIO;
+		written = false;
+	}
+
+	return written;
+}
+
+PCKExtractor::Result PCKExtractor::Extract(const std::vector<Entry>& entries, bool includeProperties, JobProgress* progress, unsigned int threadCount)
+{
+	TRACE_SCOPE("PCKExtractor::Extract");
+
+	Result result;
+	auto startTime = std::chrono::steady_clock::now();
+
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::min(std::thread::hardware_concurrency(), MAX_EXTRACT_THREADS));
+	threadCount = std::max(1u, std::min<unsigned int>(threadCount, static_cast<unsigned int>(entries.size())));
+	result.threadCount = threadCount;
+
+	std::mutex errorMutex;
+	auto addError = [&](const std::filesystem::path& path, const std::string& message) {
+		std::lock_guard<std::mutex> lock(errorMutex);
+		result.errors.push_back({ path, message });
+	};
+
+	// every directory is made once before any writer starts
+	std::set<std::filesystem::path> directories;
+	uint64_t totalSize = 0;
+	for (const Entry& entry : entries)
+	{
+		directories.insert(entry.outPath.parent_path());
+		totalSize += entry.file->getFileSize();
+	}
+
+	for (const std::filesystem::path& directory : directories)
+	{
+		std::error_code error;
+		if (!directory.empty())
+			std::filesystem::create_directories(directory, error);
+		if (error)
+			addError(directory, error.message());
+	}
+
+	if (progress)
+		progress->setTotal(totalSize);
+
+	// errno of every file and property sidecar that failed to write, put into words once the writers are done
+	std::vector<int> fileErrors(entries.size(), 0);
+	std::vector<int> propertyErrors(entries.size(), 0);
+
+	std::atomic<size_t> nextEntry{ 0 };
+	std::atomic<size_t> filesWritten{ 0 };
+	std::atomic<uint64_t> bytesWritten{ 0 };
+
+	auto writer = [&]() {
+		// reused for every property sidecar this writer makes
+		std::u16string propertyData;
+
+		for (size_t i = nextEntry++; i < entries.size(); i = nextEntry++)
+		{
+			if (progress && progress->isCancelled())
+				return;
+
+			const Entry& entry = entries[i];
+			const PCKAssetFile& file = *entry.file;
+
+			if (progress)
+				progress->setStatus(file.getPath());
+
+			if (!WriteWholeFile(entry.outPath, file.getData(), file.getFileSize(), fileErrors[i]))
+				continue;
+
+			// same UTF-16 "key value" lines as the editor writes for single files
+			if (includeProperties && !file.getProperties().empty())
+			{
+				propertyData.clear();
+				for (const auto& [key, value] : file.getProperties())
+				{
+					propertyData += Binary::ToUTF16(key);
+					propertyData += u' ';
+					propertyData += value;
+					propertyData += u'\n';
+				}
+
+				std::filesystem::path propertiesPath = entry.outPath;
+				propertiesPath += ".txt";
+				WriteWholeFile(propertiesPath, propertyData.data(), propertyData.size() * sizeof(char16_t), propertyErrors[i]);
+			}
+
+			++filesWritten;
+			bytesWritten += file.getFileSize();
+			if (progress)
+				progress->advance(file.getFileSize());
+		}
+	};
+
+	if (threadCount == 1)
+		writer();
+	else
+	{
+		ThreadPool pool(threadCount);
+		for (unsigned int i = 0; i < threadCount; ++i)
+			pool.Submit(writer);
+		pool.Wait();
+	}
+
+	// strerror isn't safe to call from the writers, but it is here
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		if (fileErrors[i] != 0)
+			result.errors.push_back({ entries[i].outPath, std::strerror(fileErrors[i]) });
+		if (propertyErrors[i] != 0)
+		{
+			std::filesystem::path propertiesPath = entries[i].outPath;
+			propertiesPath += ".txt";
+			result.errors.push_back({ propertiesPath, std::strerror(propertyErrors[i]) });
+		}
+	}
+
+	result.filesWritten = filesWritten;
+	result.bytesWritten = bytesWritten;
+	result.cancelled = progress && progress->isCancelled();
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	// errors come in whatever order the writers hit them
+	std::sort(result.errors.begin(), result.errors.end(), [](const Error& a, const Error& b) { return a.outPath < b.outPath; });
+
+	return result;
+}
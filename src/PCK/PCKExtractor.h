@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "PCK/PCKAssetFile.h"
+#include "Util/JobProgress.h"
+
+// Writes many asset files to disk at once, for extracting whole packs or folders of them
+class PCKExtractor
+{
+public:
+	// A file to extract, and where it goes
+	struct Entry
+	{
+		const PCKAssetFile* file{ nullptr };
+		std::filesystem::path outPath{};
+	};
+
+	// A file that couldn't be extracted, and why
+	struct Error
+	{
+		std::filesystem::path outPath{};
+		std::string message{};
+	};
+
+	// What an extraction did
+	struct Result
+	{
+		size_t filesWritten{ 0 };
+		uint64_t bytesWritten{ 0 };
+		double seconds{ 0.0 };
+		unsigned int threadCount{ 0 };
+		bool cancelled{ false };
+		std::vector<Error> errors{};
+
+		// Gets the aggregate throughput in MB/s
+		double getThroughput() const { return seconds > 0.0 ? bytesWritten / (1024.0 * 1024.0) / seconds : 0.0; }
+	};
+
+	// Extracts files with a bounded pool of writers; directories are made once up front, and a file that fails is
+	// collected in the result instead of stopping the rest. 0 threads picks one per hardware thread, up to 8
+	static Result Extract(const std::vector<Entry>& entries, bool includeProperties = false, JobProgress* progress = nullptr, unsigned int threadCount = 0);
+};
@@ -1,11 +1,32 @@
+#include <atomic>
 #include <set>
 #include "PCK/PCKFile.h"
 #include "Binary/BinaryReader.h"
 #include "Binary/BinaryWriter.h"
+#include "Util/Hash.h"
+#include "Util/Log.h"
+#include "Util/ThreadPool.h"
+#include "Util/Trace.h"
 
 const char* XML_VERSION_STRING{ "XMLVERSION" }; // used for advanced/full box support for skins
 
-void PCKFile::Read(const std::string& inpath)
+// File data is read and written in chunks of this size when progress is reported, so huge files can still be cancelled midway
+static const size_t PROGRESS_CHUNK_SIZE = 1024 * 1024;
+
+// File data is hashed in batches of about this size when indexing, so only two of them are ever held in memory
+static const size_t INDEX_BATCH_SIZE = 16 * 1024 * 1024;
+
+// Works out the endianness and version from the first 4 bytes of a PCK File, as they were read
+static Binary::Endianness DetectEndianness(uint32_t rawVersion, uint32_t& version)
+{
+	Binary::Endianness endianness;
+	if (!Binary::DetectVersionEndianness(rawVersion, 0, 3, version, endianness))
+		throw std::runtime_error("Invalid PCK version");
+
+	return endianness;
+}
+
+void PCKFile::Read(const std::string& inpath, JobProgress* progress)
 {
 	if (!this)
 	{
@@ -13,35 +34,40 @@ void PCKFile::Read(const std::string& inpath)
 	}
 
 	BinaryReader reader(inpath);
+	Read(reader, progress);
 
-	uint32_t version;
-	reader.ReadData(&version, 4); // assume this is little endian
+	setFilePath(inpath); // finally set the path if everything went well
+}
 
-	uint32_t versionSwapped = Binary::SwapInt32(version); // swapped for endianness check; assume big endian
+void PCKFile::Read(const unsigned char* data, size_t size, JobProgress* progress)
+{
+	BinaryReader reader(data, size);
+	Read(reader, progress);
+}
 
-	if (versionSwapped >= 0 && versionSwapped <= 3)
-	{
-		mEndianess = Binary::Endianness::BIG;
-		mVersion = versionSwapped;
-		printf("Big Endian detected");
-	}
-	else if (version >= 0 && version <= 3)
-	{
-		mEndianess = Binary::Endianness::LITTLE;
-		printf("Little Endian detected");
-		mVersion = version;
-	}
-	else
-	{
-		throw std::runtime_error("Invalid PCK version");
-	}
+void PCKFile::Read(std::shared_ptr<const std::vector<unsigned char>> buffer, size_t offset, size_t size)
+{
+	if (!buffer || offset > buffer->size() || size > buffer->size() - offset)
+		throw std::runtime_error("Nested PCK data out of range");
+
+	BinaryReader reader(buffer->data() + offset, size);
+	Read(reader, nullptr, buffer, offset);
+}
+
+void PCKFile::Read(BinaryReader& reader, JobProgress* progress, const std::shared_ptr<const std::vector<unsigned char>>& source, size_t sourceOffset)
+{
+	TRACE_SCOPE("PCKFile::Read");
 
-	printf(", version %u\n", mVersion);
+	uint32_t version;
+	reader.ReadData(&version, 4); // assume this is little endian
+
+	mEndianess = DetectEndianness(version, mVersion);
+	LOG_DEBUG("%s Endian detected, version %u", mEndianess == Binary::Endianness::BIG ? "Big" : "Little", mVersion);
 
 	reader.SetEndianness(mEndianess);
 
 	uint32_t propertyCount = reader.ReadInt32();
-	printf("Properties: %u\n", propertyCount);
+	LOG_DEBUG("Properties: %u", propertyCount);
 
 	mProperties.clear();
 	mProperties.reserve(propertyCount);
@@ -53,7 +79,7 @@ void PCKFile::Read(const std::string& inpath)
 
 		std::string property = Binary::ToUTF8(reader.ReadU16String(stringLength));
 
-		printf("\tIndex: %u, Property: %s\n", propertyIndex, property.c_str());
+		LOG_DEBUG("\tIndex: %u, Property: %s", propertyIndex, property.c_str());
 
 		mProperties.push_back(property);
 
@@ -65,7 +91,7 @@ void PCKFile::Read(const std::string& inpath)
 
 	if (mXMLSupport) {
 		reader.ReadInt32(); // just "skip" 4 bytes
-		printf("XML Version: %u\n", mXMLSupport);
+		LOG_DEBUG("XML Version: %u", mXMLSupport);
 	}
 
 	uint32_t fileCount = reader.ReadInt32();
@@ -88,14 +114,22 @@ void PCKFile::Read(const std::string& inpath)
 		fileSizes.push_back(fileSize);
 	}
 
-	printf("Files: %u\n", fileCount);
+	LOG_DEBUG("Files: %u", fileCount);
+
+	if (progress)
+	{
+		uint64_t totalSize = 0;
+		for (uint32_t size : fileSizes)
+			totalSize += size;
+		progress->setTotal(totalSize);
+	}
 
 	for (int i{ 0 }; i < mFiles.size(); ++i)
 	{
 		PCKAssetFile& file = mFiles[i];
 		uint32_t propertyCount = reader.ReadInt32();
 
-		printf("\tSize: %u Bytes | Type: %u | Properties: %u | Path: %s\n", fileSizes[i], (uint32_t)file.getAssetType(), propertyCount, file.getPath().c_str());
+		LOG_DEBUG("\tSize: %u Bytes | Type: %u | Properties: %u | Path: %s", fileSizes[i], (uint32_t)file.getAssetType(), propertyCount, file.getPath().c_str());
 
 		for (int j{ 0 }; j < propertyCount; j++)
 		{
@@ -111,20 +145,38 @@ void PCKFile::Read(const std::string& inpath)
 
 			reader.ReadInt32(); // skip 4 bytes
 
-			printf("\t\tProperty: %s %s\n", propertyKey.c_str(), Binary::ToUTF8(propertyValue).c_str());
+			LOG_DEBUG("\t\tProperty: %s %s", propertyKey.c_str(), Binary::ToUTF8(propertyValue).c_str());
 
 			file.addProperty(propertyKey, propertyValue);
 		}
 
+		if (source)
+		{
+			// nested PCK Files are just views into their parent's data until something in them changes
+			file.setSharedData(source, sourceOffset + reader.GetPosition(), fileSizes[i]);
+			reader.Skip(fileSizes[i]);
+			continue;
+		}
+
 		std::vector<unsigned char> fileData(fileSizes[i]);
-		reader.ReadData(fileData.data(), fileData.size());
+		if (progress)
+		{
+			progress->setStatus(file.getPath());
+			for (size_t offset = 0; offset < fileData.size(); offset += PROGRESS_CHUNK_SIZE)
+			{
+				progress->throwIfCancelled();
+				size_t chunkSize = std::min(PROGRESS_CHUNK_SIZE, fileData.size() - offset);
+				reader.ReadData(fileData.data() + offset, chunkSize);
+				progress->advance(chunkSize);
+			}
+		}
+		else
+			reader.ReadData(fileData.data(), fileData.size());
 		file.setData(std::move(fileData));
 	}
-
-	setFilePath(inpath); // finally set the path if everything went well
 }
 
-void PCKFile::Write(const std::string& outpath, Binary::Endianness endianness)
+void PCKFile::Write(const std::string& outpath, Binary::Endianness endianness, JobProgress* progress)
 {
 	if (!this)
 	{
@@ -132,6 +184,21 @@ void PCKFile::Write(const std::string& outpath, Binary::Endianness endianness)
 	}
 
 	BinaryWriter writer(outpath);
+	Write(writer, endianness, progress);
+}
+
+void PCKFile::Write(std::vector<unsigned char>& out, Binary::Endianness endianness, JobProgress* progress)
+{
+	BinaryWriter writer(out);
+	Write(writer, endianness, progress);
+}
+
+void PCKFile::Write(BinaryWriter& writer, Binary::Endianness endianness, JobProgress* progress)
+{
+	TRACE_SCOPE("PCKFile::Write");
+
+	updateNestedFiles(); // before anything is written, since it changes file sizes; nothing to do if the caller already did
+
 	writer.SetEndianness(endianness);
 
 	uint32_t versionOut = mVersion;
@@ -139,30 +206,30 @@ void PCKFile::Write(const std::string& outpath, Binary::Endianness endianness)
 		versionOut = Binary::SwapInt32(mVersion);
 	writer.WriteData(&versionOut, sizeof(uint32_t));
 
-	// make new property list
-	mProperties.clear();
+	// make new property list; kept local, so writing only ever reads the PCK File
+	std::vector<std::string> propertyKeys;
 	std::set<std::string> propertySet;
 
 	if (mXMLSupport)
-		mProperties.push_back(XML_VERSION_STRING);
+		propertyKeys.push_back(XML_VERSION_STRING);
 
 	for (const auto& file : mFiles)
 	{
 		for (const auto& [key, _] : file.getProperties())
 		{
 			if (propertySet.insert(key).second) // only insert if not already in set
-				mProperties.push_back(key);
+				propertyKeys.push_back(key);
 		}
 	}
 
-	uint32_t propertyCount = static_cast<uint32_t>(mProperties.size());
+	uint32_t propertyCount = static_cast<uint32_t>(propertyKeys.size());
 	writer.WriteInt32(propertyCount);
 
 	for (uint32_t i = 0; i < propertyCount; ++i)
 	{
 		writer.WriteInt32(i);
-		writer.WriteInt32(static_cast<uint32_t>(mProperties[i].size()));
-		writer.WriteU16String(Binary::ToUTF16(mProperties[i]));
+		writer.WriteInt32(static_cast<uint32_t>(propertyKeys[i].size()));
+		writer.WriteU16String(Binary::ToUTF16(propertyKeys[i]));
 		writer.WriteInt32(0); // skip 4 bytes
 	}
 
@@ -174,6 +241,14 @@ void PCKFile::Write(const std::string& outpath, Binary::Endianness endianness)
 	uint32_t fileCount = static_cast<uint32_t>(mFiles.size());
 	writer.WriteInt32(fileCount);
 
+	if (progress)
+	{
+		uint64_t totalSize = 0;
+		for (const auto& file : mFiles)
+			totalSize += file.getFileSize();
+		progress->setTotal(totalSize);
+	}
+
 	for (const auto& file : mFiles)
 	{
 		writer.WriteInt32(static_cast<uint32_t>(file.getFileSize()));
@@ -192,16 +267,314 @@ void PCKFile::Write(const std::string& outpath, Binary::Endianness endianness)
 
 		for (const auto& [key, value] : props)
 		{
-			auto it = std::find(mProperties.begin(), mProperties.end(), key);
-			uint32_t index = static_cast<uint32_t>(std::distance(mProperties.begin(), it));
+			auto it = std::find(propertyKeys.begin(), propertyKeys.end(), key);
+			uint32_t index = static_cast<uint32_t>(std::distance(propertyKeys.begin(), it));
 			writer.WriteInt32(index);
 			writer.WriteInt32(static_cast<uint32_t>(value.size()));
 			writer.WriteU16String(value);
 			writer.WriteInt32(0); // skip 4 bytes
 		}
 
-		writer.WriteData(file.getData().data(), file.getFileSize());
+		if (progress)
+		{
+			progress->setStatus(file.getPath());
+			const unsigned char* data = file.getData();
+			for (size_t offset = 0; offset < file.getFileSize(); offset += PROGRESS_CHUNK_SIZE)
+			{
+				progress->throwIfCancelled();
+				size_t chunkSize = std::min(PROGRESS_CHUNK_SIZE, file.getFileSize() - offset);
+				writer.WriteData(data + offset, chunkSize);
+				progress->advance(chunkSize);
+			}
+		}
+		else
+			writer.WriteData(file.getData(), file.getFileSize());
+	}
+}
+
+void PCKFile::updateNestedFiles()
+{
+	for (auto& file : mFiles)
+		file.updateNestedData();
+}
+
+uint32_t PCKFile::getRevision() const
+{
+	uint32_t revision = mRevision;
+
+	for (const auto& file : mFiles)
+	{
+		revision = std::max(revision, file.getRevision());
+
+		if (const PCKFile* nested = file.getLoadedNestedPCK())
+			revision = std::max(revision, nested->getRevision());
+	}
+
+	return revision;
+}
+
+Binary::Endianness PCKFile::ReadEndianness(const std::string& inpath)
+{
+	BinaryReader reader(inpath);
+
+	uint32_t version;
+	reader.ReadData(&version, 4);
+
+	uint32_t detectedVersion;
+	return DetectEndianness(version, detectedVersion);
+}
+
+Binary::Endianness PCKFile::ConvertEndianness(const std::string& inpath, const std::string& outpath, Binary::Endianness endianness, JobProgress* progress)
+{
+	TRACE_SCOPE("PCKFile::ConvertEndianness");
+
+	BinaryReader reader(inpath);
+
+	uint32_t version;
+	reader.ReadData(&version, 4);
+
+	uint32_t detectedVersion;
+	Binary::Endianness sourceEndianness = DetectEndianness(version, detectedVersion);
+	reader.SetEndianness(sourceEndianness);
+
+	BinaryWriter writer(outpath);
+	writer.SetEndianness(endianness);
+	writer.WriteInt32(detectedVersion);
+
+	// every field is read in the source endianness and written straight back out in the new one, so unused fields survive as they were
+	auto copyInt32 = [&]() {
+		uint32_t value = reader.ReadInt32();
+		writer.WriteInt32(value);
+		return value;
+	};
+
+	auto copyU16String = [&]() {
+		uint32_t length = copyInt32();
+		writer.WriteU16String(reader.ReadU16String(length));
+	};
+
+	uint32_t propertyCount = copyInt32();
+	bool xmlSupport = false;
+
+	for (uint32_t i{ 0 }; i < propertyCount; i++)
+	{
+		copyInt32(); // index
+
+		uint32_t length = copyInt32();
+		std::u16string property = reader.ReadU16String(length);
+		writer.WriteU16String(property);
+
+		if (Binary::ToUTF8(property) == XML_VERSION_STRING)
+			xmlSupport = true;
+
+		copyInt32(); // skip 4 bytes
+	}
+
+	if (xmlSupport)
+		copyInt32(); // XML version
+
+	uint32_t fileCount = copyInt32();
+
+	// only the sizes are kept around, everything else is already written out
+	std::vector<uint32_t> fileSizes;
+	fileSizes.reserve(fileCount);
+
+	uint64_t totalSize = 0;
+	for (uint32_t i{ 0 }; i < fileCount; i++)
+	{
+		uint32_t fileSize = copyInt32();
+		copyInt32(); // type
+		copyU16String(); // path
+		copyInt32(); // skip 4 bytes
+
+		fileSizes.push_back(fileSize);
+		totalSize += fileSize;
+	}
+
+	if (progress)
+		progress->setTotal(totalSize);
+
+	std::vector<unsigned char> buffer(std::min<uint64_t>(PROGRESS_CHUNK_SIZE, totalSize));
+
+	for (uint32_t i{ 0 }; i < fileCount; i++)
+	{
+		uint32_t filePropertyCount = copyInt32();
+
+		for (uint32_t j{ 0 }; j < filePropertyCount; j++)
+		{
+			copyInt32(); // index
+			copyU16String(); // value
+			copyInt32(); // skip 4 bytes
+		}
+
+		// file data has no byte order of its own, so it goes through untouched
+		for (uint64_t offset = 0; offset < fileSizes[i]; offset += buffer.size())
+		{
+			if (progress)
+				progress->throwIfCancelled();
+
+			size_t chunkSize = (size_t)std::min<uint64_t>(buffer.size(), fileSizes[i] - offset);
+			reader.ReadData(buffer.data(), chunkSize);
+			writer.WriteData(buffer.data(), chunkSize);
+
+			if (progress)
+				progress->advance(chunkSize);
+		}
+	}
+
+	return sourceEndianness;
+}
+
+std::vector<PCKFile::IndexEntry> PCKFile::ReadIndex(const std::string& inpath, JobProgress* progress, unsigned int threadCount)
+{
+	TRACE_SCOPE("PCKFile::ReadIndex");
+
+	// one batch is read while the other is hashed; declared before the pool, so its workers are done with them before they go
+	struct Batch
+	{
+		std::vector<unsigned char> data{};
+		std::vector<std::pair<size_t, size_t>> files{}; // index into the file list, then offset into the data
+		std::vector<std::future<void>> hashing{};
+	};
+
+	std::vector<IndexEntry> files;
+	Batch batches[2];
+	size_t current = 0;
+	ThreadPool pool(threadCount);
+
+	auto finishHashing = [](Batch& batch) {
+		for (auto& future : batch.hashing)
+			future.get();
+		batch.hashing.clear();
+		batch.files.clear();
+		batch.data.clear();
+	};
+
+	auto startHashing = [&]() {
+		Batch& batch = batches[current];
+		for (const auto& [index, offset] : batch.files)
+		{
+			batch.hashing.push_back(pool.Submit([&files, data = batch.data.data(), index = index, offset = offset] {
+				files[index].hash = Hash::XXH64(data + offset, static_cast<size_t>(files[index].size));
+				}));
+		}
+
+		current ^= 1;
+		finishHashing(batches[current]);
+	};
+
+	BinaryReader reader(inpath);
+
+	uint32_t version;
+	reader.ReadData(&version, 4);
+
+	uint32_t detectedVersion;
+	reader.SetEndianness(DetectEndianness(version, detectedVersion));
+
+	uint32_t propertyCount = reader.ReadInt32();
+	std::vector<std::string> keys;
+	keys.reserve(propertyCount);
+
+	for (uint32_t i{ 0 }; i < propertyCount; i++)
+	{
+		reader.ReadInt32(); // index
+		uint32_t length = reader.ReadInt32();
+		keys.push_back(Binary::ToUTF8(reader.ReadU16String(length)));
+		reader.ReadInt32(); // skip 4 bytes
+	}
+
+	if (std::find(keys.begin(), keys.end(), XML_VERSION_STRING) != keys.end())
+		reader.ReadInt32(); // XML version
+
+	uint32_t fileCount = reader.ReadInt32();
+	uint64_t totalSize = 0;
+
+	for (uint32_t i{ 0 }; i < fileCount; i++)
+	{
+		IndexEntry entry;
+		entry.size = reader.ReadInt32();
+		entry.type = PCKAssetFile::Type(reader.ReadInt32());
+
+		uint32_t pathLength = reader.ReadInt32();
+		entry.path = Binary::ToUTF8(reader.ReadU16String(pathLength));
+		std::replace(entry.path.begin(), entry.path.end(), '\\', '/');
+
+		reader.ReadInt32(); // skip 4 bytes
+
+		totalSize += entry.size;
+		files.push_back(std::move(entry));
+	}
+
+	if (progress)
+		progress->setTotal(totalSize);
+
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		IndexEntry& entry = files[i];
+		uint32_t filePropertyCount = reader.ReadInt32();
+
+		for (uint32_t j{ 0 }; j < filePropertyCount; j++)
+		{
+			uint32_t propertyIndex = reader.ReadInt32();
+			if (propertyIndex >= keys.size())
+				throw std::runtime_error("Property index out of range");
+
+			uint32_t length = reader.ReadInt32();
+			entry.properties.emplace_back(keys[propertyIndex], reader.ReadU16String(length));
+			reader.ReadInt32(); // skip 4 bytes
+		}
+
+		if (progress)
+		{
+			progress->throwIfCancelled();
+			progress->setStatus(entry.path);
+		}
+
+		if (!batches[current].files.empty() && batches[current].data.size() + entry.size > INDEX_BATCH_SIZE)
+			startHashing();
+
+		Batch& batch = batches[current];
+		size_t offset = batch.data.size();
+		batch.data.resize(offset + static_cast<size_t>(entry.size));
+		reader.ReadData(batch.data.data() + offset, static_cast<size_t>(entry.size));
+		batch.files.push_back({ i, offset });
+
+		if (progress)
+			progress->advance(entry.size);
+	}
+
+	// startHashing already waited on the batch before this one, so only the last one is left
+	startHashing();
+	finishHashing(batches[current ^ 1]);
+
+	return files;
+}
+
+std::vector<PCKFile::IndexEntry> PCKFile::getIndex(unsigned int threadCount) const
+{
+	TRACE_SCOPE("PCKFile::getIndex");
+
+	std::vector<IndexEntry> files(mFiles.size());
+	for (size_t i = 0; i < mFiles.size(); ++i)
+	{
+		files[i].path = mFiles[i].getPath();
+		files[i].type = mFiles[i].getAssetType();
+		files[i].size = mFiles[i].getFileSize();
+		files[i].properties = mFiles[i].getProperties();
+	}
+
+	std::atomic<size_t> next{ 0 };
+	ThreadPool pool(threadCount);
+	for (size_t worker = 0; worker < pool.getThreadCount(); ++worker)
+	{
+		pool.Submit([&] {
+			for (size_t i = next++; i < mFiles.size(); i = next++)
+				files[i].hash = Hash::XXH64(mFiles[i].getData(), mFiles[i].getFileSize());
+			});
 	}
+	pool.Wait();
+
+	return files;
 }
 
 void PCKFile::addFileFromDisk(const std::string& filepath, std::string new_filepath, PCKAssetFile::Type fileType)
@@ -228,6 +601,18 @@ void PCKFile::addFile(const PCKAssetFile* file)
 {
 	// emplace just sounds cooler, okay??
 	mFiles.emplace_back(*file);
+	mRevision = PCKAssetFile::NextRevision();
+}
+
+void PCKFile::addFiles(std::vector<PCKAssetFile>&& files)
+{
+	mFiles.reserve(mFiles.size() + files.size());
+
+	for (PCKAssetFile& file : files)
+		mFiles.push_back(std::move(file));
+
+	files.clear();
+	mRevision = PCKAssetFile::NextRevision();
 }
 
 void PCKFile::deleteFile(const PCKAssetFile* file)
@@ -241,6 +626,7 @@ void PCKFile::deleteFile(const PCKAssetFile* file)
 
 	if (it != mFiles.end()) {
 		mFiles.erase(it, mFiles.end());
+		mRevision = PCKAssetFile::NextRevision();
 		return;
 	}
 
@@ -250,6 +636,7 @@ void PCKFile::deleteFile(const PCKAssetFile* file)
 void PCKFile::clearFiles()
 {
 	mFiles.clear();
+	mRevision = PCKAssetFile::NextRevision();
 }
 
 int PCKFile::getFileIndex(const PCKAssetFile* file) const
@@ -263,6 +650,32 @@ int PCKFile::getFileIndex(const PCKAssetFile* file) const
 	return -1;
 }
 
+void PCKFile::reorderFiles(const std::vector<const PCKAssetFile*>& order)
+{
+	// nothing to move if the order is the same, which it usually is
+	if (order.size() == mFiles.size() && std::equal(order.begin(), order.end(), mFiles.begin(),
+		[](const PCKAssetFile* a, const PCKAssetFile& b) { return a == &b; }))
+		return;
+
+	std::vector<PCKAssetFile> files;
+	files.reserve(order.size());
+
+	for (const PCKAssetFile* file : order)
+	{
+		// the pointers come from this file's own list, so the index is just the offset
+		if (!file || file < mFiles.data() || file >= mFiles.data() + mFiles.size())
+			continue;
+
+		files.push_back(std::move(mFiles[file - mFiles.data()]));
+	}
+
+	// moved back into the same storage, since the UI can still hold pointers into it until its tree is rebuilt
+	for (size_t i = 0; i < files.size(); ++i)
+		mFiles[i] = std::move(files[i]);
+	mFiles.resize(files.size(), PCKAssetFile("", PCKAssetFile::Type::TEXTURE));
+	mRevision = PCKAssetFile::NextRevision();
+}
+
 void PCKFile::moveFileToIndex(const PCKAssetFile* file, size_t newIndex)
 {
 	if (!file || newIndex >= mFiles.size())
@@ -280,6 +693,7 @@ void PCKFile::moveFileToIndex(const PCKAssetFile* file, size_t newIndex)
 
 	auto insertIt = mFiles.begin() + newIndex;
 	mFiles.insert(insertIt, std::move(temp));
+	mRevision = PCKAssetFile::NextRevision();
 }
 
 uint32_t PCKFile::getPCKVersion() const
@@ -287,6 +701,12 @@ uint32_t PCKFile::getPCKVersion() const
 	return mVersion;
 }
 
+void PCKFile::setPCKVersion(uint32_t version)
+{
+	mVersion = version;
+	mRevision = PCKAssetFile::NextRevision();
+}
+
 Binary::Endianness PCKFile::getEndianness() const
 {
 	return mEndianess;
@@ -302,6 +722,11 @@ const std::vector<PCKAssetFile>& PCKFile::getFiles() const
 	return mFiles;
 }
 
+std::vector<PCKAssetFile>& PCKFile::getFiles()
+{
+	return mFiles;
+}
+
 bool PCKFile::getXMLSupport() const
 {
 	return mXMLSupport;
@@ -310,6 +735,7 @@ bool PCKFile::getXMLSupport() const
 void PCKFile::setXMLSupport(bool value)
 {
 	mXMLSupport = value;
+	mRevision = PCKAssetFile::NextRevision();
 }
 
 PCKFile::~PCKFile()
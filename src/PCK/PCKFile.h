@@ -3,24 +3,69 @@
 #include <filesystem>
 #include "Binary/Binary.h"
 #include "PCK/PCKAssetFile.h"
+#include "Util/JobProgress.h"
+
+class BinaryReader;
+class BinaryWriter;
 
 // PCK File research done by Jam1Garner, Nobledez, NessieHax/Miku666/nullptr, myself (May/MattNL), and many others over the years.
 
 class PCKFile
 {
 public:
+	// A file as a PCK File lists it, with a hash of its data in place of the data
+	struct IndexEntry
+	{
+		std::string path{};
+		PCKAssetFile::Type type{ PCKAssetFile::Type::SKIN };
+		uint64_t size{ 0 };
+		uint64_t hash{ 0 };
+		std::vector<PCKAssetFile::Property> properties{};
+	};
+
 	PCKFile() = default;
 	~PCKFile();
 
-	// Reads data into the PCK File from string; will add memory variant soon
-	void Read(const std::string& inpath);
+	// Reads data into the PCK File from string; will add memory variant soon. Reports progress in file data bytes and can be cancelled, if given progress
+	void Read(const std::string& inpath, JobProgress* progress = nullptr);
+
+	// Reads data into the PCK File from memory, copying the file data out of it
+	void Read(const unsigned char* data, size_t size, JobProgress* progress = nullptr);
+
+	// Reads data into the PCK File from part of a shared buffer, like the payload of the PCK File it's nested in; the files point into the buffer instead of copying their data out
+	void Read(std::shared_ptr<const std::vector<unsigned char>> buffer, size_t offset, size_t size);
+
+	// Writes PCK File to a specifed location. Reports progress in file data bytes and can be cancelled, if given progress
+	void Write(const std::string& outpath, Binary::Endianness endianness, JobProgress* progress = nullptr);
+
+	// Writes PCK File to the end of a buffer
+	void Write(std::vector<unsigned char>& out, Binary::Endianness endianness, JobProgress* progress = nullptr);
+
+	// Writes every nested PCK File that changed back into the data of the file it's nested in; done by Write already, but needed before the data is used anywhere else
+	void updateNestedFiles();
+
+	// Gets the newest revision of anything in the PCK File, including its files and any nested PCK Files that were read; changes whenever anything in it does
+	uint32_t getRevision() const;
 
-	// Writes PCK File to a specifed location
-	void Write(const std::string& outpath, Binary::Endianness endianness);
+	// Rewrites a PCK File on disk in another endianness without loading it; only the header and property tables are re-encoded, file data is copied through in fixed size chunks. Returns the source endianness
+	static Binary::Endianness ConvertEndianness(const std::string& inpath, const std::string& outpath, Binary::Endianness endianness, JobProgress* progress = nullptr);
+
+	// Reads just the endianness of a PCK File on disk
+	static Binary::Endianness ReadEndianness(const std::string& inpath);
+
+	// Reads the file list of a PCK File on disk without loading it; file data is read in batches that are hashed on a thread pool while the next one is read, then dropped.
+	// Reports progress in file data bytes and can be cancelled, if given progress. 0 threads uses one per hardware thread
+	static std::vector<IndexEntry> ReadIndex(const std::string& inpath, JobProgress* progress = nullptr, unsigned int threadCount = 0);
+
+	// Lists the files of the PCK File the same way ReadIndex does, hashing their data on a thread pool; nested PCK Files that changed need updateNestedFiles first to be hashed as they are now
+	std::vector<IndexEntry> getIndex(unsigned int threadCount = 0) const;
 
 	// Reads PCK Format/Version and sets Endianness
 	uint32_t getPCKVersion() const;
 
+	// Sets the PCK Format/Version written out; 0-3, and 3 for anything new since 0 is read back as Big Endian either way
+	void setPCKVersion(uint32_t version);
+
 	// Gets PCK File Endianness; Little Endian: Xbox One, PS4, PSVita, Nintendo Switch; Big Endian: Xbox 360, PS3, Wii U
 	Binary::Endianness getEndianness() const;
 
@@ -30,9 +75,15 @@ public:
 	// Gets Files from the PCK File
 	const std::vector<PCKAssetFile>& getFiles() const;
 
+	// Gets Files from the PCK File to change them in place; the list itself is only changed through the PCK File, so its revision keeps up
+	std::vector<PCKAssetFile>& getFiles();
+
 	// Adds PCKAssetFile to the PCK file
 	void addFile(const PCKAssetFile* file);
 
+	// Moves many PCKAssetFiles into the PCK file at once, reserving storage for all of them first
+	void addFiles(std::vector<PCKAssetFile>&& files);
+
 	// Adds PCKAssetFile to the PCK file from disk
 	void addFileFromDisk(const std::string& filepath, std::string new_filepath, PCKAssetFile::Type fileType = PCKAssetFile::Type::TEXTURE);
 
@@ -45,6 +96,9 @@ public:
 	// Gets the index of a given file
 	int getFileIndex(const PCKAssetFile* file) const;
 
+	// Rebuilds the file list in the given order by moving the files; files that aren't listed are removed
+	void reorderFiles(const std::vector<const PCKAssetFile*>& order);
+
 	// Moves a given file to a given index
 	void moveFileToIndex(const PCKAssetFile* file, size_t newIndex);
 
@@ -64,9 +118,14 @@ public:
 	void setFilePath(const std::string& pathin);
 
 private:
+	// Reads and writes the actual PCK data, wherever it comes from or goes; file data is pointed into the source buffer instead of read, if given one
+	void Read(BinaryReader& reader, JobProgress* progress, const std::shared_ptr<const std::vector<unsigned char>>& source = nullptr, size_t sourceOffset = 0);
+	void Write(BinaryWriter& writer, Binary::Endianness endianness, JobProgress* progress);
+
 	Binary::Endianness mEndianess{ Binary::Endianness::LITTLE };
 	bool mXMLSupport{false};
 	uint32_t mVersion{};
+	uint32_t mRevision{ 0 }; // only bumped by changes to the file list itself, the files have their own
 	std::vector<std::string> mProperties{};
 	std::vector<PCKAssetFile> mFiles{};
 	std::filesystem::path mFilePath{};
@@ -0,0 +1,94 @@
+#include "PCK/PCKFileTree.h"
+#include "Util/Trace.h"
+
+std::vector<FileTreeNode> BuildFileTree(const PCKFile& pckFile, const std::string& packPath)
+{
+	TRACE_SCOPE("BuildFileTree");
+
+	PCKFile* pack = const_cast<PCKFile*>(&pckFile);
+	FileTreeNode root;
+	auto& files = pckFile.getFiles();
+
+	for (const auto& file : files) {
+		std::string fullPath = file.getPath();
+		size_t slashPos = fullPath.find_last_of("/\\");
+		std::string folderName = (slashPos != std::string::npos) ? fullPath.substr(0, slashPos) : "";
+
+		std::vector<std::string> parts;
+		size_t start = 0;
+		while (true) {
+			size_t pos = folderName.find_first_of("/\\", start);
+			if (pos == std::string::npos) {
+				parts.push_back(folderName.substr(start));
+				break;
+			}
+			parts.push_back(folderName.substr(start, pos - start));
+			start = pos + 1;
+		}
+
+		FileTreeNode* current = &root;
+		std::filesystem::path currentPath = root.path;
+
+		for (const auto& part : parts) {
+			if (part.empty()) continue;
+
+			currentPath /= part;
+
+			std::string normalizedCurrent = currentPath.string();
+			std::replace(normalizedCurrent.begin(), normalizedCurrent.end(), '\\', '/');
+
+			normalizedCurrent = packPath + normalizedCurrent;
+
+			auto it = std::find_if(current->children.begin(), current->children.end(), [&](const FileTreeNode& n) {
+				return !n.file && n.path == normalizedCurrent;
+				});
+
+			if (it == current->children.end()) {
+				current->children.push_back(FileTreeNode{ normalizedCurrent, nullptr, {}, pack, packPath });
+				current = &current->children.back();
+			}
+			else {
+				current = &(*it);
+			}
+		}
+
+		std::string nodePath = packPath + std::filesystem::path(file.getPath()).string();
+		current->children.push_back(FileTreeNode{ nodePath, const_cast<PCKAssetFile*>(&file), {}, pack, packPath });
+
+		if (const PCKFile* nested = file.getLoadedNestedPCK())
+			current->children.back().children = BuildFileTree(*nested, nodePath + "/");
+	}
+
+	SortTree(root);
+	return std::move(root.children);
+}
+
+std::string GetPathInPack(const FileTreeNode& node)
+{
+	return node.path.substr(std::min(node.packPath.size(), node.path.size()));
+}
+
+FileTreeNode* FindNodeByPath(const std::string& path, std::vector<FileTreeNode>& nodes)
+{
+	for (auto& node : nodes)
+	{
+		if (node.path == path)
+			return &node;
+
+		if (FileTreeNode* found = FindNodeByPath(path, node.children))
+			return found;
+	}
+	return nullptr;
+}
+
+void SortTree(FileTreeNode& node) {
+	std::stable_sort(node.children.begin(), node.children.end(), [](const FileTreeNode& a, const FileTreeNode& b) {
+		if (!a.file && b.file) return true;
+		if (a.file && !b.file) return false;
+		if (!a.file && !b.file) return a.path < b.path;
+		return false;
+		});
+	for (auto& child : node.children)
+		if (!child.file)
+			SortTree(child);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "PCK/PCKFile.h"
+
+// A folder or file of a PCK File, as shown in the file tree; folders have no file, and files only have children when they're a nested PCK File that was read
+struct FileTreeNode {
+    std::string path{};
+    PCKAssetFile* file{ nullptr };
+    std::vector<FileTreeNode> children;
+    PCKFile* pack{ nullptr }; // the PCK File the node is in, which isn't the opened one for nested PCK Files
+    std::string packPath{}; // prefix of the node path that isn't part of the file path; the path of the nested PCK File and a slash, if nested
+};
+
+// Builds the folder tree of a PCK File's files; folders come first, in path order, and files keep their order in the PCK. Nested PCK Files that were already read get their own tree under their file
+std::vector<FileTreeNode> BuildFileTree(const PCKFile& pckFile, const std::string& packPath = "");
+
+// Gets the path of a node inside of the PCK File it's in
+std::string GetPathInPack(const FileTreeNode& node);
+
+// Finds a node by path in a given file tree
+FileTreeNode* FindNodeByPath(const std::string& path, std::vector<FileTreeNode>& nodes);
+
+// Sorts a given file tree
+void SortTree(FileTreeNode& node);
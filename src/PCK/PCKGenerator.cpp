@@ -0,0 +1,259 @@
+#include "Formats/BehavioursFile.h"
+#include "Formats/MaterialsFile.h"
+#include "PCK/PCKGenerator.h"
+
+// Tiny, fast and the same on every platform, unlike the standard library's distributions
+class SplitMix64
+{
+public:
+	SplitMix64(uint64_t seed) : mState(seed) {}
+
+	uint64_t Next()
+	{
+		uint64_t z = (mState += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	// Gets a number from min to max, both included
+	size_t Range(size_t min, size_t max)
+	{
+		if (max <= min)
+			return min;
+		return min + static_cast<size_t>(Next() % (static_cast<uint64_t>(max - min) + 1));
+	}
+
+	void Fill(std::vector<unsigned char>& data)
+	{
+		size_t i = 0;
+		for (; i + 8 <= data.size(); i += 8)
+		{
+			uint64_t value = Next();
+			for (int j = 0; j < 8; ++j)
+				data[i + j] = static_cast<unsigned char>(value >> (j * 8));
+		}
+
+		uint64_t value = Next();
+		for (; i < data.size(); ++i, value >>= 8)
+			data[i] = static_cast<unsigned char>(value);
+	}
+
+private:
+	uint64_t mState;
+};
+
+// keys the game actually uses, so generated packs look like real ones before falling back to made up keys
+static const char* KNOWN_PROPERTY_KEYS[] = {
+	"DISPLAYNAME", "DISPLAYNAMEID", "THEMENAME", "THEMENAMEID", "ANIM", "GAME_FLAGS",
+	"FREE", "CAPEPATH", "BOX", "OFFSET", "PACKID", "PACKVERSION"
+};
+
+static std::string GetPropertyKey(size_t index)
+{
+	size_t knownCount = sizeof(KNOWN_PROPERTY_KEYS) / sizeof(KNOWN_PROPERTY_KEYS[0]);
+	if (index < knownCount)
+		return KNOWN_PROPERTY_KEYS[index];
+	return "KEY_" + std::to_string(index - knownCount);
+}
+
+// Makes a value that parses for keys with a format, like ANIM and BOX, and random text for the rest
+static std::u16string GenerateValue(const std::string& key, const PCKGenerator::Options& options, SplitMix64& random)
+{
+	char buffer[128];
+
+	if (key == "ANIM" || key == "GAME_FLAGS")
+	{
+		snprintf(buffer, sizeof(buffer), "0x%x", static_cast<unsigned int>(random.Next() & 0xFFFFF));
+		return Binary::ToUTF16(buffer);
+	}
+
+	if (key == "BOX")
+	{
+		static const char* parts[] = { "HEAD", "BODY", "ARM0", "ARM1", "LEG0", "LEG1" };
+		snprintf(buffer, sizeof(buffer), "%s %d %d %d %d %d %d %d %d 0 0 0", parts[random.Range(0, 5)],
+			(int)random.Range(0, 8) - 4, (int)random.Range(0, 16) - 12, (int)random.Range(0, 8) - 4,
+			(int)random.Range(1, 8), (int)random.Range(1, 8), (int)random.Range(1, 8),
+			(int)random.Range(0, 56), (int)random.Range(0, 56));
+		return Binary::ToUTF16(buffer);
+	}
+
+	if (key == "OFFSET")
+	{
+		static const char* parts[] = { "HEAD", "BODY", "ARM0", "ARM1", "LEG0", "LEG1" };
+		snprintf(buffer, sizeof(buffer), "%s Y %d", parts[random.Range(0, 5)], (int)random.Range(0, 8) - 4);
+		return Binary::ToUTF16(buffer);
+	}
+
+	static const char characters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 ";
+
+	std::u16string value(random.Range(options.minValueLength, options.maxValueLength), u' ');
+	for (char16_t& c : value)
+		c = characters[random.Range(0, sizeof(characters) - 2)];
+	return value;
+}
+
+// Gets a file name that the type would be detected from, numbered when the type can have many
+static std::string GetFileName(PCKAssetFile::Type type, size_t index)
+{
+	char buffer[64];
+
+	switch (type)
+	{
+	case PCKAssetFile::Type::SKIN: snprintf(buffer, sizeof(buffer), "dlcskin%08zu.png", index); return buffer;
+	case PCKAssetFile::Type::CAPE: snprintf(buffer, sizeof(buffer), "dlccape%08zu.png", index); return buffer;
+	case PCKAssetFile::Type::TEXTURE: return "texture" + std::to_string(index) + ".png";
+	case PCKAssetFile::Type::UI_DATA: return "uidata" + std::to_string(index) + ".bin";
+	case PCKAssetFile::Type::INFO: return "0";
+	case PCKAssetFile::Type::TEXTURE_PACK_INFO: return "x" + std::to_string(index) + "Info.pck";
+	case PCKAssetFile::Type::LOCALISATION: return "languages.loc";
+	case PCKAssetFile::Type::GAME_RULES: return "GameRules.grf";
+	case PCKAssetFile::Type::AUDIO_DATA: return "audio.pck";
+	case PCKAssetFile::Type::COLOUR_TABLE: return "colours.col";
+	case PCKAssetFile::Type::GAME_RULES_HEADER: return "GameRules.grh";
+	case PCKAssetFile::Type::SKIN_DATA: return "skins.pck";
+	case PCKAssetFile::Type::MODELS: return "models.bin";
+	case PCKAssetFile::Type::BEHAVIOURS: return "behaviours.bin";
+	case PCKAssetFile::Type::MATERIALS: return "entityMaterials.bin";
+	default: return "file" + std::to_string(index);
+	}
+}
+
+// Whether files of the type only have one name, so each one needs a folder of its own to keep paths unique
+static bool HasFixedName(PCKAssetFile::Type type)
+{
+	std::string name = GetFileName(type, 0);
+	return name == GetFileName(type, 1);
+}
+
+static bool IsPackType(PCKAssetFile::Type type)
+{
+	return type == PCKAssetFile::Type::SKIN_DATA || type == PCKAssetFile::Type::AUDIO_DATA || type == PCKAssetFile::Type::TEXTURE_PACK_INFO;
+}
+
+// entities the game has materials and behaviours for, so generated ones look like real ones
+static const char* ENTITY_NAMES[] = {
+	"creeper", "zombie", "skeleton", "spider", "pig", "cow", "sheep", "chicken", "horse", "donkey",
+	"mule", "wolf", "ocelot", "enderman", "blaze", "ghast", "slime", "llama", "strider", "boat"
+};
+
+// Makes entityMaterials.bin and behaviours.bin payloads that parse, so their editors and round trips can be tested; everything else is random bytes
+static bool GenerateTypedPayload(PCKAssetFile::Type type, SplitMix64& random, std::vector<unsigned char>& data)
+{
+	const size_t entityCount = sizeof(ENTITY_NAMES) / sizeof(ENTITY_NAMES[0]);
+
+	if (type == PCKAssetFile::Type::MATERIALS)
+	{
+		const auto& types = MaterialsFile::getKnownTypes();
+
+		MaterialsFile materials;
+		size_t count = random.Range(1, entityCount);
+		for (size_t i = 0; i < count; ++i)
+			materials.getMaterials().push_back({ ENTITY_NAMES[i], types[random.Range(0, types.size() - 1)] });
+
+		materials.Write(data);
+		return true;
+	}
+
+	if (type == PCKAssetFile::Type::BEHAVIOURS)
+	{
+		BehavioursFile behaviours;
+		size_t count = random.Range(1, entityCount);
+		for (size_t i = 0; i < count; ++i)
+		{
+			BehavioursFile::Behaviour& behaviour = behaviours.getBehaviours().emplace_back();
+			behaviour.name = ENTITY_NAMES[i];
+
+			size_t overrideCount = random.Range(1, 4);
+			for (size_t j = 0; j < overrideCount; ++j)
+			{
+				// any byte but 0 is set, and the games aren't known to only write 1, so other values have to survive a round trip too
+				uint8_t tamed = (j & 1) != 0 ? static_cast<uint8_t>(random.Range(1, 255)) : 0;
+				uint8_t saddled = (j & 2) != 0 ? static_cast<uint8_t>(random.Range(1, 255)) : 0;
+				behaviour.overrides.push_back({ tamed, saddled,
+					((int)random.Range(0, 64) - 32) / 16.0f, ((int)random.Range(0, 64) - 32) / 16.0f, ((int)random.Range(0, 64) - 32) / 16.0f });
+			}
+		}
+
+		behaviours.Write(data);
+		return true;
+	}
+
+	return false;
+}
+
+static PCKAssetFile GenerateFile(const PCKGenerator::Options& options, PCKAssetFile::Type type, size_t index, SplitMix64& random)
+{
+	std::string path;
+	size_t depth = random.Range(0, options.folderDepth);
+	for (size_t level = 0; level < depth; ++level)
+		path += "folder" + std::to_string(random.Range(0, std::max<size_t>(options.folderFanOut, 1) - 1)) + "/";
+
+	if (HasFixedName(type))
+		path += "asset" + std::to_string(index) + "/";
+	path += GetFileName(type, index);
+
+	std::vector<unsigned char> data;
+	if (IsPackType(type))
+	{
+		// a smaller pack of the same kind, without packs of its own
+		PCKGenerator::Options nestedOptions = options;
+		nestedOptions.seed = random.Next();
+		nestedOptions.fileCount = options.nestedFileCount;
+		nestedOptions.nestedPackCount = 0;
+		nestedOptions.xmlSupport = type == PCKAssetFile::Type::SKIN_DATA && options.xmlSupport;
+
+		PCKFile nested;
+		PCKGenerator::Generate(nestedOptions, nested);
+		nested.Write(data, options.endianness);
+	}
+	else if (!GenerateTypedPayload(type, random, data))
+	{
+		data.resize(random.Range(options.minPayloadSize, options.maxPayloadSize));
+		random.Fill(data);
+	}
+
+	PCKAssetFile file(path, std::move(data), type);
+
+	size_t propertyCount = random.Range(options.minPropertiesPerFile, options.maxPropertiesPerFile);
+	for (size_t i = 0; i < propertyCount && options.propertyKeyCount > 0; ++i)
+	{
+		std::string key = GetPropertyKey(random.Range(0, options.propertyKeyCount - 1));
+		file.addProperty(key, GenerateValue(key, options, random));
+	}
+
+	return file;
+}
+
+void PCKGenerator::Generate(const Options& options, PCKFile& pckFile)
+{
+	SplitMix64 random(options.seed);
+
+	static const PCKAssetFile::Type packTypes[] = {
+		PCKAssetFile::Type::SKIN_DATA, PCKAssetFile::Type::AUDIO_DATA, PCKAssetFile::Type::TEXTURE_PACK_INFO
+	};
+
+	std::vector<PCKAssetFile::Type> fileTypes;
+	for (int type = 0; type < (int)PCKAssetFile::Type::PCK_ASSET_TYPES_TOTAL; ++type)
+	{
+		if (!IsPackType(PCKAssetFile::Type(type)))
+			fileTypes.push_back(PCKAssetFile::Type(type));
+	}
+
+	std::vector<PCKAssetFile> files;
+	files.reserve(options.fileCount + options.nestedPackCount);
+
+	for (size_t i = 0; i < options.fileCount; ++i)
+	{
+		PCKAssetFile::Type type = options.allTypes ? fileTypes[i % fileTypes.size()] : PCKAssetFile::Type::TEXTURE;
+		files.push_back(GenerateFile(options, type, i, random));
+	}
+
+	for (size_t i = 0; i < options.nestedPackCount; ++i)
+		files.push_back(GenerateFile(options, packTypes[i % 3], options.fileCount + i, random));
+
+	pckFile.clearFiles();
+	pckFile.setPCKVersion(options.version);
+	pckFile.setXMLSupport(options.xmlSupport);
+	pckFile.addFiles(std::move(files));
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include "PCK/PCKFile.h"
+
+// Makes up valid PCK Files of any shape and size, for benchmarks and stress tests; the same options always make the same files
+class PCKGenerator
+{
+public:
+	// The shape of a generated pack; every random choice comes from the seed
+	struct Options
+	{
+		uint64_t seed{ 1 };
+		size_t fileCount{ 1000 };
+		// files go 0 to folderDepth folders deep, picking one of folderFanOut folders on every level
+		size_t folderDepth{ 3 };
+		size_t folderFanOut{ 8 };
+		// how many different property keys are used across the pack; the well known ones come first
+		size_t propertyKeyCount{ 16 };
+		size_t minPropertiesPerFile{ 0 };
+		size_t maxPropertiesPerFile{ 4 };
+		size_t minValueLength{ 4 };
+		size_t maxValueLength{ 32 };
+		size_t minPayloadSize{ 256 };
+		size_t maxPayloadSize{ 4096 };
+		// every asset type but the nested pack ones, taking turns; otherwise only textures
+		bool allTypes{ true };
+		// skins.pck, audio.pck and texture pack info entries holding generated PCK Files of their own, on top of fileCount
+		size_t nestedPackCount{ 3 };
+		size_t nestedFileCount{ 16 };
+		bool xmlSupport{ false };
+		uint32_t version{ 3 };
+		// nested packs are written in this endianness; it's also what the outer pack is meant to be written in
+		Binary::Endianness endianness{ Binary::Endianness::LITTLE };
+	};
+
+	// Fills a PCK File with generated files, replacing whatever it had
+	static void Generate(const Options& options, PCKFile& pckFile);
+};
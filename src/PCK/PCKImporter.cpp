@@ -0,0 +1,154 @@
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include "PCK/PCKImporter.h"
+#include "Util/ThreadPool.h"
+#include "Util/Trace.h"
+
+// more readers than this just fight over the disk
+static const unsigned int MAX_IMPORT_THREADS = 8;
+
+std::vector<PCKImporter::Entry> PCKImporter::CollectDirectory(const std::filesystem::path& directory, const std::string& baseFolder)
+{
+	std::string base = baseFolder.empty() ? directory.filename().u8string() : baseFolder;
+	if (base.empty())
+		base = directory.parent_path().filename().u8string(); // for paths ending with a slash
+
+	std::vector<Entry> entries;
+	for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(directory))
+	{
+		if (!dirEntry.is_regular_file())
+			continue;
+
+		std::string relativePath = std::filesystem::relative(dirEntry.path(), directory).generic_u8string();
+		entries.push_back({ dirEntry.path(), base + "/" + relativePath, PCKAssetFile::getPreferredAssetType(dirEntry.path().string()) });
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.pckPath < b.pckPath; });
+	return entries;
+}
+
+PCKImporter::Result PCKImporter::Read(const std::vector<Entry>& entries, JobProgress* progress, unsigned int threadCount)
+{
+	TRACE_SCOPE("PCKImporter::Read");
+
+	Result result;
+	auto startTime = std::chrono::steady_clock::now();
+
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::min(std::thread::hardware_concurrency(), MAX_IMPORT_THREADS));
+	threadCount = std::max(1u, std::min<unsigned int>(threadCount, static_cast<unsigned int>(entries.size())));
+
+	// every reader fills its own slot, so nothing is locked or reordered while reading
+	std::vector<std::optional<std::vector<unsigned char>>> payloads(entries.size());
+	std::vector<int> openErrors(entries.size(), 0); // errno of Files that wouldn't open, put into words once the readers are done
+	std::mutex errorMutex;
+	std::atomic<size_t> nextEntry{ 0 };
+	std::atomic<uint64_t> bytesRead{ 0 };
+
+	auto addError = [&](const std::filesystem::path& path, const std::string& message) {
+		std::lock_guard<std::mutex> lock(errorMutex);
+		result.errors.push_back({ path, message });
+	};
+
+	// sizes first, so progress has a total before the first byte is read
+	if (progress)
+	{
+		uint64_t totalSize = 0;
+		for (const Entry& entry : entries)
+		{
+			std::error_code error;
+			uintmax_t size = std::filesystem::file_size(entry.diskPath, error);
+			if (!error)
+				totalSize += size;
+		}
+		progress->setTotal(totalSize);
+	}
+
+	auto reader = [&]() {
+		for (size_t i = nextEntry++; i < entries.size(); i = nextEntry++)
+		{
+			if (progress && progress->isCancelled())
+				return;
+
+			const Entry& entry = entries[i];
+			if (progress)
+				progress->setStatus(entry.pckPath);
+
+			std::vector<unsigned char> data;
+			try
+			{
+				std::ifstream in(entry.diskPath, std::ios::binary | std::ios::ate);
+				if (!in)
+				{
+					openErrors[i] = errno != 0 ? errno : ENOENT;
+					continue;
+				}
+
+				std::streamsize size = in.tellg();
+				in.seekg(0, std::ios::beg);
+				if (size < 0)
+				{
+					addError(entry.diskPath, "Failed to get file size");
+					continue;
+				}
+
+				data.resize(static_cast<size_t>(size));
+				if (size > 0 && !in.read(reinterpret_cast<char*>(data.data()), size))
+				{
+					addError(entry.diskPath, "Failed to read file");
+					continue;
+				}
+			}
+			catch (const std::exception& e)
+			{
+				// one File too big to hold shouldn't take the rest of the import down with it
+				addError(entry.diskPath, e.what());
+				continue;
+			}
+
+			bytesRead += data.size();
+			if (progress)
+				progress->advance(data.size());
+
+			payloads[i] = std::move(data);
+		}
+	};
+
+	if (threadCount == 1)
+		reader();
+	else
+	{
+		ThreadPool pool(threadCount);
+		for (unsigned int i = 0; i < threadCount; ++i)
+			pool.Submit(reader);
+		pool.Wait();
+	}
+
+	result.cancelled = progress && progress->isCancelled();
+
+	// strerror isn't safe to call from the readers, but it is here
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		if (openErrors[i] != 0)
+			result.errors.push_back({ entries[i].diskPath, std::strerror(openErrors[i]) });
+	}
+
+	// storage reserved once, and every payload moved in rather than copied
+	result.files.reserve(entries.size());
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		if (payloads[i])
+			result.files.emplace_back(entries[i].pckPath, std::move(*payloads[i]), entries[i].type);
+	}
+
+	result.bytesRead = bytesRead;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::sort(result.errors.begin(), result.errors.end(), [](const Error& a, const Error& b) { return a.diskPath < b.diskPath; });
+
+	return result;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "PCK/PCKAssetFile.h"
+#include "Util/JobProgress.h"
+
+// Reads many files from disk at once, for importing whole folders into a pack
+class PCKImporter
+{
+public:
+	// A file on disk, and where it goes in the pack
+	struct Entry
+	{
+		std::filesystem::path diskPath{};
+		std::string pckPath{};
+		PCKAssetFile::Type type{ PCKAssetFile::Type::TEXTURE };
+	};
+
+	// A file that couldn't be read, and why
+	struct Error
+	{
+		std::filesystem::path diskPath{};
+		std::string message{};
+	};
+
+	// What an import read; files are in the same order as their entries, minus the ones that failed
+	struct Result
+	{
+		std::vector<PCKAssetFile> files{};
+		uint64_t bytesRead{ 0 };
+		double seconds{ 0.0 };
+		bool cancelled{ false };
+		std::vector<Error> errors{};
+	};
+
+	// Gets an entry for every file under a directory, sorted by path; pack paths start with baseFolder, or the directory's name if empty
+	static std::vector<Entry> CollectDirectory(const std::filesystem::path& directory, const std::string& baseFolder = "");
+
+	// Stats and reads files with a bounded pool of readers, straight into buffers that are then moved into the assets.
+	// A file that fails is collected in the result instead of stopping the rest. 0 threads picks one per hardware thread, up to 8
+	static Result Read(const std::vector<Entry>& entries, JobProgress* progress = nullptr, unsigned int threadCount = 0);
+};
@@ -63,6 +63,21 @@ public:
     // Checks if application should close
     virtual bool ShouldClose() const = 0;
 
+    // Asks for a frame to be drawn even without new events, optionally after a delay; without a delay it's safe to call from any thread
+    virtual void RequestRedraw(unsigned int delayMs = 0) = 0;
+
+    // Sets whether to sleep until there's something to draw instead of drawing frames nonstop
+    virtual void SetIdleWait(bool enabled) = 0;
+
+    // Checks whether the application sleeps until there's something to draw
+    virtual bool GetIdleWait() const = 0;
+
+    // Sets the frame rate limit; 0 for none, only vsync
+    virtual void SetFrameRateLimit(int fps) = 0;
+
+    // Gets the frame rate limit; 0 for none
+    virtual int GetFrameRateLimit() const = 0;
+
     // Runs the shutdown/clean up event
     virtual void Shutdown() = 0;
 };
\ No newline at end of file
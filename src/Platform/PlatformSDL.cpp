@@ -2,6 +2,7 @@
 #include <condition_variable>
 #include "Application/Application.h"
 #include "Platform/PlatformSDL.h"
+#include "Util/Log.h"
 
 PlatformSDL::~PlatformSDL() {
 	Shutdown();
@@ -17,7 +18,7 @@ bool PlatformSDL::Init(const char* title, int width, int height) {
 
 	mWindow = SDL_CreateWindow(title, width, height, SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE);
 	if (!mWindow) {
-		std::cerr << "SDL_CreateWindow failed: " << SDL_GetError() << "\n";
+		LOG_ERROR("SDL_CreateWindow failed: %s", SDL_GetError());
 		return false;
 	}
 
@@ -35,10 +36,12 @@ bool PlatformSDL::Init(const char* title, int width, int height) {
 		return false;
 
 	if (SDL_GL_MakeCurrent(mWindow, mGLContext) < 0) {
-		std::cerr << "SDL_GL_MakeCurrent failed: " << SDL_GetError() << "\n";
+		LOG_ERROR("SDL_GL_MakeCurrent failed: %s", SDL_GetError());
 		return false;
 	}
 
+	mWakeEvent = SDL_RegisterEvents(1);
+
 	// Sets the correct icon
 	SDL_Surface* icon = SDL_LoadBMP("assets/icons/ICON_PCKPP.bmp");
 	if (icon) {
@@ -49,24 +52,94 @@ bool PlatformSDL::Init(const char* title, int width, int height) {
 	return !mShouldClose;
 }
 
+// Frames drawn after every event
+static const int REDRAW_FRAMES_AFTER_EVENT = 3;
+
 void PlatformSDL::PollEvents(PlatformBackend* backend) {
+	LimitFrameRate();
+
 	SDL_Event event;
-	while (SDL_PollEvent(&event)) {
-		if (backend)
-			backend->ProcessEvent(&event);
 
-		switch (event.type)
-		{
-			case SDL_EVENT_QUIT:
-				mShouldClose = true;
-				break;
-			case SDL_EVENT_DROP_FILE:
-				gApp->GetUI()->ShowFileDropPopUp(event.drop.data);
-				break;
-			default:
+	// with nothing to draw, sleep until there's an event, a redraw request or a delayed redraw is due
+	if (mIdleWait) {
+		mWaiting = true;
+		while (mPendingFrames == 0 && !mRedrawRequested.exchange(false) && !mShouldClose) {
+			Sint32 timeout = -1;
+			if (mNextRedrawTicks != 0) {
+				Uint64 now = SDL_GetTicks();
+				if (now >= mNextRedrawTicks)
+					break;
+				timeout = static_cast<Sint32>(mNextRedrawTicks - now);
+			}
+
+			if (SDL_WaitEventTimeout(&event, timeout)) {
+				HandleEvent(backend, event);
 				break;
+			}
 		}
+		mWaiting = false;
 	}
+
+	while (SDL_PollEvent(&event))
+		HandleEvent(backend, event);
+
+	if (mNextRedrawTicks != 0 && SDL_GetTicks() >= mNextRedrawTicks)
+		mNextRedrawTicks = 0;
+
+	if (mPendingFrames > 0)
+		--mPendingFrames;
+}
+
+void PlatformSDL::HandleEvent(PlatformBackend* backend, const SDL_Event& event) {
+	mPendingFrames = REDRAW_FRAMES_AFTER_EVENT;
+
+	// only there to wake up the loop
+	if (event.type == mWakeEvent)
+		return;
+
+	if (backend)
+		backend->ProcessEvent(const_cast<SDL_Event*>(&event));
+
+	switch (event.type)
+	{
+		case SDL_EVENT_QUIT:
+			mShouldClose = true;
+			break;
+		case SDL_EVENT_DROP_FILE:
+			gApp->GetUI()->ShowFileDropPopUp(event.drop.data);
+			break;
+		default:
+			break;
+	}
+}
+
+void PlatformSDL::RequestRedraw(unsigned int delayMs) {
+	if (delayMs > 0) {
+		Uint64 ticks = SDL_GetTicks() + delayMs;
+		if (mNextRedrawTicks == 0 || ticks < mNextRedrawTicks)
+			mNextRedrawTicks = ticks;
+		return;
+	}
+
+	mRedrawRequested = true;
+
+	// the flag is checked before waiting, so the event is only needed when the loop is already asleep
+	if (mWaiting && mWakeEvent != 0) {
+		SDL_Event event{};
+		event.type = mWakeEvent;
+		SDL_PushEvent(&event);
+	}
+}
+
+void PlatformSDL::LimitFrameRate() {
+	if (mFrameRateLimit > 0) {
+		Uint64 frameTime = SDL_NS_PER_SECOND / mFrameRateLimit;
+		Uint64 elapsed = SDL_GetTicksNS() - mLastFrameTicks;
+		if (elapsed < frameTime)
+			SDL_DelayNS(frameTime - elapsed);
+	}
+
+	mLastFrameTicks = SDL_GetTicksNS();
 }
 
 bool PlatformSDL::ShouldClose() const {
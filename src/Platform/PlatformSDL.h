@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <SDL3/SDL.h>
 #include "Platform/PlatformBase.h"
 
@@ -18,6 +19,21 @@ public:
 	// Check if application should close
 	bool ShouldClose() const override;
 
+	// Asks for a frame to be drawn, waking up the main loop if it's idling
+	void RequestRedraw(unsigned int delayMs = 0) override;
+
+	// Sets whether to sleep until there's something to draw
+	void SetIdleWait(bool enabled) override { mIdleWait = enabled; }
+
+	// Checks whether to sleep until there's something to draw
+	bool GetIdleWait() const override { return mIdleWait; }
+
+	// Sets the frame rate limit; 0 for none
+	void SetFrameRateLimit(int fps) override { mFrameRateLimit = fps; }
+
+	// Gets the frame rate limit; 0 for none
+	int GetFrameRateLimit() const override { return mFrameRateLimit; }
+
 	// Run the SDL shutdown/clean up event
 	void Shutdown() override;
 
@@ -70,4 +86,21 @@ private:
 	SDL_Window* mWindow = nullptr;
 	SDL_GLContext mGLContext = nullptr;
 	bool mShouldClose = false;
-};
\ No newline at end of file
+
+	// Handles a single SDL event
+	void HandleEvent(PlatformBackend* backend, const SDL_Event& event);
+
+	// Sleeps off whatever is left of the frame time, if the frame rate is limited
+	void LimitFrameRate();
+
+	// Event used to wake up the main loop from other threads
+	Uint32 mWakeEvent = 0;
+	bool mIdleWait = true;
+	int mFrameRateLimit = 0;
+	Uint64 mLastFrameTicks = 0;
+	// frames left to draw after the last event; ImGui needs a few to settle things like popups
+	int mPendingFrames = 3;
+	// SDL ticks of a delayed redraw request; 0 if there is none
+	Uint64 mNextRedrawTicks = 0;
+	std::atomic<bool> mRedrawRequested{ false };
+	std::atomic<bool> mWaiting{ false };
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "Application/Application.h"
+#include "Program/JobSystem.h"
+#include "Util/Log.h"
+
+JobSystem::~JobSystem() {
+    Cancel();
+    mWorker.Wait();
+}
+
+bool JobSystem::Start(const std::string& name, std::function<void(JobProgress&)> work, std::function<void()> onComplete) {
+    if (IsBusy())
+        return false;
+
+    mName = name;
+    mProgress = std::make_unique<JobProgress>();
+    mOnComplete = std::move(onComplete);
+
+    JobProgress* progress = mProgress.get();
+    mFuture = mWorker.Submit([work = std::move(work), progress]() {
+        // wakes up the main loop, however the job ended
+        struct WakeOnExit {
+            ~WakeOnExit() { gApp->GetPlatform()->RequestRedraw(); }
+        } wake;
+
+        work(*progress);
+    });
+
+    LOG_INFO("Started job: %s", mName.c_str());
+    return true;
+}
+
+bool JobSystem::IsBusy() const {
+    return mFuture.valid();
+}
+
+void JobSystem::Update() {
+    if (!mFuture.valid() || mFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    auto& fileDialog = gApp->GetPlatform()->mDialog;
+    std::function<void()> onComplete = std::move(mOnComplete);
+    mOnComplete = nullptr;
+
+    try {
+        mFuture.get();
+        LOG_INFO("Finished job: %s", mName.c_str());
+
+        if (onComplete)
+            onComplete();
+    }
+    catch (const JobCancelled&) {
+        LOG_INFO("Cancelled job: %s", mName.c_str());
+        gApp->GetPlatform()->ShowCancelledMessage();
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR("Failed job: %s: %s", mName.c_str(), e.what());
+        fileDialog.ShowError("Error", e.what());
+    }
+    catch (...) {
+        fileDialog.ShowError("Error", "Unknown Error Occurred.");
+    }
+
+    mProgress.reset();
+    mName.clear();
+}
+
+void JobSystem::Cancel() {
+    if (mProgress)
+        mProgress->cancel();
+}
+
+const std::string& JobSystem::GetName() const {
+    return mName;
+}
+
+const JobProgress* JobSystem::GetProgress() const {
+    return mProgress.get();
+}
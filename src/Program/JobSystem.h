@@ -0,0 +1,42 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include "Util/JobProgress.h"
+#include "Util/ThreadPool.h"
+
+// Runs one long operation at a time, like opening or saving a PCK, on a worker thread so the window keeps responding
+class JobSystem {
+public:
+    // Asks the running job to stop, then waits for it
+    ~JobSystem();
+
+    // Starts a job unless one is already running. Work runs on the worker thread and must only touch its own data;
+    // onComplete runs on the UI thread once work succeeded, which is where results get swapped in
+    bool Start(const std::string& name, std::function<void(JobProgress&)> work, std::function<void()> onComplete = nullptr);
+
+    // Checks if a job is running; edits are blocked until it's done
+    bool IsBusy() const;
+
+    // Finishes a done job on the UI thread, running its completion or showing its error; call once per frame
+    void Update();
+
+    // Asks the running job to stop at its next check
+    void Cancel();
+
+    // Gets the name of the running job
+    const std::string& GetName() const;
+
+    // Gets the progress of the running job; nullptr if there is none
+    const JobProgress* GetProgress() const;
+
+private:
+    std::string mName{};
+    std::unique_ptr<JobProgress> mProgress{};
+    std::function<void()> mOnComplete{};
+    std::future<void> mFuture{};
+    // last, so the worker is joined before anything it uses is destroyed
+    ThreadPool mWorker{ 1 };
+};
@@ -1,30 +1,117 @@
-﻿#include <map>
+﻿#include <fstream>
+#include <map>
 #include <sstream>
 #include "Application/Application.h"
 #include "PCK/PCKAssetFile.h"
 #include "Program/Program.h"
 #include "UI/Tree/TreeFunctions.h"
+#include "Util/ImageAtlas.h"
+#include "Util/Log.h"
+#include "Util/Trace.h"
+
+// Icons are drawn at 48x48, so they're packed at twice that for HiDPI
+static const int ICON_ATLAS_CELL_SIZE = 96;
+// Bump when the packing changes, so old caches get rebuilt
+static const uint32_t ICON_ATLAS_REVISION = 1;
+static const char* FOLDER_ICON_NAME = "NODE_FOLDER";
+
+// Gets where the icon atlas is cached between runs
+static std::string GetIconAtlasCachePath() {
+	std::string cachePath = "cache/";
+	if (char* prefPath = SDL_GetPrefPath(nullptr, "PCK++")) {
+		cachePath = prefPath;
+		SDL_free(prefPath);
+	}
+	return cachePath + "icons.atlas";
+}
+
+// Gets the icon name for the file type
+static std::string GetFileIconName(PCKAssetFile::Type type) {
+	std::string name = (type == PCKAssetFile::Type::UI_DATA)
+		? PCKAssetFile::getAssetTypeString(PCKAssetFile::Type::PCK_ASSET_TYPES_TOTAL)
+		: PCKAssetFile::getAssetTypeString(type);
+	return "FILE_" + name;
+}
+
+// Gets the prebuilt icon atlas from cache, or builds and caches it when the icons changed since
+static ImageAtlas LoadIconAtlas(const std::vector<std::string>& names) {
+	std::vector<std::string> paths;
+	for (const std::string& name : names)
+		paths.push_back("assets/icons/" + name + ".png");
+
+	uint64_t fingerprint = ImageAtlas::FingerprintFiles(paths, ICON_ATLAS_REVISION ^ (ICON_ATLAS_CELL_SIZE << 8));
+	std::string cachePath = GetIconAtlasCachePath();
+
+	ImageAtlas atlas;
+	if (ImageAtlas::Load(cachePath, fingerprint, atlas)) {
+		LOG_INFO("Loaded icon atlas from cache: %s", cachePath.c_str());
+		return atlas;
+	}
+
+	std::vector<std::pair<std::string, Image>> icons;
+	for (size_t i = 0; i < names.size(); ++i) {
+		std::ifstream file(paths[i], std::ios::binary);
+		std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		Image icon = Image::Decode(data.data(), data.size());
+		if (icon.empty())
+			LOG_WARNING("Failed to load icon: %s", paths[i].c_str());
+		icons.emplace_back(names[i], std::move(icon));
+	}
+
+	atlas = ImageAtlas::Pack(icons, ICON_ATLAS_CELL_SIZE);
+
+	if (atlas.Save(cachePath, fingerprint))
+		LOG_INFO("Built and cached icon atlas: %s", cachePath.c_str());
+	else
+		LOG_WARNING("Built icon atlas, but failed to cache it: %s", cachePath.c_str());
+
+	return atlas;
+}
 
 void ProgramSetup() {
-	gApp->SetFolderIcon(gApp->GetGraphics()->LoadTextureFromFile("assets/icons/NODE_FOLDER.png", TextureFilter::LINEAR_MIPMAP_LINEAR));
+	std::vector<std::string> names{ FOLDER_ICON_NAME };
+	for (int i = 0; i < (int)PCKAssetFile::Type::PCK_ASSET_TYPES_TOTAL; i++)
+		names.push_back(GetFileIconName(static_cast<PCKAssetFile::Type>(i)));
+
+	// every icon lives in one texture, uploaded once
+	ImageAtlas atlas = LoadIconAtlas(names);
+	const Image& image = atlas.getImage();
+	Texture texture = gApp->GetGraphics()->LoadTextureFromPixels(image.pixels.data(), image.width, image.height, TextureFilter::LINEAR);
+	gApp->SetIconAtlas(texture);
+
+	auto getRegion = [&](const std::string& name) {
+		TextureRegion region{ texture.id };
+		if (const ImageAtlas::Region* packed = atlas.findRegion(name)) {
+			region.u0 = (float)packed->x / image.width;
+			region.v0 = (float)packed->y / image.height;
+			region.u1 = (float)(packed->x + packed->width) / image.width;
+			region.v1 = (float)(packed->y + packed->height) / image.height;
+		}
+		return region;
+	};
+
+	gApp->SetFolderIcon(getRegion(FOLDER_ICON_NAME));
 	for (int i = 0; i < (int)PCKAssetFile::Type::PCK_ASSET_TYPES_TOTAL; i++) {
 		auto type = static_cast<PCKAssetFile::Type>(i);
-		std::string name = (type == PCKAssetFile::Type::UI_DATA)
-			? PCKAssetFile::getAssetTypeString(PCKAssetFile::Type::PCK_ASSET_TYPES_TOTAL)
-			: PCKAssetFile::getAssetTypeString(type);
-		std::string path = "assets/icons/FILE_" + name + ".png";
-		gApp->SetFileIcon(type, gApp->GetGraphics()->LoadTextureFromFile(path, TextureFilter::LINEAR_MIPMAP_LINEAR));
+		gApp->SetFileIcon(type, getRegion(GetFileIconName(type)));
 	}
 }
 
 void ResetProgramData() {
 	gApp->GetInstance()->Reset();
+	gApp->GetGraphics()->ClearTextureCache();
 }
 
 static void ProgramCleanup() {
 	ResetProgramData();
 }
 
+void HandleJobs() {
+	gApp->GetInstance()->jobs.Update();
+	gApp->GetUI()->RenderJobProgress();
+}
+
 void HandleMenuBar() {
 	gApp->GetUI()->RenderMenuBar();
 }
@@ -47,5 +134,19 @@ static void HandlePropertiesWindow(PCKAssetFile& file)
 
 void HandleFileTree() {
 	BuildFileTree();
+
+	TRACE_SCOPE("RenderFileTree");
 	gApp->GetUI()->RenderFileTree();
+}
+
+void HandleTraceOverlay() {
+	gApp->GetUI()->RenderTraceOverlay();
+}
+
+void HandleDuplicatesWindow() {
+	gApp->GetUI()->RenderDuplicatesWindow();
+}
+
+void HandleComparisonWindow() {
+	gApp->GetUI()->RenderComparisonWindow();
 }
\ No newline at end of file
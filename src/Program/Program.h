@@ -13,4 +13,16 @@ void HandleInput();
 void HandleFileTree();
 
 // Handles the menu bar
-void HandleMenuBar();
\ No newline at end of file
+void HandleMenuBar();
+
+// Finishes done background jobs and shows the progress of running ones
+void HandleJobs();
+
+// Shows the zone timings of the last frame, when turned on
+void HandleTraceOverlay();
+
+// Shows the files with identical data in the current PCK File, when turned on
+void HandleDuplicatesWindow();
+
+// Shows the last comparison of another PCK File with the current one, if there is one
+void HandleComparisonWindow();
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Application/Application.h"
+#include "PCK/PCKDeduplicator.h"
 #include "Program/ProgramInstance.h"
+#include "Util/Log.h"
 
 void ProgramInstance::Reset() {
     if (mCurrentPCKFile) {
@@ -8,21 +10,64 @@ void ProgramInstance::Reset() {
     }
 
     selectedNodePath.clear();
+    assets.clear();
+    comparison.reset();
 }
 
 PCKFile* ProgramInstance::GetCurrentPCKFile() {
     return mCurrentPCKFile.get();
 }
 
-void ProgramInstance::LoadPCKFile(const std::string& filepath) {
-    bool empty = !mCurrentPCKFile;
+uint32_t ProgramInstance::GetCurrentPCKRevision() {
+    if (!mCurrentPCKFile)
+        return 0;
+
+    // read before walking the PCK File, so a change made while it's walked is still picked up next time
+    uint32_t latest = PCKAssetFile::LatestRevision();
+    if (!mCurrentPCKRevisionKnown || mCurrentPCKRevisionCheckedAt != latest) {
+        mCurrentPCKRevision = mCurrentPCKFile->getRevision();
+        mCurrentPCKRevisionCheckedAt = latest;
+        mCurrentPCKRevisionKnown = true;
+    }
+
+    return mCurrentPCKRevision;
+}
+
+std::unique_ptr<PCKFile> ProgramInstance::ReadPCKFile(const std::string& filepath, JobProgress* progress) {
+    auto pckFile = std::make_unique<PCKFile>();
 
     try {
-        mCurrentPCKFile = std::make_unique<PCKFile>();
-        mCurrentPCKFile->Read(filepath);
+        pckFile->Read(filepath, progress);
+    }
+    catch (const JobCancelled&) {
+        throw;
     }
     catch (...) {
-        printf("Failed to load PCK file: %s", filepath.c_str());
-        if(empty) mCurrentPCKFile = nullptr; // so when an file argument fails, the UI isn't already loaded
+        LOG_ERROR("Failed to load PCK file: %s", filepath.c_str());
+        throw;
     }
+
+    // identical files are only held in memory once; files of nested PCK Files point into their parent's data already, so only the top ones are looked at
+    std::vector<PCKDeduplicator::Entry> entries;
+    entries.reserve(pckFile->getFiles().size());
+    for (PCKAssetFile& file : pckFile->getFiles())
+        entries.push_back({ &file, pckFile->getFileName() });
+
+    uint64_t shared = PCKDeduplicator::ShareDuplicates(PCKDeduplicator::FindDuplicates(entries));
+    if (shared > 0)
+        LOG_INFO("Shared %llu bytes of duplicate file data in %s", (unsigned long long)shared, filepath.c_str());
+
+    return pckFile;
+}
+
+void ProgramInstance::SetCurrentPCKFile(std::unique_ptr<PCKFile> pckFile) {
+    // a failed read never gets here, so the UI keeps whatever was loaded before
+    mCurrentPCKFile = std::move(pckFile);
+    mCurrentPCKRevisionKnown = false;
+    treeNodes.clear();
+    visibleNodes.clear();
+
+    // so any CJK paths or property values are baked into the font before they're shown
+    if (mCurrentPCKFile)
+        gApp->GetUI()->RequestGlyphs(*mCurrentPCKFile);
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "Binary/Binary.h"
+#include "PCK/AssetCache.h"
+#include "PCK/PCKDiff.h"
 #include "PCK/PCKFile.h"
+#include "Program/JobSystem.h"
 #include "UI/Tree/TreeNode.h"
 
 class ProgramInstance {
@@ -21,8 +24,27 @@ public:
     // Get current PCK file
     PCKFile* GetCurrentPCKFile();
 
-    // Loads PCK File from path
-    void LoadPCKFile(const std::string& filepath);
+    // Reads a PCK File from path; safe to call from a job, throws on failure
+    static std::unique_ptr<PCKFile> ReadPCKFile(const std::string& filepath, JobProgress* progress = nullptr);
+
+    // Swaps in a newly read PCK File as the current one
+    void SetCurrentPCKFile(std::unique_ptr<PCKFile> pckFile);
+
+    // Gets the revision of the current PCK File, 0 if there isn't one; it's only looked up again once any new revision was handed out, so it's cheap enough for every frame
+    uint32_t GetCurrentPCKRevision();
+
+    // Long operations running in the background
+    JobSystem jobs;
+
+    // Decoded forms of the current PCK File's assets
+    AssetCache assets;
+
+    // The last comparison of a PCK File on disk with the current one, shown side by side; null when there isn't one
+    std::unique_ptr<PCKDiff> comparison;
+
+    // The PCK File on disk the current one was compared with, and the revision the current one was at
+    std::string comparisonPath;
+    uint32_t comparisonRevision = 0;
 
     // Tree Nodes
     std::vector<FileTreeNode> treeNodes;
@@ -32,4 +54,7 @@ public:
 
 private:
     std::unique_ptr<PCKFile> mCurrentPCKFile;
+    uint32_t mCurrentPCKRevision = 0;
+    uint32_t mCurrentPCKRevisionCheckedAt = 0; // the latest revision handed out when the current PCK File's was looked up
+    bool mCurrentPCKRevisionKnown = false;
 };
\ No newline at end of file
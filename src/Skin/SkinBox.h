@@ -0,0 +1,174 @@
+#pragma once
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "Util/Util.h"
+
+struct UVRect
+{
+    float u0, v0; // top-left UV
+    float u1, v1; // bottom-right UV
+};
+
+// Interleaved texture coordinate and position, laid out for GL_T2F_V3F
+struct SkinVertex
+{
+    float u, v;
+    float x, y, z;
+};
+
+// Positional offset of a skin part, from OFFSET properties
+struct SkinOffset
+{
+    float x{}, y{}, z{};
+};
+
+class SkinBox
+{
+public:
+    std::string type{};
+    float x, y, z;
+    float width, height, depth;
+    float u, v;
+    int armorMask;
+    bool mirrored;
+    float scale{ 0.0f };
+
+    SkinBox() : SkinBox("BODY", 0, 0, 0, 0, 0, 0, 0, 0, 0, false, 0) {}
+
+    SkinBox(const std::string& type, float x, float y, float z, float width, float height, float depth, float u, float v, int armorMask = 0, bool mirrored = false, float scale = 0.0f)
+        : type(type), x(x), y(y), z(z), width(width), height(height), depth(depth), u(u), v(v), armorMask(armorMask), mirrored(mirrored), scale(scale)
+    {
+    }
+
+    // Parses a BOX property value; "TYPE X Y Z WIDTH HEIGHT DEPTH U V [ARMOR_MASK] [MIRRORED] [SCALE]"
+    void parse(const std::u16string& value) {
+        std::size_t pos = 0;
+
+        type = nextToken(value, pos);
+        x = nextFloat(value, pos);
+        y = nextFloat(value, pos);
+        z = nextFloat(value, pos);
+        width = nextFloat(value, pos);
+        height = nextFloat(value, pos);
+        depth = nextFloat(value, pos);
+        u = nextFloat(value, pos);
+        v = nextFloat(value, pos);
+        armorMask = (int)nextFloat(value, pos);
+        mirrored = nextFloat(value, pos) != 0.0f;
+        scale = nextFloat(value, pos);
+    }
+
+    // Gets the next whitespace separated token of a property value, as ASCII
+    static std::string nextToken(const std::u16string& value, std::size_t& pos)
+    {
+        while (pos < value.size() && (value[pos] == u' ' || value[pos] == u'\t'))
+            ++pos;
+
+        std::string token;
+        while (pos < value.size() && value[pos] != u' ' && value[pos] != u'\t')
+            token += static_cast<char>(value[pos++] & 0x7F); // box values are plain ASCII
+
+        return token;
+    }
+
+    // Gets the next token of a property value as a float; 0 if there is none
+    static float nextFloat(const std::u16string& value, std::size_t& pos)
+    {
+        std::string token = nextToken(value, pos);
+        return token.empty() ? 0.0f : std::strtof(token.c_str(), nullptr);
+    }
+
+    // for simplifying layer box creation
+    static SkinBox CreateLayer(SkinBox& other, int u, int v, float scale)
+    {
+        return SkinBox(other.type, other.x, other.y, other.z, other.width, other.height, other.depth, u, v, 0, false, scale);
+    }
+
+    // Appends the box's six faces as textured quads to a vertex buffer; offset is added on top of the part's default position
+    // mirroredBottom flips the bottom face, which is how 64x64 skins lay it out
+    void AppendVertices(std::vector<SkinVertex>& out, const SkinOffset& offset = {}, bool mirroredBottom = false) const
+    {
+        SkinOffset partOffset = getPartOffset(type);
+
+        float offsetX = partOffset.x + offset.x;
+        float offsetY = partOffset.y + offset.y;
+        float offsetZ = partOffset.z + offset.z;
+
+        float x0 = offsetX + x - scale;
+        float x1 = offsetX + x + width + scale;
+        float y0 = -(offsetY + y) - scale;
+        float y1 = -(offsetY + y) + height + scale;
+        float z0 = offsetZ + z - scale;
+        float z1 = offsetZ + z + depth + scale;
+
+        if (mirrored) std::swap(x0, x1);
+
+        out.reserve(out.size() + 24);
+
+        out.push_back({ mFront.u0, mFront.v1, x0, y0, z1 });
+        out.push_back({ mFront.u1, mFront.v1, x1, y0, z1 });
+        out.push_back({ mFront.u1, mFront.v0, x1, y1, z1 });
+        out.push_back({ mFront.u0, mFront.v0, x0, y1, z1 });
+
+        out.push_back({ mBack.u1, mBack.v1, x0, y0, z0 });
+        out.push_back({ mBack.u1, mBack.v0, x0, y1, z0 });
+        out.push_back({ mBack.u0, mBack.v0, x1, y1, z0 });
+        out.push_back({ mBack.u0, mBack.v1, x1, y0, z0 });
+
+        out.push_back({ mTop.u0, mTop.v0, x0, y1, z0 });
+        out.push_back({ mTop.u0, mTop.v1, x0, y1, z1 });
+        out.push_back({ mTop.u1, mTop.v1, x1, y1, z1 });
+        out.push_back({ mTop.u1, mTop.v0, x1, y1, z0 });
+
+        out.push_back({ mBottom.u0, mirroredBottom ? mBottom.v0 : mBottom.v1, x0, y0, z0 });
+        out.push_back({ mBottom.u1, mirroredBottom ? mBottom.v0 : mBottom.v1, x1, y0, z0 });
+        out.push_back({ mBottom.u1, mirroredBottom ? mBottom.v1 : mBottom.v0, x1, y0, z1 });
+        out.push_back({ mBottom.u0, mirroredBottom ? mBottom.v1 : mBottom.v0, x0, y0, z1 });
+
+        out.push_back({ mRight.u1, mRight.v1, x1, y0, z0 });
+        out.push_back({ mRight.u1, mRight.v0, x1, y1, z0 });
+        out.push_back({ mRight.u0, mRight.v0, x1, y1, z1 });
+        out.push_back({ mRight.u0, mRight.v1, x1, y0, z1 });
+
+        out.push_back({ mLeft.u0, mLeft.v1, x0, y0, z0 });
+        out.push_back({ mLeft.u1, mLeft.v1, x0, y0, z1 });
+        out.push_back({ mLeft.u1, mLeft.v0, x0, y1, z1 });
+        out.push_back({ mLeft.u0, mLeft.v0, x0, y1, z0 });
+    }
+
+    // Gets the default position of the part a box is attached to
+    static SkinOffset getPartOffset(const std::string& type)
+    {
+        if (type == "HEAD_DEFAULT") return { 0, -4, 0 };
+        if (type == "HEAD" || type == "HEADWEAR") return { 0, -8, 0 };
+        if (type == "BODY" || type == "JACKET") return { 0, 2, 0 };
+        if (type == "ARM0" || type == "SLEEVE0") return { -5, 2, 0 };
+        if (type == "ARM1" || type == "SLEEVE1") return { 5, 2, 0 };
+        if (type == "LEG0" || type == "PANTS0") return { -1.9f, 12, 0 };
+        if (type == "LEG1" || type == "PANTS1") return { 1.9f, 12, 0 };
+        return {};
+    }
+
+    // Calculates the UVs of every face for the given skin texture size; must be called before AppendVertices
+    void calculateUVs(int textureWidth, int textureHeight)
+    {
+        // Normalize variables
+        float u0 = u / textureWidth;
+        float v0 = v / textureHeight;
+        float uvWidth = width / textureWidth;
+        float uvHeight = height / textureHeight;
+        float uvDepthX = depth / textureWidth;
+        float uvDepthY = depth / textureHeight;
+
+        mTop = { u0 + uvDepthX, v0, u0 + uvWidth + uvDepthX, v0 + uvDepthY };
+        mBottom = { mTop.u1, mTop.v0, mTop.u1 + uvWidth, mTop.v1 };
+        mLeft = { u0, mTop.v1, mTop.u0, v0 + uvDepthY + uvHeight };
+        mFront = { mTop.u0, mTop.v1, mTop.u1, mLeft.v1 };
+        mRight = { mTop.u1, mTop.v1, mTop.u1 + uvDepthX, mLeft.v1 };
+        mBack = { mRight.u1, mTop.v1, mRight.u1 + uvWidth, mLeft.v1 };
+    }
+
+private:
+    UVRect mFront{}, mBack{}, mTop{}, mBottom{}, mRight{}, mLeft{};
+};
\ No newline at end of file
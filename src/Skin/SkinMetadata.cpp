@@ -0,0 +1,38 @@
+#include "Skin/SkinMetadata.h"
+
+SkinMetadata SkinMetadata::Parse(const std::vector<std::pair<std::string, std::u16string>>& properties)
+{
+    SkinMetadata metadata;
+
+    for (const auto& property : properties)
+    {
+        if (property.first == "ANIM")
+        {
+            std::size_t pos = 0;
+            std::string value = SkinBox::nextToken(property.second, pos);
+
+            metadata.anim = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 0)); // parse number
+        }
+        else if (property.first == "BOX")
+        {
+            SkinBox box{};
+            box.parse(property.second);
+            metadata.boxes.push_back(box);
+        }
+        else if (property.first == "OFFSET")
+        {
+            // "PART AXIS VALUE"; i.e. "HEAD Y -2"
+            std::size_t pos = 0;
+            std::string part = SkinBox::nextToken(property.second, pos);
+            std::string axis = SkinBox::nextToken(property.second, pos);
+            float value = SkinBox::nextFloat(property.second, pos);
+
+            SkinOffset& offset = metadata.offsets[part];
+            if (axis == "X") offset.x += value;
+            else if (axis == "Y") offset.y += value;
+            else if (axis == "Z") offset.z += value;
+        }
+    }
+
+    return metadata;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Skin/SkinBox.h"
+
+enum SKIN_ANIM
+{
+    STATIONARY_ARMS = 1 << 0,
+    ZOMBIE_ARMS = 1 << 1,
+    STATIONARY_LEGS = 1 << 2,
+    BAD_SANTA_IDLE = 1 << 3,
+    UNKNOWN_EFFECT = 1 << 4,
+    SYNCHRONIZED_LEGS = 1 << 5,
+    SYNCHRONIZED_ARMS = 1 << 6,
+    STATUE_OF_LIBERTY = 1 << 7,
+    HIDE_ARMOR = 1 << 8,
+    FIRST_PERSON_BOBBING_DISABLED = 1 << 9,
+    HIDE_HEAD = 1 << 10,
+    HIDE_RIGHT_ARM = 1 << 11,
+    HIDE_LEFT_ARM = 1 << 12,
+    HIDE_BODY = 1 << 13,
+    HIDE_RIGHT_LEG = 1 << 14,
+    HIDE_LEFT_LEG = 1 << 15,
+    HIDE_HAT = 1 << 16,
+    BACKWARDS_CROUCH = 1 << 17, // This is what it's called on bedrock lol
+    MODERN_WIDE_FORMAT = 1 << 18,
+    SLIM_FORMAT = 1 << 19,
+    HIDE_LEFT_SLEEVE = 1 << 20,
+    HIDE_RIGHT_SLEEVE = 1 << 21,
+    HIDE_LEFT_PANT = 1 << 22,
+    HIDE_RIGHT_PANT = 1 << 23,
+    HIDE_JACKET = 1 << 24,
+    ALLOW_HEAD_ARMOR = 1 << 25, // these flags handle allowing a piece of armor to render after its parent part was hidden
+    ALLOW_RIGHT_ARM_ARMOR = 1 << 26,
+    ALLOW_LEFT_ARM_ARMOR = 1 << 27,
+    ALLOW_CHESTPLATE = 1 << 28,
+    ALLOW_RIGHT_LEGGING = 1 << 29,
+    ALLOW_LEFT_LEGGING = 1 << 30,
+    DINNERBONE_RENDERING = 1u << 31
+};
+
+// What a skin's properties say about its model: the ANIM flags, custom BOXes and OFFSETs, parsed out of the property strings once.
+// Never changed after it's parsed, so one can be shared by everything looking at the skin, on any thread
+struct SkinMetadata
+{
+    // Parses the ANIM, BOX and OFFSET properties of a skin; every other property is skipped
+    static SkinMetadata Parse(const std::vector<std::pair<std::string, std::u16string>>& properties);
+
+    // Is the skin 64x64? True for both modern wide and slim skins
+    bool isModernFormat() const { return (anim & MODERN_WIDE_FORMAT) || isSlimFormat(); }
+
+    // Is the skin using slim (3 pixel) arms?
+    bool isSlimFormat() const { return anim & SLIM_FORMAT; }
+
+    uint32_t anim{ 0 }; // the last ANIM property, or 0 if there isn't one
+    std::vector<SkinBox> boxes{}; // in property order; their UVs aren't calculated, since that depends on the texture size
+    std::map<std::string, SkinOffset> offsets{}; // per part, with every OFFSET for the same part and axis added up
+};
@@ -0,0 +1,78 @@
+#include "Skin/SkinModel.h"
+
+void SkinModel::Build(const SkinMetadata& metadata)
+{
+    mANIM = metadata.anim;
+    mSlimFormat = metadata.isSlimFormat();
+    mModernFormat = metadata.isModernFormat();
+    mBoxes = metadata.boxes;
+    mOffsets = metadata.offsets;
+    mDefaultBoxes.clear();
+
+    // positions/offsets are work in progress :3
+    // heads seem to have weird offsets??? will work on this at a later date
+    SkinBox head("HEAD_DEFAULT", - 4, -8, -4, 8, 8, 8, 0, 0);
+    SkinBox hat = SkinBox::CreateLayer(head, 32, 0, 0.5f);
+
+    SkinBox body("BODY", - 4, -2, -2, 8, 12, 4, 16, 16);
+    SkinBox jacket = SkinBox::CreateLayer(body, 16, 32, 0.5f);
+    SkinBox cape("CAPE", -8, -4, -6, 10, 16, 1, 16, 16);
+
+    SkinBox arm0("ARM0", mSlimFormat ? -2 : -3, -2, -2, mSlimFormat ? 3 : 4, 12, 4, 40, 16);
+    SkinBox sleeve0 = SkinBox::CreateLayer(arm0, 40, 32, 0.5f);
+
+    SkinBox arm1("ARM1", -1, -2, -2, arm0.width, 12, 4, mModernFormat ? 32 : 40, mModernFormat ? 48 : 16, 0, !mModernFormat);
+    SkinBox sleeve1 = SkinBox::CreateLayer(arm1, 48, 48, 0.5f);
+
+    SkinBox leg0("LEG0", -2, 0, -2, 4, 12, 4, 0, 16);
+    SkinBox pant0 = SkinBox::CreateLayer(leg0, 0, 32, 0.5f);
+
+    SkinBox leg1("LEG1", -2, 0, -2, 4, 12, 4, mModernFormat ? 16 : 0, mModernFormat ? 48 : 16, 0, arm1.mirrored);
+    SkinBox pant1 = SkinBox::CreateLayer(leg1, 0, 48, 0.5f);
+
+    if (!(mANIM & HIDE_HAT)) mDefaultBoxes.push_back(hat);
+    if (!(mANIM & HIDE_HEAD)) mDefaultBoxes.push_back(head);
+    if (!(mANIM & HIDE_BODY)) mDefaultBoxes.push_back(body);
+    if (!(mANIM & HIDE_RIGHT_ARM)) mDefaultBoxes.push_back(arm0);
+    if (!(mANIM & HIDE_LEFT_ARM)) mDefaultBoxes.push_back(arm1);
+    if (!(mANIM & HIDE_RIGHT_LEG)) mDefaultBoxes.push_back(leg0);
+    if (!(mANIM & HIDE_LEFT_LEG)) mDefaultBoxes.push_back(leg1);
+
+    if (mModernFormat)
+    {
+        if (!(mANIM & HIDE_JACKET)) mDefaultBoxes.push_back(jacket);
+        if (!(mANIM & HIDE_RIGHT_SLEEVE)) mDefaultBoxes.push_back(sleeve0);
+        if (!(mANIM & HIDE_LEFT_SLEEVE)) mDefaultBoxes.push_back(sleeve1);
+        if (!(mANIM & HIDE_RIGHT_PANT)) mDefaultBoxes.push_back(pant0);
+        if (!(mANIM & HIDE_LEFT_PANT)) mDefaultBoxes.push_back(pant1);
+    }
+
+    for (SkinBox& box : mDefaultBoxes)
+        box.calculateUVs(getTextureWidth(), getTextureHeight());
+
+    for (SkinBox& box : mBoxes)
+        box.calculateUVs(getTextureWidth(), getTextureHeight());
+}
+
+void SkinModel::AppendVertices(std::vector<SkinVertex>& out) const
+{
+    out.reserve(out.size() + (mDefaultBoxes.size() + mBoxes.size()) * 24);
+
+    for (const SkinBox& box : mDefaultBoxes)
+        box.AppendVertices(out, getBoxOffset(box), mModernFormat);
+
+    for (const SkinBox& box : mBoxes)
+        box.AppendVertices(out, getBoxOffset(box), mModernFormat);
+}
+
+SkinOffset SkinModel::getBoxOffset(const SkinBox& box) const
+{
+    static const std::map<std::string, std::string> OVERLAY_PARTS{
+        { "HEAD_DEFAULT", "HEAD" }, { "HEADWEAR", "HEAD" }, { "JACKET", "BODY" },
+        { "SLEEVE0", "ARM0" }, { "SLEEVE1", "ARM1" }, { "PANTS0", "LEG0" }, { "PANTS1", "LEG1" }
+    };
+
+    auto overlay = OVERLAY_PARTS.find(box.type);
+    auto it = mOffsets.find(overlay != OVERLAY_PARTS.end() ? overlay->second : box.type);
+    return it != mOffsets.end() ? it->second : SkinOffset{};
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <map>
+#include "Skin/SkinBox.h"
+#include "Skin/SkinMetadata.h"
+
+// The full box model of a skin: default parts (minus the ANIM hidden ones), custom BOXes and OFFSETs.
+// Holds all of its own state, so skins can be built on multiple threads at once.
+class SkinModel
+{
+public:
+    // Builds the model from a skin's parsed ANIM, BOX and OFFSET properties
+    void Build(const SkinMetadata& metadata);
+
+    // Appends every box of the model, default parts first, to a vertex buffer
+    void AppendVertices(std::vector<SkinVertex>& out) const;
+
+    // Gets the ANIM flags of the skin
+    uint32_t getANIM() const { return mANIM; }
+
+    // Is the skin 64x64? True for both modern wide and slim skins
+    bool isModernFormat() const { return mModernFormat; }
+
+    // Is the skin using slim (3 pixel) arms?
+    bool isSlimFormat() const { return mSlimFormat; }
+
+    // Gets the texture width the UVs are calculated for
+    int getTextureWidth() const { return 64; }
+
+    // Gets the texture height the UVs are calculated for
+    int getTextureHeight() const { return mModernFormat ? 64 : 32; }
+
+    // Gets the visible default parts
+    const std::vector<SkinBox>& getDefaultBoxes() const { return mDefaultBoxes; }
+
+    // Gets the custom boxes from BOX properties
+    const std::vector<SkinBox>& getBoxes() const { return mBoxes; }
+
+    // Gets the OFFSET of the part a box belongs to; overlay boxes follow their base part
+    SkinOffset getBoxOffset(const SkinBox& box) const;
+
+private:
+    uint32_t mANIM{ 0 };
+    bool mModernFormat{ false };
+    bool mSlimFormat{ false };
+    std::vector<SkinBox> mDefaultBoxes{};
+    std::vector<SkinBox> mBoxes{};
+    std::map<std::string, SkinOffset> mOffsets{};
+};
@@ -0,0 +1,158 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <algorithm>
+#include <limits>
+#include "Skin/SkinRasterizer.h"
+
+namespace
+{
+    // Vertex after the view rotation and fit into the image; z grows towards the camera
+    struct ScreenVertex
+    {
+        float x, y, z;
+        float u, v;
+    };
+
+    float EdgeFunction(const ScreenVertex& a, const ScreenVertex& b, float px, float py)
+    {
+        return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+    }
+
+    // Rasterizes one triangle with nearest texel sampling, an alpha test and alpha blending like the GL preview does
+    void RasterizeTriangle(const ScreenVertex& a, const ScreenVertex& b, const ScreenVertex& c,
+        const Image& texture, Image& target, std::vector<float>& depth)
+    {
+        float area = EdgeFunction(a, b, c.x, c.y);
+        if (std::fabs(area) < 1e-6f)
+            return;
+
+        int minX = std::max(0, (int)std::floor(std::min({ a.x, b.x, c.x })));
+        int maxX = std::min(target.width - 1, (int)std::ceil(std::max({ a.x, b.x, c.x })));
+        int minY = std::max(0, (int)std::floor(std::min({ a.y, b.y, c.y })));
+        int maxY = std::min(target.height - 1, (int)std::ceil(std::max({ a.y, b.y, c.y })));
+
+        for (int py = minY; py <= maxY; ++py)
+        {
+            for (int px = minX; px <= maxX; ++px)
+            {
+                float sx = px + 0.5f;
+                float sy = py + 0.5f;
+
+                float w0 = EdgeFunction(b, c, sx, sy) / area;
+                float w1 = EdgeFunction(c, a, sx, sy) / area;
+                float w2 = EdgeFunction(a, b, sx, sy) / area;
+
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                    continue;
+
+                size_t index = static_cast<size_t>(py) * target.width + px;
+
+                float z = w0 * a.z + w1 * b.z + w2 * c.z;
+                if (z <= depth[index])
+                    continue;
+
+                float u = w0 * a.u + w1 * b.u + w2 * c.u;
+                float v = w0 * a.v + w1 * b.v + w2 * c.v;
+
+                int tx = std::clamp((int)(u * texture.width), 0, texture.width - 1);
+                int ty = std::clamp((int)(v * texture.height), 0, texture.height - 1);
+                const unsigned char* texel = &texture.pixels[(static_cast<size_t>(ty) * texture.width + tx) * 4];
+
+                // same as glAlphaFunc(GL_GREATER, 0.01f)
+                if (texel[3] <= 2)
+                    continue;
+
+                unsigned char* pixel = &target.pixels[index * 4];
+                float alpha = texel[3] / 255.0f;
+
+                for (int i = 0; i < 3; ++i)
+                    pixel[i] = static_cast<unsigned char>(texel[i] * alpha + pixel[i] * (1.0f - alpha) + 0.5f);
+                pixel[3] = static_cast<unsigned char>(std::min(255.0f, texel[3] + pixel[3] * (1.0f - alpha) + 0.5f));
+
+                depth[index] = z;
+            }
+        }
+    }
+}
+
+Image SkinRasterizer::Render(const SkinModel& model, const Image& texture, const SkinView& view, int width, int height)
+{
+    Image target(width, height);
+    if (texture.empty() || width <= 0 || height <= 0)
+        return target;
+
+    std::vector<SkinVertex> vertices;
+    model.AppendVertices(vertices);
+    if (vertices.empty())
+        return target;
+
+    const float yaw = view.yaw * (float)M_PI / 180.0f;
+    const float pitch = view.pitch * (float)M_PI / 180.0f;
+    const float cosYaw = std::cos(yaw), sinYaw = std::sin(yaw);
+    const float cosPitch = std::cos(pitch), sinPitch = std::sin(pitch);
+
+    // rotate like the preview's glRotatef(pitch, 1, 0, 0) * glRotatef(yaw, 0, 1, 0)
+    std::vector<ScreenVertex> screen;
+    screen.reserve(vertices.size());
+
+    float minX = std::numeric_limits<float>::max(), maxX = std::numeric_limits<float>::lowest();
+    float minY = minX, maxY = maxX;
+
+    for (const SkinVertex& vertex : vertices)
+    {
+        float x = vertex.x * cosYaw + vertex.z * sinYaw;
+        float z = -vertex.x * sinYaw + vertex.z * cosYaw;
+        float y = vertex.y * cosPitch - z * sinPitch;
+        z = vertex.y * sinPitch + z * cosPitch;
+
+        minX = std::min(minX, x); maxX = std::max(maxX, x);
+        minY = std::min(minY, y); maxY = std::max(maxY, y);
+
+        screen.push_back({ x, y, z, vertex.u, vertex.v });
+    }
+
+    // fit the model into the image with a small margin, keeping its aspect ratio
+    const float margin = 0.05f;
+    float scale = std::min(width * (1.0f - 2 * margin) / std::max(maxX - minX, 1e-3f),
+        height * (1.0f - 2 * margin) / std::max(maxY - minY, 1e-3f));
+    float centerX = (minX + maxX) * 0.5f;
+    float centerY = (minY + maxY) * 0.5f;
+
+    for (ScreenVertex& vertex : screen)
+    {
+        vertex.x = (vertex.x - centerX) * scale + width * 0.5f;
+        vertex.y = (centerY - vertex.y) * scale + height * 0.5f; // image rows go down
+    }
+
+    std::vector<float> depth(static_cast<size_t>(width) * height, std::numeric_limits<float>::lowest());
+
+    // every box face is a quad; draw order is kept so overlay layers blend over their base parts
+    for (size_t i = 0; i + 3 < screen.size(); i += 4)
+    {
+        RasterizeTriangle(screen[i], screen[i + 1], screen[i + 2], texture, target, depth);
+        RasterizeTriangle(screen[i], screen[i + 2], screen[i + 3], texture, target, depth);
+    }
+
+    return target;
+}
+
+Image SkinRasterizer::Render(const PCKAssetFile& skin, const SkinView& view, int width, int height)
+{
+    Image texture = Image::Decode(skin.getData(), skin.getFileSize());
+    if (texture.empty())
+        return {};
+
+    SkinModel model;
+    model.Build(*skin.getSkinMetadata());
+
+    return Render(model, texture, view, width, height);
+}
+
+const std::vector<SkinView>& SkinRasterizer::getDefaultViews()
+{
+    static const std::vector<SkinView> views{
+        { "front", 0.0f, 0.0f },
+        { "back", 180.0f, 0.0f }
+    };
+    return views;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "PCK/PCKAssetFile.h"
+#include "Skin/SkinModel.h"
+#include "Util/Image.h"
+
+// Camera angle for a headless skin render
+struct SkinView
+{
+    // Name of the view, used for output file names
+    std::string name;
+    // Rotation around the Y axis in degrees; 0 faces the front of the skin
+    float yaw{ 0.0f };
+    // Rotation around the X axis in degrees
+    float pitch{ 0.0f };
+};
+
+// CPU only rasterizer for skin models; needs no GPU, graphics context or display, so it's safe to run on many threads at once
+class SkinRasterizer
+{
+public:
+    // Renders a skin model with its decoded texture into an RGBA image, orthographic and fitted to the image size
+    static Image Render(const SkinModel& model, const Image& texture, const SkinView& view, int width, int height);
+
+    // Decodes a skin asset's texture and properties, then renders it; returns an empty image if the texture can't be decoded
+    static Image Render(const PCKAssetFile& skin, const SkinView& view, int width, int height);
+
+    // Gets the default front and back views
+    static const std::vector<SkinView>& getDefaultViews();
+};
@@ -0,0 +1,449 @@
+// pckpp-bench; times the hot paths of opening and saving packs over synthetic packs, and prints the results as JSON so runs can be compared
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <new>
+#include "Binary/Binary.h"
+#include "Binary/BinaryReader.h"
+#include "Binary/BinaryWriter.h"
+#include "PCK/PCKDeduplicator.h"
+#include "PCK/PCKFile.h"
+#include "PCK/PCKFileTree.h"
+#include "PCK/PCKGenerator.h"
+#include "Util/Hash.h"
+#include "Util/Log.h"
+#include "Util/Zlib.h"
+
+// Every allocation made through operator new, so each benchmark can report how much it allocates
+static std::atomic<uint64_t> gAllocationCount{ 0 };
+static std::atomic<uint64_t> gAllocatedBytes{ 0 };
+
+void* operator new(std::size_t size)
+{
+	gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+	if (void* memory = std::malloc(size ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+// Results of conversions get added here, so they can't be optimised away
+static volatile size_t gSink = 0;
+
+// What to run, and the shape of the synthetic pack it runs on
+struct Options
+{
+	PCKGenerator::Options pack{};
+	int iterations{ 10 };
+	std::filesystem::path tempDir{};
+	std::string outputPath{};
+	std::string filter{};
+};
+
+// Timings and allocations of one benchmark, over every iteration
+struct Measurement
+{
+	std::string name{};
+	std::vector<double> seconds{};
+	uint64_t allocations{ 0 };
+	uint64_t allocatedBytes{ 0 };
+	uint64_t items{ 0 }; // per iteration
+	uint64_t bytes{ 0 }; // per iteration
+};
+
+static void PrintUsage()
+{
+	printf(
+		"Usage: pckpp-bench [options]\n"
+		"\n"
+		"Options:\n"
+		"      --seed <number>          Seed of the synthetic pack (default: 1)\n"
+		"  -n, --files <count>          Files in the synthetic pack (default: 1000)\n"
+		"  -p, --properties <count>     Properties per file (default: 4)\n"
+		"  -s, --payload <bytes>        Data size of every file (default: 4096)\n"
+		"  -d, --depth <count>          Most folders a file is nested in (default: 3)\n"
+		"  -i, --iterations <count>     Timed runs of every benchmark (default: 10)\n"
+		"  -e, --endianness <little|big>\n"
+		"  -f, --filter <text>          Only runs benchmarks whose name contains text\n"
+		"  -t, --temp <dir>             Where the pack is written (default: the system temp directory)\n"
+		"  -o, --output <file>          Writes the JSON there instead of to stdout\n"
+		"  -h, --help                   Shows this message\n");
+}
+
+// Runs work once to warm up, then times it for every iteration; setup runs before each call and isn't measured
+static Measurement Measure(const std::string& name, const Options& options, uint64_t items, uint64_t bytes,
+	const std::function<void()>& work, const std::function<void()>& setup = nullptr)
+{
+	Measurement measurement;
+	measurement.name = name;
+	measurement.items = items;
+	measurement.bytes = bytes;
+
+	if (setup) setup();
+	work();
+
+	for (int i = 0; i < options.iterations; ++i)
+	{
+		if (setup) setup();
+
+		uint64_t allocations = gAllocationCount.load(std::memory_order_relaxed);
+		uint64_t allocatedBytes = gAllocatedBytes.load(std::memory_order_relaxed);
+		auto start = std::chrono::steady_clock::now();
+
+		work();
+
+		auto end = std::chrono::steady_clock::now();
+		measurement.allocations += gAllocationCount.load(std::memory_order_relaxed) - allocations;
+		measurement.allocatedBytes += gAllocatedBytes.load(std::memory_order_relaxed) - allocatedBytes;
+		measurement.seconds.push_back(std::chrono::duration<double>(end - start).count());
+	}
+
+	fprintf(stderr, "%-28s %10.3f ms\n", name.c_str(), *std::min_element(measurement.seconds.begin(), measurement.seconds.end()) * 1000.0);
+	return measurement;
+}
+
+// Escapes the few characters the names could need in a JSON string
+static std::string EscapeJSON(const std::string& text)
+{
+	std::string escaped;
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\')
+			escaped += '\\';
+		escaped += c;
+	}
+	return escaped;
+}
+
+static void WriteJSON(FILE* out, const Options& options, const std::vector<Measurement>& measurements)
+{
+	fprintf(out, "{\n");
+	fprintf(out, "  \"config\": {\n");
+	fprintf(out, "    \"seed\": %llu,\n", (unsigned long long)options.pack.seed);
+	fprintf(out, "    \"files\": %zu,\n", options.pack.fileCount);
+	fprintf(out, "    \"propertiesPerFile\": %zu,\n", options.pack.maxPropertiesPerFile);
+	fprintf(out, "    \"payloadSize\": %zu,\n", options.pack.maxPayloadSize);
+	fprintf(out, "    \"folderDepth\": %zu,\n", options.pack.folderDepth);
+	fprintf(out, "    \"iterations\": %d,\n", options.iterations);
+	fprintf(out, "    \"endianness\": \"%s\"\n", options.pack.endianness == Binary::Endianness::BIG ? "big" : "little");
+	fprintf(out, "  },\n");
+	fprintf(out, "  \"results\": [");
+
+	for (size_t i = 0; i < measurements.size(); ++i)
+	{
+		const Measurement& m = measurements[i];
+
+		std::vector<double> sorted = m.seconds;
+		std::sort(sorted.begin(), sorted.end());
+
+		double total = 0.0;
+		for (double seconds : sorted)
+			total += seconds;
+
+		double min = sorted.empty() ? 0.0 : sorted.front();
+		double median = sorted.empty() ? 0.0 : sorted[sorted.size() / 2];
+		double mean = sorted.empty() ? 0.0 : total / sorted.size();
+		double runs = sorted.empty() ? 1.0 : (double)sorted.size();
+
+		fprintf(out, "%s\n    {\n", i == 0 ? "" : ",");
+		fprintf(out, "      \"name\": \"%s\",\n", EscapeJSON(m.name).c_str());
+		fprintf(out, "      \"iterations\": %zu,\n", sorted.size());
+		fprintf(out, "      \"minSeconds\": %.9f,\n", min);
+		fprintf(out, "      \"medianSeconds\": %.9f,\n", median);
+		fprintf(out, "      \"meanSeconds\": %.9f,\n", mean);
+		fprintf(out, "      \"items\": %llu,\n", (unsigned long long)m.items);
+		fprintf(out, "      \"itemsPerSecond\": %.1f,\n", median > 0.0 ? m.items / median : 0.0);
+		fprintf(out, "      \"bytes\": %llu,\n", (unsigned long long)m.bytes);
+		fprintf(out, "      \"bytesPerSecond\": %.1f,\n", median > 0.0 ? m.bytes / median : 0.0);
+		fprintf(out, "      \"allocations\": %.1f,\n", m.allocations / runs);
+		fprintf(out, "      \"allocatedBytes\": %.1f\n", m.allocatedBytes / runs);
+		fprintf(out, "    }");
+	}
+
+	fprintf(out, "\n  ]\n}\n");
+}
+
+static bool ParseSize(const char* text, size_t& value)
+{
+	char* end = nullptr;
+	unsigned long long parsed = std::strtoull(text, &end, 10);
+	if (!end || end == text || *end != '\0')
+		return false;
+	value = static_cast<size_t>(parsed);
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	options.tempDir = std::filesystem::temp_directory_path();
+
+	// exact sizes, so results only change when the code does
+	options.pack.minPropertiesPerFile = options.pack.maxPropertiesPerFile = 4;
+	options.pack.minPayloadSize = options.pack.maxPayloadSize = 4096;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		bool valid = true;
+
+		if (arg == "-h" || arg == "--help")
+		{
+			PrintUsage();
+			return 0;
+		}
+		else if (arg == "--seed" && hasValue)
+		{
+			size_t seed = 0;
+			valid = ParseSize(argv[++i], seed);
+			options.pack.seed = seed;
+		}
+		else if ((arg == "-n" || arg == "--files") && hasValue)
+			valid = ParseSize(argv[++i], options.pack.fileCount);
+		else if ((arg == "-p" || arg == "--properties") && hasValue)
+		{
+			valid = ParseSize(argv[++i], options.pack.maxPropertiesPerFile);
+			options.pack.minPropertiesPerFile = options.pack.maxPropertiesPerFile;
+		}
+		else if ((arg == "-s" || arg == "--payload") && hasValue)
+		{
+			valid = ParseSize(argv[++i], options.pack.maxPayloadSize);
+			options.pack.minPayloadSize = options.pack.maxPayloadSize;
+		}
+		else if ((arg == "-d" || arg == "--depth") && hasValue)
+			valid = ParseSize(argv[++i], options.pack.folderDepth);
+		else if ((arg == "-i" || arg == "--iterations") && hasValue)
+		{
+			size_t iterations = 0;
+			valid = ParseSize(argv[++i], iterations) && iterations > 0;
+			options.iterations = static_cast<int>(iterations);
+		}
+		else if ((arg == "-e" || arg == "--endianness") && hasValue)
+		{
+			std::string text = argv[++i];
+			if (text == "little" || text == "le")
+				options.pack.endianness = Binary::Endianness::LITTLE;
+			else if (text == "big" || text == "be")
+				options.pack.endianness = Binary::Endianness::BIG;
+			else
+				valid = false;
+		}
+		else if ((arg == "-f" || arg == "--filter") && hasValue)
+			options.filter = argv[++i];
+		else if ((arg == "-t" || arg == "--temp") && hasValue)
+			options.tempDir = argv[++i];
+		else if ((arg == "-o" || arg == "--output") && hasValue)
+			options.outputPath = argv[++i];
+		else
+		{
+			fprintf(stderr, "Unknown option: %s\n\n", arg.c_str());
+			PrintUsage();
+			return 1;
+		}
+
+		if (!valid)
+		{
+			fprintf(stderr, "Invalid value for %s: %s\n", arg.c_str(), argv[i]);
+			return 1;
+		}
+	}
+
+	// measures the parser, not the console
+	Log::SetLevel(Log::Level::Warning);
+
+	std::filesystem::path packPath = options.tempDir / "pckpp-bench.pck";
+	std::filesystem::path stringsPath = options.tempDir / "pckpp-bench-strings.bin";
+
+	std::vector<Measurement> measurements;
+	auto shouldRun = [&](const std::string& name) {
+		return options.filter.empty() || name.find(options.filter) != std::string::npos;
+	};
+
+	try {
+		PCKFile pckFile;
+		PCKGenerator::Generate(options.pack, pckFile);
+
+		uint64_t fileCount = pckFile.getFiles().size();
+		pckFile.Write(packPath.string(), options.pack.endianness);
+		uint64_t packSize = std::filesystem::file_size(packPath);
+
+		if (shouldRun("PCKFile::Write"))
+			measurements.push_back(Measure("PCKFile::Write", options, fileCount, packSize, [&] {
+				pckFile.Write(packPath.string(), options.pack.endianness);
+			}));
+
+		if (shouldRun("PCKFile::Read"))
+		{
+			std::unique_ptr<PCKFile> readFile;
+			measurements.push_back(Measure("PCKFile::Read", options, fileCount, packSize,
+				[&] { readFile->Read(packPath.string()); },
+				[&] { readFile = std::make_unique<PCKFile>(); }));
+		}
+
+		std::vector<FileTreeNode> tree = BuildFileTree(pckFile);
+
+		if (shouldRun("BuildFileTree"))
+			measurements.push_back(Measure("BuildFileTree", options, fileCount, 0, [&] {
+				tree = BuildFileTree(pckFile);
+			}));
+
+		if (shouldRun("FindNodeByPath"))
+		{
+			// a spread of at most 1000 paths, since every lookup walks the tree
+			std::vector<std::string> lookups;
+			size_t step = std::max<size_t>(1, pckFile.getFiles().size() / 1000);
+			for (size_t i = 0; i < pckFile.getFiles().size(); i += step)
+				lookups.push_back(std::filesystem::path(pckFile.getFiles()[i].getPath()).string());
+
+			measurements.push_back(Measure("FindNodeByPath", options, lookups.size(), 0, [&] {
+				for (const std::string& path : lookups)
+					if (!FindNodeByPath(path, tree))
+						throw std::runtime_error("FindNodeByPath missed " + path);
+			}));
+		}
+
+		// every path and property value of the pack, as the UI and PCKFile convert them
+		std::vector<std::string> utf8Strings;
+		std::vector<std::u16string> utf16Strings;
+		uint64_t utf8Bytes = 0, utf16Bytes = 0;
+
+		for (const PCKAssetFile& file : pckFile.getFiles())
+		{
+			utf8Strings.push_back(file.getPath());
+			utf8Bytes += file.getPath().size();
+
+			for (const auto& [key, value] : file.getProperties())
+			{
+				utf16Strings.push_back(value);
+				utf16Bytes += value.size() * sizeof(char16_t);
+			}
+		}
+
+		if (shouldRun("Binary::ToUTF16"))
+			measurements.push_back(Measure("Binary::ToUTF16", options, utf8Strings.size(), utf8Bytes, [&] {
+				for (const std::string& text : utf8Strings)
+					gSink = gSink + Binary::ToUTF16(text).size();
+			}));
+
+		if (shouldRun("Binary::ToUTF8"))
+			measurements.push_back(Measure("Binary::ToUTF8", options, utf16Strings.size(), utf16Bytes, [&] {
+				for (const std::u16string& text : utf16Strings)
+					gSink = gSink + Binary::ToUTF8(text).size();
+			}));
+
+		if (shouldRun("BinaryReader::ReadU16String"))
+		{
+			{
+				BinaryWriter writer(stringsPath.string());
+				writer.SetEndianness(options.pack.endianness);
+				for (const std::u16string& text : utf16Strings)
+					writer.WriteU16String(text);
+			}
+
+			measurements.push_back(Measure("BinaryReader::ReadU16String", options, utf16Strings.size(), utf16Bytes, [&] {
+				BinaryReader reader(stringsPath.string());
+				reader.SetEndianness(options.pack.endianness);
+				for (const std::u16string& text : utf16Strings)
+					gSink = gSink + reader.ReadU16String(text.size()).size();
+			}));
+		}
+
+		if (shouldRun("Zlib::"))
+		{
+			// the pack as written, since that's the kind of data the game compresses
+			std::vector<unsigned char> packData;
+			pckFile.Write(packData, options.pack.endianness);
+			std::vector<unsigned char> compressed = Zlib::Deflate(packData.data(), packData.size());
+
+			if (shouldRun("Zlib::Deflate"))
+				measurements.push_back(Measure("Zlib::Deflate", options, 1, packData.size(), [&] {
+					gSink = gSink + Zlib::Deflate(packData.data(), packData.size()).size();
+				}));
+
+			if (shouldRun("Zlib::Inflate"))
+				measurements.push_back(Measure("Zlib::Inflate", options, 1, packData.size(), [&] {
+					Zlib::Inflate(compressed.data(), compressed.size(), [](const unsigned char*, size_t size) {
+						gSink = gSink + size;
+					});
+				}));
+		}
+
+		if (shouldRun("Hash::XXH64"))
+		{
+			uint64_t dataBytes = 0;
+			for (const PCKAssetFile& file : pckFile.getFiles())
+				dataBytes += file.getFileSize();
+
+			measurements.push_back(Measure("Hash::XXH64", options, fileCount, dataBytes, [&] {
+				for (const PCKAssetFile& file : pckFile.getFiles())
+					gSink = gSink + Hash::XXH64(file.getData(), file.getFileSize());
+			}));
+		}
+
+		if (shouldRun("PCKDeduplicator::FindDuplicates"))
+		{
+			std::vector<PCKDeduplicator::Entry> entries;
+			for (PCKAssetFile& file : pckFile.getFiles())
+				entries.push_back({ &file, "bench" });
+
+			measurements.push_back(Measure("PCKDeduplicator::FindDuplicates", options, fileCount, 0, [&] {
+				gSink = gSink + PCKDeduplicator::FindDuplicates(entries).groups.size();
+			}));
+		}
+	}
+	catch (const std::exception& e) {
+		fprintf(stderr, "Benchmark failed: %s\n", e.what());
+
+		std::error_code error;
+		std::filesystem::remove(packPath, error);
+		std::filesystem::remove(stringsPath, error);
+		return 1;
+	}
+
+	std::error_code error;
+	std::filesystem::remove(packPath, error);
+	std::filesystem::remove(stringsPath, error);
+
+	FILE* out = stdout;
+	if (!options.outputPath.empty())
+	{
+		out = fopen(options.outputPath.c_str(), "w");
+		if (!out)
+		{
+			fprintf(stderr, "Could not open %s for writing\n", options.outputPath.c_str());
+			return 1;
+		}
+	}
+
+	WriteJSON(out, options, measurements);
+
+	if (out != stdout)
+		fclose(out);
+
+	return 0;
+}
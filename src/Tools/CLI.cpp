@@ -0,0 +1,901 @@
+// pckpp-cli; scriptable batch operations on PCK files, for build servers and anything else without a window
+
+#include <atomic>
+#include <cstdarg>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include "Binary/Binary.h"
+#include "Formats/BehavioursFile.h"
+#include "Formats/MaterialsFile.h"
+#include "PCK/PCKDeduplicator.h"
+#include "PCK/PCKDiff.h"
+#include "PCK/PCKExtractor.h"
+#include "PCK/PCKFile.h"
+#include "PCK/PCKImporter.h"
+#include "Util/Log.h"
+#include "Util/ThreadPool.h"
+#include "Util/Trace.h"
+
+// Options shared by every command; each command only looks at the ones it needs
+struct Options
+{
+	std::filesystem::path outputDir{};
+	unsigned int threadCount{ 0 };
+	size_t inputCount{ 0 };
+	bool hasEndianness{ false };
+	Binary::Endianness endianness{ Binary::Endianness::LITTLE };
+	uint32_t version{ 3 };
+	bool xmlSupport{ false };
+	bool withProperties{ false };
+	std::string filePattern{ "*" };
+	std::string key{};
+	std::string value{};
+	std::string tracePath{};
+	std::string comparePath{}; // the new pack diff compares the input with
+	// only warnings and errors by default, so logging doesn't get mixed into the output
+	Log::Level logLevel{ Log::Level::Warning };
+};
+
+// What a command printed for one input, and whether it went well
+struct Result
+{
+	bool success{ true };
+	std::string output{};
+};
+
+using Command = void(*)(const std::string& input, const Options& options, Result& result);
+
+static void PrintUsage()
+{
+	printf(
+		"Usage: pckpp-cli <command> [options] <input>...\n"
+		"\n"
+		"Commands:\n"
+		"  info                Shows the version, endianness and contents summary of packs\n"
+		"  ls                  Lists the files of packs; -p also lists their properties\n"
+		"  extract             Extracts packs to <output>/<pack name>/; -p also writes UTF-16 <file>.txt property files\n"
+		"  pack                Packs directories to <output>/<directory name>.pck; <file>.txt next to a file are its properties\n"
+		"  convert-endianness  Rewrites packs in the given endianness, or the other one if none is given\n"
+		"  set-property        Sets a property on every file matching -f in packs\n"
+		"  verify              Checks that packs read, and write back without losing anything; so do their entity materials and behaviours\n"
+		"  diff                Lists what was added, removed, renamed and changed from the first pack to the second; -p also lists changed property values\n"
+		"  dupes               Lists files with identical data in packs and the packs nested in them; a directory input is searched as one, across every pack in it\n"
+		"\n"
+		"Options:\n"
+		"  -o, --output <dir>       Output directory; packs are changed in place when not given\n"
+		"  -j, --threads <count>    Worker threads (default: one per hardware thread)\n"
+		"  -e, --endianness <little|big>\n"
+		"  -p, --properties         Includes properties\n"
+		"  -f, --file <pattern>     File path to match, * and ? are wildcards (default: *)\n"
+		"  -k, --key <key>          Property key\n"
+		"  -v, --value <value>      Property value\n"
+		"      --version <0-3>      PCK version for pack (default: 3)\n"
+		"      --xml                Enables full BOX support for pack\n"
+		"      --trace <file>       Records where the time went as Chrome trace JSON, if tracing was compiled in\n"
+		"      --log-level <debug|info|warning|error|none>\n"
+		"                           What gets logged to the console; debug dumps every entry of read packs (default: warning)\n"
+		"  -h, --help               Shows this message\n");
+}
+
+// printf, but appended to a string, so the output of concurrent inputs doesn't interleave
+static void Appendf(std::string& out, const char* format, ...)
+{
+	char buffer[1024];
+
+	va_list args;
+	va_start(args, format);
+	int length = vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+
+	if (length < 0)
+		return;
+
+	if (static_cast<size_t>(length) < sizeof(buffer))
+	{
+		out.append(buffer, length);
+		return;
+	}
+
+	std::vector<char> large(length + 1);
+	va_start(args, format);
+	vsnprintf(large.data(), large.size(), format, args);
+	va_end(args);
+	out.append(large.data(), length);
+}
+
+static const char* GetEndiannessName(Binary::Endianness endianness)
+{
+	return endianness == Binary::Endianness::BIG ? "Big" : "Little";
+}
+
+// Matches * and ? wildcards
+static bool MatchesPattern(const char* pattern, const char* text)
+{
+	if (*pattern == '\0')
+		return *text == '\0';
+	if (*pattern == '*')
+		return MatchesPattern(pattern + 1, text) || (*text != '\0' && MatchesPattern(pattern, text + 1));
+	if (*text != '\0' && (*pattern == '?' || *pattern == *text))
+		return MatchesPattern(pattern + 1, text + 1);
+	return false;
+}
+
+// Makes sure a path from inside a pack can't be used to write outside of the output directory
+static bool IsSafeRelativePath(const std::filesystem::path& path)
+{
+	if (path.empty() || path.is_absolute() || path.has_root_name())
+		return false;
+
+	for (const auto& part : path)
+	{
+		if (part == "..")
+			return false;
+	}
+	return true;
+}
+
+// Writes a pack next to its target first, so a failed write never leaves a broken pack behind
+static void WritePCKFile(PCKFile& pckFile, const std::filesystem::path& outpath, Binary::Endianness endianness)
+{
+	std::filesystem::path tempPath = outpath;
+	tempPath += ".tmp";
+
+	try {
+		pckFile.Write(tempPath.string(), endianness);
+		std::filesystem::rename(tempPath, outpath);
+	}
+	catch (...) {
+		std::error_code error;
+		std::filesystem::remove(tempPath, error);
+		throw;
+	}
+}
+
+// Gets where a changed pack goes; in place unless an output directory was given
+static std::filesystem::path GetOutputPath(const std::string& input, const Options& options)
+{
+	if (options.outputDir.empty())
+		return input;
+
+	std::filesystem::create_directories(options.outputDir);
+	return options.outputDir / std::filesystem::path(input).filename();
+}
+
+// Reads "key value" lines, from UTF-8 or UTF-16 text with or without a BOM
+static std::vector<PCKAssetFile::Property> ReadPropertiesFile(const std::filesystem::path& path)
+{
+	std::ifstream in(path, std::ios::binary);
+	std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	std::u16string text;
+
+	bool bigEndian = bytes.size() >= 2 && bytes[0] == 0xFE && bytes[1] == 0xFF;
+	bool littleEndian = bytes.size() >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE;
+
+	// UTF-16 without a BOM, like the property files the editor writes, has a zero after every ASCII character
+	if (!bigEndian && !littleEndian && bytes.size() >= 2 && bytes.size() % 2 == 0 && bytes[0] != 0 && bytes[1] == 0)
+		littleEndian = true;
+
+	if (bigEndian || littleEndian)
+	{
+		size_t start = (bytes.size() >= 2 && (bytes[0] == 0xFE || bytes[0] == 0xFF) && (bytes[1] == 0xFE || bytes[1] == 0xFF)) ? 2 : 0;
+		for (size_t i = start; i + 1 < bytes.size(); i += 2)
+			text += bigEndian ? char16_t((bytes[i] << 8) | bytes[i + 1]) : char16_t(bytes[i] | (bytes[i + 1] << 8));
+	}
+	else
+	{
+		size_t start = (bytes.size() >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) ? 3 : 0;
+		text = Binary::ToUTF16(std::string(bytes.begin() + start, bytes.end()));
+	}
+
+	std::vector<PCKAssetFile::Property> properties;
+
+	size_t lineStart = 0;
+	while (lineStart < text.size())
+	{
+		size_t lineEnd = text.find(u'\n', lineStart);
+		if (lineEnd == std::u16string::npos)
+			lineEnd = text.size();
+
+		std::u16string line = text.substr(lineStart, lineEnd - lineStart);
+		lineStart = lineEnd + 1;
+
+		if (!line.empty() && line.back() == u'\r')
+			line.pop_back();
+		if (line.empty())
+			continue;
+
+		size_t keyEnd = line.find_first_of(u" \t");
+		std::u16string key = line.substr(0, keyEnd);
+		std::u16string value;
+
+		if (keyEnd != std::u16string::npos)
+		{
+			size_t valueStart = line.find_first_not_of(u" \t", keyEnd);
+			if (valueStart != std::u16string::npos)
+				value = line.substr(valueStart);
+		}
+
+		// Strip trailing colon, if any
+		if (!key.empty() && key.back() == u':')
+			key.pop_back();
+
+		if (!key.empty())
+			properties.emplace_back(Binary::ToUTF8(key), value);
+	}
+
+	return properties;
+}
+
+static void RunInfo(const std::string& input, const Options&, Result& result)
+{
+	PCKFile pckFile;
+	pckFile.Read(input);
+
+	uint64_t totalSize = 0;
+	std::map<PCKAssetFile::Type, size_t> typeCounts;
+	for (const PCKAssetFile& file : pckFile.getFiles())
+	{
+		totalSize += file.getFileSize();
+		++typeCounts[file.getAssetType()];
+	}
+
+	Appendf(result.output, "%s\n", input.c_str());
+	Appendf(result.output, "  Version:       %u\n", pckFile.getPCKVersion());
+	Appendf(result.output, "  Endianness:    %s\n", GetEndiannessName(pckFile.getEndianness()));
+	Appendf(result.output, "  XML Support:   %s\n", pckFile.getXMLSupport() ? "yes" : "no");
+	Appendf(result.output, "  Property keys: %zu\n", pckFile.getPropertyKeys().size());
+	Appendf(result.output, "  Files:         %zu (%llu bytes)\n", pckFile.getFiles().size(), (unsigned long long)totalSize);
+
+	for (const auto& [type, count] : typeCounts)
+		Appendf(result.output, "    %-18s %zu\n", PCKAssetFile::getAssetTypeString(type), count);
+}
+
+static void RunList(const std::string& input, const Options& options, Result& result)
+{
+	PCKFile pckFile;
+	pckFile.Read(input);
+
+	Appendf(result.output, "%s\n", input.c_str());
+
+	for (const PCKAssetFile& file : pckFile.getFiles())
+	{
+		Appendf(result.output, "%10zu  %-18s %s\n", file.getFileSize(), file.getAssetTypeString(), file.getPath().c_str());
+
+		if (options.withProperties)
+		{
+			for (const auto& [key, value] : file.getProperties())
+				Appendf(result.output, "%30s%s %s\n", "", key.c_str(), Binary::ToUTF8(value).c_str());
+		}
+	}
+}
+
+static void RunExtract(const std::string& input, const Options& options, Result& result)
+{
+	PCKFile pckFile;
+	pckFile.Read(input);
+
+	std::filesystem::path outputDir = options.outputDir.empty() ? std::filesystem::path(".") : options.outputDir;
+	std::filesystem::path packDir = outputDir / std::filesystem::path(input).stem();
+
+	std::vector<PCKExtractor::Entry> entries;
+	for (const PCKAssetFile& file : pckFile.getFiles())
+	{
+		std::filesystem::path relativePath = std::filesystem::u8path(file.getPath());
+		if (!IsSafeRelativePath(relativePath))
+		{
+			Appendf(result.output, "  Skipped unsafe path: %s\n", file.getPath().c_str());
+			result.success = false;
+			continue;
+		}
+
+		entries.push_back({ &file, packDir / relativePath });
+	}
+
+	// packs are already spread over the pool, so only a lone pack gets writers of its own
+	unsigned int writerCount = options.inputCount == 1 ? options.threadCount : 1;
+	PCKExtractor::Result extracted = PCKExtractor::Extract(entries, options.withProperties, nullptr, writerCount);
+
+	for (const PCKExtractor::Error& error : extracted.errors)
+		Appendf(result.output, "  Failed to write %s: %s\n", error.outPath.string().c_str(), error.message.c_str());
+
+	if (!extracted.errors.empty())
+		result.success = false;
+
+	Appendf(result.output, "%s: extracted %zu file(s) to %s, %.1f MB at %.1f MB/s\n", input.c_str(), extracted.filesWritten,
+		packDir.string().c_str(), extracted.bytesWritten / (1024.0 * 1024.0), extracted.getThroughput());
+}
+
+static void RunPack(const std::string& input, const Options& options, Result& result)
+{
+	std::filesystem::path inputDir(input);
+	if (!std::filesystem::is_directory(inputDir))
+		throw std::runtime_error("Not a directory: " + input);
+
+	std::vector<std::filesystem::path> paths;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(inputDir))
+	{
+		if (entry.is_regular_file())
+			paths.push_back(entry.path());
+	}
+
+	// sorted, so packing the same directory always gives the same pack
+	std::sort(paths.begin(), paths.end());
+
+	std::vector<PCKImporter::Entry> entries;
+	std::map<std::string, std::filesystem::path> propertyFiles;
+
+	for (const std::filesystem::path& path : paths)
+	{
+		// <file>.txt next to <file> holds its properties, like extract -p writes them
+		if (path.extension() == ".txt")
+		{
+			std::filesystem::path owner = path;
+			owner.replace_extension();
+			if (std::binary_search(paths.begin(), paths.end(), owner))
+				continue;
+		}
+
+		std::string pckPath = std::filesystem::relative(path, inputDir).generic_u8string();
+		entries.push_back({ path, pckPath, PCKAssetFile::getPreferredAssetType(pckPath) });
+
+		std::filesystem::path propertiesPath = path;
+		propertiesPath += ".txt";
+		if (std::binary_search(paths.begin(), paths.end(), propertiesPath))
+			propertyFiles[pckPath] = propertiesPath;
+	}
+
+	// directories are already spread over the pool, so only a lone directory gets readers of its own
+	unsigned int readerCount = options.inputCount == 1 ? options.threadCount : 1;
+	PCKImporter::Result imported = PCKImporter::Read(entries, nullptr, readerCount);
+
+	if (!imported.errors.empty())
+	{
+		for (const PCKImporter::Error& error : imported.errors)
+			Appendf(result.output, "  Failed to read %s: %s\n", error.diskPath.string().c_str(), error.message.c_str());
+		throw std::runtime_error("not packed, " + std::to_string(imported.errors.size()) + " file(s) couldn't be read");
+	}
+
+	for (PCKAssetFile& file : imported.files)
+	{
+		auto propertyFile = propertyFiles.find(file.getPath());
+		if (propertyFile == propertyFiles.end())
+			continue;
+
+		for (const auto& [key, value] : ReadPropertiesFile(propertyFile->second))
+			file.addProperty(key, value);
+	}
+
+	PCKFile pckFile;
+	pckFile.setPCKVersion(options.version);
+	pckFile.setXMLSupport(options.xmlSupport);
+	pckFile.addFiles(std::move(imported.files));
+
+	std::filesystem::path outputDir = options.outputDir.empty() ? std::filesystem::path(".") : options.outputDir;
+	std::filesystem::create_directories(outputDir);
+
+	std::filesystem::path outPath = outputDir / (inputDir.filename().string() + ".pck");
+	if (inputDir.filename().empty())
+		outPath = outputDir / (inputDir.parent_path().filename().string() + ".pck");
+
+	Binary::Endianness endianness = options.hasEndianness ? options.endianness : Binary::Endianness::LITTLE;
+	WritePCKFile(pckFile, outPath, endianness);
+
+	Appendf(result.output, "%s: packed %zu file(s) into %s (%s Endian, version %u)\n",
+		input.c_str(), pckFile.getFiles().size(), outPath.string().c_str(), GetEndiannessName(endianness), options.version);
+}
+
+static void RunConvertEndianness(const std::string& input, const Options& options, Result& result)
+{
+	Binary::Endianness from = PCKFile::ReadEndianness(input);
+	Binary::Endianness to = options.hasEndianness ? options.endianness
+		: (from == Binary::Endianness::LITTLE ? Binary::Endianness::BIG : Binary::Endianness::LITTLE);
+
+	std::filesystem::path outPath = GetOutputPath(input, options);
+	std::filesystem::path tempPath = outPath;
+	tempPath += ".tmp";
+
+	// streamed, so the pack is never loaded as a whole
+	try {
+		PCKFile::ConvertEndianness(input, tempPath.string(), to);
+		std::filesystem::rename(tempPath, outPath);
+	}
+	catch (...) {
+		std::error_code error;
+		std::filesystem::remove(tempPath, error);
+		throw;
+	}
+
+	Appendf(result.output, "%s: %s -> %s Endian, written to %s\n", input.c_str(), GetEndiannessName(from), GetEndiannessName(to), outPath.string().c_str());
+}
+
+static void RunSetProperty(const std::string& input, const Options& options, Result& result)
+{
+	PCKFile pckFile;
+	pckFile.Read(input);
+
+	std::u16string value = Binary::ToUTF16(options.value);
+	size_t changed = 0;
+
+	for (PCKAssetFile& file : pckFile.getFiles())
+	{
+		if (!MatchesPattern(options.filePattern.c_str(), file.getPath().c_str()))
+			continue;
+
+		const auto& properties = file.getProperties();
+
+		auto it = std::find_if(properties.begin(), properties.end(), [&](const PCKAssetFile::Property& property) {
+			return property.first == options.key;
+			});
+
+		if (it != properties.end())
+			file.setPropertyAtIndex(static_cast<int>(std::distance(properties.begin(), it)), options.key, value);
+		else
+			file.addProperty(options.key, value);
+
+		++changed;
+	}
+
+	if (changed > 0)
+		WritePCKFile(pckFile, GetOutputPath(input, options), pckFile.getEndianness());
+
+	Appendf(result.output, "%s: set %s on %zu file(s)\n", input.c_str(), options.key.c_str(), changed);
+}
+
+// Compares everything that survives a write; the property key table is rebuilt on write, so only the file properties are compared
+static bool ComparePCKFiles(const PCKFile& a, const PCKFile& b, std::string& difference)
+{
+	if (a.getXMLSupport() != b.getXMLSupport())
+	{
+		difference = "XML support differs";
+		return false;
+	}
+
+	if (a.getFiles().size() != b.getFiles().size())
+	{
+		difference = "file count differs";
+		return false;
+	}
+
+	for (size_t i = 0; i < a.getFiles().size(); ++i)
+	{
+		const PCKAssetFile& fileA = a.getFiles()[i];
+		const PCKAssetFile& fileB = b.getFiles()[i];
+
+		if (fileA.getPath() != fileB.getPath() || fileA.getAssetType() != fileB.getAssetType() ||
+			fileA.getProperties() != fileB.getProperties() || fileA.getFileSize() != fileB.getFileSize() ||
+			(fileA.getFileSize() && std::memcmp(fileA.getData(), fileB.getData(), fileA.getFileSize()) != 0))
+		{
+			difference = "file differs: " + fileA.getPath();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// How a typed asset did when read and written again on its own
+enum class TypedAssetResult
+{
+	NOT_TYPED, // not an asset that gets re-serialized
+	UNREADABLE,
+	CHANGED,
+	OK
+};
+
+// Reads a typed asset and writes it again, the way its editor does, checking nothing changed
+template<typename TFile>
+static TypedAssetResult RoundTripAsset(const PCKAssetFile& file, std::string& error)
+{
+	TFile typed;
+	try {
+		typed.Read(file.getData(), file.getFileSize());
+	}
+	catch (const std::exception& e) {
+		error = e.what();
+		return TypedAssetResult::UNREADABLE;
+	}
+
+	std::vector<unsigned char> written;
+	typed.Write(written);
+
+	if (written.size() != file.getFileSize() || (!written.empty() && std::memcmp(written.data(), file.getData(), written.size()) != 0))
+		return TypedAssetResult::CHANGED;
+
+	return TypedAssetResult::OK;
+}
+
+static TypedAssetResult VerifyTypedAsset(const PCKAssetFile& file, std::string& error)
+{
+	switch (file.getAssetType())
+	{
+	case PCKAssetFile::Type::MATERIALS:
+		return RoundTripAsset<MaterialsFile>(file, error);
+	case PCKAssetFile::Type::BEHAVIOURS:
+		return RoundTripAsset<BehavioursFile>(file, error);
+	default:
+		return TypedAssetResult::NOT_TYPED;
+	}
+}
+
+static void RunVerify(const std::string& input, const Options&, Result& result)
+{
+	PCKFile pckFile;
+	pckFile.Read(input);
+
+	std::map<std::string, size_t> pathCounts;
+	for (const PCKAssetFile& file : pckFile.getFiles())
+		++pathCounts[file.getPath()];
+
+	for (const auto& [path, count] : pathCounts)
+	{
+		if (count > 1)
+			Appendf(result.output, "  Warning: %s is in the pack %zu times\n", path.c_str(), count);
+	}
+
+	size_t typedCount = 0;
+	size_t unreadableCount = 0;
+	for (const PCKAssetFile& file : pckFile.getFiles())
+	{
+		std::string error;
+		TypedAssetResult typedResult = VerifyTypedAsset(file, error);
+		if (typedResult == TypedAssetResult::NOT_TYPED)
+			continue;
+
+		++typedCount;
+
+		// assets that don't read are left alone by their editors, so they're only worth a warning
+		if (typedResult == TypedAssetResult::UNREADABLE)
+		{
+			Appendf(result.output, "  Warning: %s doesn't read: %s\n", file.getPath().c_str(), error.c_str());
+			++unreadableCount;
+		}
+		else if (typedResult == TypedAssetResult::CHANGED)
+		{
+			Appendf(result.output, "%s: FAILED, %s writes back differently\n", input.c_str(), file.getPath().c_str());
+			result.success = false;
+			return;
+		}
+	}
+
+	// write back to a temporary file and read that again
+	static std::atomic<unsigned int> gTempCounter{ 0 };
+	std::filesystem::path tempPath = std::filesystem::temp_directory_path() /
+		("pckpp-verify-" + std::to_string(gTempCounter++) + "-" + std::filesystem::path(input).filename().string());
+
+	std::string difference;
+	bool identical = false;
+	bool matches = false;
+
+	try {
+		pckFile.Write(tempPath.string(), pckFile.getEndianness());
+
+		PCKFile reread;
+		reread.Read(tempPath.string());
+		matches = ComparePCKFiles(pckFile, reread, difference);
+
+		std::ifstream original(input, std::ios::binary), written(tempPath, std::ios::binary);
+		identical = std::equal(std::istreambuf_iterator<char>(original), std::istreambuf_iterator<char>(),
+			std::istreambuf_iterator<char>(written), std::istreambuf_iterator<char>());
+	}
+	catch (...) {
+		std::error_code error;
+		std::filesystem::remove(tempPath, error);
+		throw;
+	}
+
+	std::error_code error;
+	std::filesystem::remove(tempPath, error);
+
+	if (!matches)
+	{
+		Appendf(result.output, "%s: FAILED, round trip lost data (%s)\n", input.c_str(), difference.c_str());
+		result.success = false;
+		return;
+	}
+
+	Appendf(result.output, "%s: OK, %zu file(s), round trip %s, %zu of %zu typed asset(s) round trip\n", input.c_str(), pckFile.getFiles().size(),
+		identical ? "byte identical" : "matches (property table was reordered)", typedCount - unreadableCount, typedCount);
+}
+
+static void RunDiff(const std::string& input, const Options& options, Result& result)
+{
+	// both packs are indexed at once, each hashing on half of the threads
+	unsigned int threadCount = options.threadCount > 0 ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+	unsigned int indexThreads = std::max(1u, threadCount / 2);
+
+	auto newFiles = std::async(std::launch::async, [&] { return PCKFile::ReadIndex(options.comparePath, nullptr, indexThreads); });
+	std::vector<PCKFile::IndexEntry> oldFiles = PCKFile::ReadIndex(input, nullptr, indexThreads);
+
+	PCKDiff diff;
+	diff.Compare(std::move(oldFiles), newFiles.get());
+
+	Appendf(result.output, "%s -> %s: %zu added, %zu removed, %zu renamed, %zu changed, %zu unchanged\n", input.c_str(), options.comparePath.c_str(),
+		diff.getChangeCount(PCKDiff::ChangeType::ADDED), diff.getChangeCount(PCKDiff::ChangeType::REMOVED), diff.getChangeCount(PCKDiff::ChangeType::RENAMED),
+		diff.getChangeCount(PCKDiff::ChangeType::CHANGED), diff.getUnchangedCount());
+
+	for (const PCKDiff::Change& change : diff.getChanges())
+	{
+		const PCKFile::IndexEntry* oldFile = change.oldFile != PCKDiff::NONE ? &diff.getOldFiles()[change.oldFile] : nullptr;
+		const PCKFile::IndexEntry* newFile = change.newFile != PCKDiff::NONE ? &diff.getNewFiles()[change.newFile] : nullptr;
+
+		switch (change.type)
+		{
+		case PCKDiff::ChangeType::ADDED:
+			Appendf(result.output, "  A  %s (%llu bytes)\n", newFile->path.c_str(), (unsigned long long)newFile->size);
+			continue;
+		case PCKDiff::ChangeType::REMOVED:
+			Appendf(result.output, "  D  %s (%llu bytes)\n", oldFile->path.c_str(), (unsigned long long)oldFile->size);
+			continue;
+		case PCKDiff::ChangeType::RENAMED:
+			Appendf(result.output, "  R  %s -> %s", oldFile->path.c_str(), newFile->path.c_str());
+			break;
+		default:
+			Appendf(result.output, "  M  %s", newFile->path.c_str());
+			break;
+		}
+
+		std::string details;
+		if (change.dataChanged)
+			details += ", data " + std::to_string(oldFile->size) + " -> " + std::to_string(newFile->size) + " bytes";
+		if (change.typeChanged)
+			details += std::string(", type ") + PCKAssetFile::getAssetTypeString(oldFile->type) + " -> " + PCKAssetFile::getAssetTypeString(newFile->type);
+		if (!change.properties.empty())
+			details += ", " + std::to_string(change.properties.size()) + " propert" + (change.properties.size() == 1 ? "y" : "ies");
+		Appendf(result.output, "%s%s%s\n", details.empty() ? "" : " (", details.empty() ? "" : details.c_str() + 2, details.empty() ? "" : ")");
+
+		if (!options.withProperties)
+			continue;
+
+		for (const PCKDiff::PropertyChange& property : change.properties)
+		{
+			if (!property.hasOld)
+				Appendf(result.output, "       + %s %s\n", property.key.c_str(), Binary::ToUTF8(property.newValue).c_str());
+			else if (!property.hasNew)
+				Appendf(result.output, "       - %s %s\n", property.key.c_str(), Binary::ToUTF8(property.oldValue).c_str());
+			else
+				Appendf(result.output, "       ~ %s %s -> %s\n", property.key.c_str(), Binary::ToUTF8(property.oldValue).c_str(), Binary::ToUTF8(property.newValue).c_str());
+		}
+	}
+}
+
+static void RunDuplicates(const std::string& input, const Options& options, Result& result)
+{
+	// every pack has to stay loaded until the search is done, since the entries point into them
+	std::vector<std::unique_ptr<PCKFile>> pckFiles;
+	std::vector<PCKDeduplicator::Entry> entries;
+
+	auto addPack = [&](const std::filesystem::path& path, const std::string& name) {
+		auto pckFile = std::make_unique<PCKFile>();
+		pckFile->Read(path.string());
+		PCKDeduplicator::CollectFiles(*pckFile, name, entries);
+		pckFiles.push_back(std::move(pckFile));
+	};
+
+	if (std::filesystem::is_directory(input))
+	{
+		std::vector<std::filesystem::path> paths;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(input))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".pck")
+				paths.push_back(entry.path());
+		}
+		std::sort(paths.begin(), paths.end());
+
+		for (const std::filesystem::path& path : paths)
+		{
+			try {
+				addPack(path, std::filesystem::relative(path, input).generic_string());
+			}
+			catch (const std::exception& e) {
+				Appendf(result.output, "  Warning: %s doesn't read: %s\n", path.string().c_str(), e.what());
+			}
+		}
+	}
+	else
+		addPack(input, std::filesystem::path(input).filename().string());
+
+	// inputs already run in parallel, so each only hashes on more than one thread when it's the only one
+	unsigned int threadCount = options.inputCount > 1 ? 1 : options.threadCount;
+	PCKDeduplicator::Result duplicates = PCKDeduplicator::FindDuplicates(entries, nullptr, threadCount);
+
+	Appendf(result.output, "%s: %zu pack(s), %zu file(s), %zu duplicate(s) of %zu file(s), %llu bytes wasted\n", input.c_str(), pckFiles.size(),
+		entries.size(), duplicates.getDuplicateCount(), duplicates.groups.size(), (unsigned long long)duplicates.getWastedSize());
+
+	for (const PCKDeduplicator::Group& group : duplicates.groups)
+	{
+		Appendf(result.output, "  %016llx  %zu bytes x %zu\n", (unsigned long long)group.hash, group.size, group.files.size());
+		for (const PCKDeduplicator::Entry& entry : group.files)
+			Appendf(result.output, "    %s: %s\n", entry.pack.c_str(), entry.file->getPath().c_str());
+	}
+}
+
+static bool ParseEndianness(const std::string& text, Binary::Endianness& endianness)
+{
+	if (text == "little" || text == "le")
+		endianness = Binary::Endianness::LITTLE;
+	else if (text == "big" || text == "be")
+		endianness = Binary::Endianness::BIG;
+	else
+		return false;
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	static const std::map<std::string, Command> commands{
+		{ "info", RunInfo },
+		{ "ls", RunList },
+		{ "extract", RunExtract },
+		{ "pack", RunPack },
+		{ "convert-endianness", RunConvertEndianness },
+		{ "set-property", RunSetProperty },
+		{ "verify", RunVerify },
+		{ "diff", RunDiff },
+		{ "dupes", RunDuplicates },
+	};
+
+	if (argc < 2 || std::strcmp(argv[1], "-h") == 0 || std::strcmp(argv[1], "--help") == 0)
+	{
+		PrintUsage();
+		return argc < 2 ? 1 : 0;
+	}
+
+	auto command = commands.find(argv[1]);
+	if (command == commands.end())
+	{
+		fprintf(stderr, "Unknown command: %s\n\n", argv[1]);
+		PrintUsage();
+		return 1;
+	}
+
+	Options options;
+	std::vector<std::string> inputs;
+
+	for (int i = 2; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "-h" || arg == "--help")
+		{
+			PrintUsage();
+			return 0;
+		}
+		else if ((arg == "-o" || arg == "--output") && hasValue)
+			options.outputDir = argv[++i];
+		else if ((arg == "-j" || arg == "--threads") && hasValue)
+			options.threadCount = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+		else if ((arg == "-e" || arg == "--endianness") && hasValue)
+		{
+			if (!ParseEndianness(argv[++i], options.endianness))
+			{
+				fprintf(stderr, "Invalid endianness: %s\n", argv[i]);
+				return 1;
+			}
+			options.hasEndianness = true;
+		}
+		else if (arg == "-p" || arg == "--properties")
+			options.withProperties = true;
+		else if ((arg == "-f" || arg == "--file") && hasValue)
+			options.filePattern = argv[++i];
+		else if ((arg == "-k" || arg == "--key") && hasValue)
+			options.key = argv[++i];
+		else if ((arg == "-v" || arg == "--value") && hasValue)
+			options.value = argv[++i];
+		else if (arg == "--version" && hasValue)
+		{
+			options.version = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+			if (options.version > 3)
+			{
+				fprintf(stderr, "Invalid version: %s\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (arg == "--xml")
+			options.xmlSupport = true;
+		else if (arg == "--trace" && hasValue)
+			options.tracePath = argv[++i];
+		else if (arg == "--log-level" && hasValue)
+		{
+			if (!Log::ParseLevel(argv[++i], options.logLevel))
+			{
+				fprintf(stderr, "Invalid log level: %s\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			fprintf(stderr, "Unknown option: %s\n\n", arg.c_str());
+			PrintUsage();
+			return 1;
+		}
+		else
+			inputs.push_back(arg);
+	}
+
+	if (inputs.empty())
+	{
+		fprintf(stderr, "No inputs given\n\n");
+		PrintUsage();
+		return 1;
+	}
+
+	// diff is the one command that takes its inputs together; the first is run against the second
+	if (command->first == "diff")
+	{
+		if (inputs.size() != 2)
+		{
+			fprintf(stderr, "diff needs two packs, the old one then the new one\n");
+			return 1;
+		}
+
+		options.comparePath = inputs[1];
+		inputs.resize(1);
+	}
+
+	if (command->first == "set-property" && options.key.empty())
+	{
+		fprintf(stderr, "set-property needs a key (-k)\n");
+		return 1;
+	}
+
+	Log::SetLevel(options.logLevel);
+
+	if (!options.tracePath.empty())
+	{
+		if (!Trace::IsCompiledIn())
+			fprintf(stderr, "Tracing wasn't compiled in, so %s won't be written\n", options.tracePath.c_str());
+		Trace::SetEnabled(true);
+	}
+	options.inputCount = inputs.size();
+
+	ThreadPool pool(options.threadCount);
+	std::vector<std::future<Result>> results;
+	results.reserve(inputs.size());
+
+	for (const std::string& input : inputs)
+	{
+		results.push_back(pool.Submit([run = command->second, input, &options] {
+			Result result;
+			try {
+				run(input, options, result);
+			}
+			catch (const std::exception& e) {
+				Appendf(result.output, "%s: %s\n", input.c_str(), e.what());
+				result.success = false;
+			}
+			return result;
+		}));
+	}
+
+	// printed in input order as they finish, so the output is the same no matter the thread count
+	size_t failed = 0;
+	for (auto& future : results)
+	{
+		Result result = future.get();
+		fputs(result.output.c_str(), result.success ? stdout : stderr);
+		if (!result.success)
+			++failed;
+	}
+
+	// so nothing logged by the inputs shows up after the summary
+	Log::Flush();
+
+	if (inputs.size() > 1)
+		printf("%zu input(s), %zu failed\n", inputs.size(), failed);
+
+	if (!options.tracePath.empty() && Trace::IsCompiledIn())
+	{
+		try {
+			Trace::WriteChromeTrace(options.tracePath);
+		}
+		catch (const std::exception& e) {
+			fprintf(stderr, "%s\n", e.what());
+			return 1;
+		}
+	}
+
+	return failed == 0 ? 0 : 1;
+}
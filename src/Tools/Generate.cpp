@@ -0,0 +1,158 @@
+// pckpp-gen; writes made up packs of any size from a seed, so benchmarks and stress tests can be rerun on the exact same input
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include "PCK/PCKGenerator.h"
+
+static void PrintUsage()
+{
+	printf(
+		"Usage: pckpp-gen [options] <output.pck>\n"
+		"\n"
+		"Options:\n"
+		"      --seed <number>             Seed every random choice comes from (default: 1)\n"
+		"  -n, --files <count>             Files in the pack (default: 1000)\n"
+		"  -d, --depth <count>             Most folders a file is nested in (default: 3)\n"
+		"      --fan-out <count>           Folders to pick from on every level (default: 8)\n"
+		"  -k, --keys <count>              Different property keys used (default: 16)\n"
+		"  -p, --properties <min>[:<max>]  Properties per file (default: 0:4)\n"
+		"      --value-length <min>[:<max>] Length of property values (default: 4:32)\n"
+		"  -s, --payload <min>[:<max>]     Data size of every file, in bytes (default: 256:4096)\n"
+		"      --textures-only             Only makes textures instead of every asset type\n"
+		"      --nested <count>            skins.pck, audio.pck and texture pack info entries with packs inside (default: 3)\n"
+		"      --nested-files <count>      Files in every nested pack (default: 16)\n"
+		"  -e, --endianness <little|big>\n"
+		"      --version <0-3>             PCK version (default: 3)\n"
+		"      --xml                       Sets the XMLVERSION flag for full BOX support\n"
+		"  -h, --help                      Shows this message\n");
+}
+
+static bool ParseSize(const char* text, size_t& value)
+{
+	char* end = nullptr;
+	unsigned long long parsed = std::strtoull(text, &end, 10);
+	if (!end || end == text || *end != '\0')
+		return false;
+	value = static_cast<size_t>(parsed);
+	return true;
+}
+
+// Parses "min:max", or a single number for both
+static bool ParseRange(const std::string& text, size_t& min, size_t& max)
+{
+	size_t colon = text.find(':');
+	if (colon == std::string::npos)
+		return ParseSize(text.c_str(), min) && ParseSize(text.c_str(), max);
+
+	return ParseSize(text.substr(0, colon).c_str(), min) && ParseSize(text.substr(colon + 1).c_str(), max) && min <= max;
+}
+
+int main(int argc, char* argv[])
+{
+	PCKGenerator::Options options;
+	std::string outputPath;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		bool valid = true;
+
+		if (arg == "-h" || arg == "--help")
+		{
+			PrintUsage();
+			return 0;
+		}
+		else if (arg == "--seed" && hasValue)
+		{
+			size_t seed = 0;
+			valid = ParseSize(argv[++i], seed);
+			options.seed = seed;
+		}
+		else if ((arg == "-n" || arg == "--files") && hasValue)
+			valid = ParseSize(argv[++i], options.fileCount);
+		else if ((arg == "-d" || arg == "--depth") && hasValue)
+			valid = ParseSize(argv[++i], options.folderDepth);
+		else if (arg == "--fan-out" && hasValue)
+			valid = ParseSize(argv[++i], options.folderFanOut) && options.folderFanOut > 0;
+		else if ((arg == "-k" || arg == "--keys") && hasValue)
+			valid = ParseSize(argv[++i], options.propertyKeyCount);
+		else if ((arg == "-p" || arg == "--properties") && hasValue)
+			valid = ParseRange(argv[++i], options.minPropertiesPerFile, options.maxPropertiesPerFile);
+		else if (arg == "--value-length" && hasValue)
+			valid = ParseRange(argv[++i], options.minValueLength, options.maxValueLength);
+		else if ((arg == "-s" || arg == "--payload") && hasValue)
+			valid = ParseRange(argv[++i], options.minPayloadSize, options.maxPayloadSize);
+		else if (arg == "--textures-only")
+			options.allTypes = false;
+		else if (arg == "--nested" && hasValue)
+			valid = ParseSize(argv[++i], options.nestedPackCount);
+		else if (arg == "--nested-files" && hasValue)
+			valid = ParseSize(argv[++i], options.nestedFileCount);
+		else if ((arg == "-e" || arg == "--endianness") && hasValue)
+		{
+			std::string text = argv[++i];
+			if (text == "little" || text == "le")
+				options.endianness = Binary::Endianness::LITTLE;
+			else if (text == "big" || text == "be")
+				options.endianness = Binary::Endianness::BIG;
+			else
+				valid = false;
+		}
+		else if (arg == "--version" && hasValue)
+		{
+			size_t version = 0;
+			valid = ParseSize(argv[++i], version) && version <= 3;
+			options.version = static_cast<uint32_t>(version);
+		}
+		else if (arg == "--xml")
+			options.xmlSupport = true;
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			fprintf(stderr, "Unknown option: %s\n\n", arg.c_str());
+			PrintUsage();
+			return 1;
+		}
+		else if (outputPath.empty())
+			outputPath = arg;
+		else
+		{
+			fprintf(stderr, "Only one output can be given\n");
+			return 1;
+		}
+
+		if (!valid)
+		{
+			fprintf(stderr, "Invalid value for %s: %s\n", arg.c_str(), argv[i]);
+			return 1;
+		}
+	}
+
+	if (outputPath.empty())
+	{
+		fprintf(stderr, "No output given\n\n");
+		PrintUsage();
+		return 1;
+	}
+
+	// version 0 reads back as Big Endian no matter what, so a Little Endian one could never be opened again
+	if (options.version == 0 && options.endianness == Binary::Endianness::LITTLE)
+		fprintf(stderr, "Warning: version 0 packs are always read as Big Endian\n");
+
+	try {
+		PCKFile pckFile;
+		PCKGenerator::Generate(options, pckFile);
+		pckFile.Write(outputPath, options.endianness);
+
+		printf("%s: %zu file(s), %llu bytes, %s Endian, version %u, seed %llu\n", outputPath.c_str(), pckFile.getFiles().size(),
+			(unsigned long long)std::filesystem::file_size(outputPath), options.endianness == Binary::Endianness::BIG ? "Big" : "Little",
+			options.version, (unsigned long long)options.seed);
+	}
+	catch (const std::exception& e) {
+		fprintf(stderr, "%s: %s\n", outputPath.c_str(), e.what());
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,177 @@
+// pckpp-skinrender; renders every skin of one or more packs to PNG files without a GPU or a display
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include "PCK/PCKFile.h"
+#include "Skin/SkinRasterizer.h"
+#include "Util/ThreadPool.h"
+
+static void PrintUsage()
+{
+	printf(
+		"Usage: pckpp-skinrender [options] <pack.pck>...\n"
+		"\n"
+		"Options:\n"
+		"  -o, --output <dir>           Output directory (default: current directory)\n"
+		"  -s, --size <width>x<height>  Image size of every render (default: 128x256)\n"
+		"  -j, --threads <count>        Worker threads (default: one per hardware thread)\n"
+		"  -v, --view <name>:<yaw>[:<pitch>]\n"
+		"                               Adds a camera angle in degrees; can be repeated (default: front:0 and back:180)\n"
+		"  -h, --help                   Shows this message\n"
+		"\n"
+		"Renders are written to <output>/<pack name>/<skin folder>/<skin name>_<view>.png\n");
+}
+
+static bool ParseView(const std::string& text, SkinView& view)
+{
+	size_t first = text.find(':');
+	if (first == std::string::npos || first == 0)
+		return false;
+
+	size_t second = text.find(':', first + 1);
+
+	view.name = text.substr(0, first);
+	view.yaw = std::strtof(text.c_str() + first + 1, nullptr);
+	view.pitch = second != std::string::npos ? std::strtof(text.c_str() + second + 1, nullptr) : 0.0f;
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	std::filesystem::path outputDir = ".";
+	int width = 128, height = 256;
+	unsigned int threadCount = 0;
+	std::vector<SkinView> views;
+	std::vector<std::string> inputs;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "-h" || arg == "--help")
+		{
+			PrintUsage();
+			return 0;
+		}
+		else if ((arg == "-o" || arg == "--output") && hasValue)
+			outputDir = argv[++i];
+		else if ((arg == "-s" || arg == "--size") && hasValue)
+		{
+			if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0)
+			{
+				fprintf(stderr, "Invalid size: %s\n", argv[i]);
+				return 1;
+			}
+		}
+		else if ((arg == "-j" || arg == "--threads") && hasValue)
+			threadCount = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+		else if ((arg == "-v" || arg == "--view") && hasValue)
+		{
+			SkinView view;
+			if (!ParseView(argv[++i], view))
+			{
+				fprintf(stderr, "Invalid view: %s\n", argv[i]);
+				return 1;
+			}
+			views.push_back(view);
+		}
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			fprintf(stderr, "Unknown option: %s\n\n", arg.c_str());
+			PrintUsage();
+			return 1;
+		}
+		else
+			inputs.push_back(arg);
+	}
+
+	if (inputs.empty())
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	if (views.empty())
+		views = SkinRasterizer::getDefaultViews();
+
+	// packs are kept loaded until every render finished, since the tasks only reference their skins
+	std::vector<std::unique_ptr<PCKFile>> packs;
+	std::mutex outputMutex;
+	std::atomic<size_t> written{ 0 };
+	std::atomic<size_t> failed{ 0 };
+
+	ThreadPool pool(threadCount);
+
+	for (const std::string& input : inputs)
+	{
+		auto pck = std::make_unique<PCKFile>();
+
+		try {
+			pck->Read(input);
+		}
+		catch (const std::exception& e) {
+			fprintf(stderr, "Failed to read %s: %s\n", input.c_str(), e.what());
+			++failed;
+			continue;
+		}
+
+		std::filesystem::path packDir = outputDir / std::filesystem::path(input).stem();
+		std::filesystem::create_directories(packDir);
+
+		// skins keep their folder in the pack, so skins with the same name in different folders don't write over each other;
+		// every folder is made before any render starts
+		std::set<std::filesystem::path> skinDirs;
+		for (const PCKAssetFile& file : pck->getFiles())
+		{
+			if (file.getAssetType() == PCKAssetFile::Type::SKIN)
+				skinDirs.insert((packDir / file.getPath()).parent_path());
+		}
+
+		for (const std::filesystem::path& skinDir : skinDirs)
+		{
+			std::error_code error;
+			std::filesystem::create_directories(skinDir, error);
+			if (error)
+				fprintf(stderr, "Failed to create %s: %s\n", skinDir.string().c_str(), error.message().c_str());
+		}
+
+		for (const PCKAssetFile& file : pck->getFiles())
+		{
+			if (file.getAssetType() != PCKAssetFile::Type::SKIN)
+				continue;
+
+			pool.Submit([&, packDir, skin = &file] {
+				std::filesystem::path skinPath = packDir / skin->getPath();
+				std::string skinName = skinPath.stem().string();
+
+				for (const SkinView& view : views)
+				{
+					Image image = SkinRasterizer::Render(*skin, view, width, height);
+					std::filesystem::path outPath = skinPath.parent_path() / (skinName + "_" + view.name + ".png");
+
+					if (image.empty() || !image.WritePNG(outPath.string()))
+					{
+						std::lock_guard<std::mutex> lock(outputMutex);
+						fprintf(stderr, "Failed to render %s (%s)\n", skin->getPath().c_str(), view.name.c_str());
+						++failed;
+						continue;
+					}
+
+					++written;
+				}
+			});
+		}
+
+		packs.push_back(std::move(pck));
+	}
+
+	pool.Wait();
+
+	printf("Rendered %zu image(s) on %zu thread(s), %zu failure(s)\n", written.load(), pool.getThreadCount(), failed.load());
+
+	return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+#include <fstream>
+#include "UI/FontAtlas.h"
+#include "Util/Log.h"
+
+static const float FONT_SIZE = 18.0f;
+
+// Latin, Latin-1 Supplement, Latin Extended-A/B and general punctuation; always baked
+static const ImWchar EAGER_RANGES[] = {
+	0x0020, 0x024F,
+	0x2000, 0x206F,
+	0
+};
+
+static bool IsEagerGlyph(unsigned int codepoint)
+{
+	for (int i = 0; EAGER_RANGES[i] != 0; i += 2)
+	{
+		if (codepoint >= EAGER_RANGES[i] && codepoint <= EAGER_RANGES[i + 1])
+			return true;
+	}
+	return false;
+}
+
+static std::vector<unsigned char> ReadFontFile(const char* path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		LOG_ERROR("Failed to open font file: %s", path);
+		return {};
+	}
+	return std::vector<unsigned char>(std::istreambuf_iterator<char>(file), {});
+}
+
+bool FontAtlas::Init()
+{
+	Build();
+	return !ImGui::GetIO().Fonts->Fonts.empty();
+}
+
+void FontAtlas::RequestGlyph(unsigned int codepoint)
+{
+	// glyphs outside the BMP can't be stored in 16 bit ImWchar ranges
+	if (codepoint >= 0x10000 || mRequested[codepoint] || IsEagerGlyph(codepoint))
+		return;
+
+	mRequested[codepoint] = true;
+	mPending = true;
+}
+
+void FontAtlas::RequestGlyphs(const std::string& text)
+{
+	for (size_t i = 0; i < text.size();)
+	{
+		unsigned char c = static_cast<unsigned char>(text[i]);
+
+		// ASCII is always baked, so it's skipped without decoding
+		if (c < 0x80) {
+			++i;
+			continue;
+		}
+
+		int length = (c & 0xE0) == 0xC0 ? 2 : (c & 0xF0) == 0xE0 ? 3 : (c & 0xF8) == 0xF0 ? 4 : 1;
+		unsigned int codepoint = length == 2 ? c & 0x1F : length == 3 ? c & 0x0F : c & 0x07;
+
+		if (length == 1 || i + length > text.size()) // stray continuation byte or cut off sequence
+		{
+			++i;
+			continue;
+		}
+
+		for (int j = 1; j < length; ++j)
+			codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[i + j]) & 0x3F);
+
+		RequestGlyph(codepoint);
+		i += length;
+	}
+}
+
+void FontAtlas::RequestGlyphs(const std::u16string& text)
+{
+	// surrogate pairs are skipped by RequestGlyph anyway, since they land outside the BMP
+	for (char16_t c : text)
+	{
+		if (c < 0xD800 || c > 0xDFFF)
+			RequestGlyph(c);
+	}
+}
+
+bool FontAtlas::Update()
+{
+	if (!mPending)
+		return false;
+
+	Build();
+	return true;
+}
+
+void FontAtlas::Build()
+{
+	ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+	fonts->Clear();
+
+	// merge ranges out of every requested codepoint; consecutive codepoints share a range
+	mLazyRanges.clear();
+	for (unsigned int c = 1; c < 0x10000; ++c)
+	{
+		if (!mRequested[c])
+			continue;
+
+		unsigned int last = c;
+		while (last + 1 < 0x10000 && mRequested[last + 1])
+			++last;
+
+		mLazyRanges.push_back((ImWchar)c);
+		mLazyRanges.push_back((ImWchar)last);
+		c = last;
+	}
+	mLazyRanges.push_back(0);
+
+	ImFontConfig config;
+	config.MergeMode = false;
+	config.PixelSnapH = true;
+	config.FontDataOwnedByAtlas = false;
+
+	for (size_t i = 0; i < mSources.size(); ++i)
+	{
+		// CJK fonts are only needed (and read) once something requested a glyph from outside the eager ranges
+		bool isLatin = i == 0;
+		if (!isLatin && mLazyRanges.size() == 1)
+			break;
+
+		FontSource& source = mSources[i];
+		if (source.data.empty())
+			source.data = ReadFontFile(source.path);
+		if (source.data.empty())
+			continue;
+
+		void* data = source.data.data();
+		int size = (int)source.data.size();
+
+		if (isLatin)
+		{
+			fonts->AddFontFromMemoryTTF(data, size, FONT_SIZE, &config, EAGER_RANGES);
+			config.MergeMode = true;
+		}
+
+		// the first font with a glyph wins, so Latin (if it has one) takes priority, then zh_cn, zh_tw, ja and ko
+		if (mLazyRanges.size() > 1)
+			fonts->AddFontFromMemoryTTF(data, size, FONT_SIZE, &config, mLazyRanges.Data);
+	}
+
+	fonts->Build();
+	mPending = false;
+}
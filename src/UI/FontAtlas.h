@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <imgui.h>
+
+// Keeps the ImGui font atlas small; Latin is baked at startup, while CJK (and any other non Latin) glyphs
+// are only baked once some text actually needs them, i.e. property values or localisation strings of a loaded pack
+class FontAtlas {
+public:
+	// Bakes the Latin font; the CJK font files aren't even read yet
+	bool Init();
+
+	// Requests the glyphs of a UTF-8 string
+	void RequestGlyphs(const std::string& text);
+
+	// Requests the glyphs of a UTF-16 string
+	void RequestGlyphs(const std::u16string& text);
+
+	// Rebuilds the atlas if glyphs were requested since the last build; must be called outside of a frame.
+	// Returns true when the font texture has to be re-uploaded
+	bool Update();
+
+private:
+	// Font file, read on first use and owned here rather than by the atlas so rebuilds don't read it again
+	struct FontSource {
+		const char* path;
+		std::vector<unsigned char> data{};
+	};
+
+	void RequestGlyph(unsigned int codepoint);
+	void Build();
+
+	std::vector<FontSource> mSources{
+		{ "assets/fonts/ark-pixel-12px-monospaced-latin.ttf" },
+		{ "assets/fonts/ark-pixel-12px-monospaced-zh_cn.ttf" },
+		{ "assets/fonts/ark-pixel-12px-monospaced-zh_tw.ttf" },
+		{ "assets/fonts/ark-pixel-12px-monospaced-ja.ttf" },
+		{ "assets/fonts/ark-pixel-12px-monospaced-ko.ttf" }
+	};
+
+	// one bit per BMP codepoint; whether it's been requested for the atlas
+	std::vector<bool> mRequested = std::vector<bool>(0x10000, false);
+	// codepoints requested, but not baked yet
+	bool mPending{ false };
+	// lazily requested glyphs as ImGui ranges; must outlive the atlas build
+	ImVector<ImWchar> mLazyRanges{};
+};
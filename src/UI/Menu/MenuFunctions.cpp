@@ -1,3 +1,4 @@
+#include <future>
 #include <sstream>
 #include "Application/Application.h"
 #include "Program/Program.h"
@@ -13,22 +14,19 @@ void OpenPCKFile(const std::string& inpath)
 	if (inpath.empty())
 		return;
 
-	auto& fileDialog = gApp->GetPlatform()->mDialog;
+	// read in the background; the current file stays loaded until the new one is fully read
+	auto pckFile = std::make_shared<std::unique_ptr<PCKFile>>();
 
-	try {
-		gApp->GetInstance()->LoadPCKFile(inpath);
-	}
-	catch (const std::exception& e) {
-		fileDialog.ShowError("Error", e.what());
-		return;
-	}
-	catch (...) {
-		fileDialog.ShowError("Error", "Unknown Error Occurred.");
-		return;
-	}
+	gApp->GetInstance()->jobs.Start("Opening " + std::filesystem::path(inpath).filename().string(),
+		[inpath, pckFile](JobProgress& progress) {
+			*pckFile = ProgramInstance::ReadPCKFile(inpath, &progress);
+		},
+		[pckFile]() {
+			gApp->GetInstance()->SetCurrentPCKFile(std::move(*pckFile));
 
-	// if successful, reset node and UI data; pass file path to send to UI
-	ResetProgramData();
+			// if successful, reset node and UI data; pass file path to send to UI
+			ResetProgramData();
+		});
 }
 
 void OpenPCKFileDialog()
@@ -52,10 +50,9 @@ void SavePCKFileDialog(Binary::Endianness endianness, const std::string& default
 
 	std::string filePath = fileDialog.SaveFile({ pckFilter[0] }, defaultName);
 
-	if (!filePath.empty())
+	if (!filePath.empty() && pckFile)
 	{
-		SavePCKFile(filePath, endianness);
-		pckFile->setFilePath(filePath); // update to save as location
+		SavePCKFile(filePath, endianness); // also updates to the save as location
 	}
 	else
 		platform->ShowCancelledMessage();
@@ -64,21 +61,108 @@ void SavePCKFileDialog(Binary::Endianness endianness, const std::string& default
 void SavePCKFile(const std::string& outpath, Binary::Endianness endianness)
 {
 	PCKFile* pckFile = gApp->GetInstance()->GetCurrentPCKFile();
+	if (!pckFile)
+		return;
+
+	// nested PCK Files are written back here, so the worker only reads the file while the UI keeps drawing it
+	pckFile->updateNestedFiles();
+
+	// the file can't be edited while the job runs, so the worker can read it as is
+	gApp->GetInstance()->jobs.Start("Saving " + std::filesystem::path(outpath).filename().string(),
+		[pckFile, outpath, endianness](JobProgress& progress) {
+			// written next to the target first, so a failed or cancelled save never leaves a broken PCK behind
+			std::string tempPath = outpath + ".tmp";
+			try {
+				pckFile->Write(tempPath, endianness, &progress);
+				std::filesystem::rename(tempPath, outpath);
+			}
+			catch (...) {
+				std::error_code error;
+				std::filesystem::remove(tempPath, error);
+				throw;
+			}
+		},
+		[outpath]() {
+			if (PCKFile* savedFile = gApp->GetInstance()->GetCurrentPCKFile())
+				savedFile->setFilePath(outpath);
+
+			gApp->GetPlatform()->ShowSuccessMessage();
+		});
+}
+
+void ConvertPCKFileDialog(Binary::Endianness endianness)
+{
+	PCKFile* pckFile = gApp->GetInstance()->GetCurrentPCKFile();
+	if (!pckFile || pckFile->getFilePath().empty())
+		return;
 
 	const auto& platform = gApp->GetPlatform();
-	auto& fileDialog = platform->mDialog;
+	std::string inpath = pckFile->getFilePath();
+	std::string outpath = platform->mDialog.SaveFile({ pckFilter[0] }, pckFile->getFileName());
 
-	try {
-		pckFile->Write(outpath, endianness);
-	}
-	catch (const std::exception& e) {
-		fileDialog.ShowError("Error", e.what());
-		delete pckFile;
-		pckFile = new PCKFile();
+	if (outpath.empty())
+	{
+		platform->ShowCancelledMessage();
 		return;
 	}
 
-	platform->ShowSuccessMessage();
+	gApp->GetInstance()->jobs.Start("Converting " + std::filesystem::path(inpath).filename().string(),
+		[inpath, outpath, endianness](JobProgress& progress) {
+			// same as saving, so converting over the source file itself works too
+			std::string tempPath = outpath + ".tmp";
+			try {
+				PCKFile::ConvertEndianness(inpath, tempPath, endianness, &progress);
+				std::filesystem::rename(tempPath, outpath);
+			}
+			catch (...) {
+				std::error_code error;
+				std::filesystem::remove(tempPath, error);
+				throw;
+			}
+		},
+		[]() {
+			gApp->GetPlatform()->ShowSuccessMessage();
+		});
+}
+
+void ComparePCKFile(const std::string& inpath)
+{
+	PCKFile* pckFile = gApp->GetInstance()->GetCurrentPCKFile();
+	if (!pckFile || inpath.empty())
+		return;
+
+	// so nested PCK Files are hashed with their edits; done here since the job may only read the PCK
+	pckFile->updateNestedFiles();
+	uint32_t revision = pckFile->getRevision();
+
+	auto diff = std::make_shared<std::unique_ptr<PCKDiff>>();
+
+	gApp->GetInstance()->jobs.Start("Comparing with " + std::filesystem::path(inpath).filename().string(),
+		[pckFile, inpath, diff](JobProgress& progress) {
+			// the file on disk is read while the current one is hashed
+			auto newFiles = std::async(std::launch::async, [pckFile] { return pckFile->getIndex(); });
+			std::vector<PCKFile::IndexEntry> oldFiles = PCKFile::ReadIndex(inpath, &progress);
+
+			*diff = std::make_unique<PCKDiff>();
+			(*diff)->Compare(std::move(oldFiles), newFiles.get());
+		},
+		[inpath, revision, diff]() {
+			ProgramInstance* instance = gApp->GetInstance();
+			instance->comparison = std::move(*diff);
+			instance->comparisonPath = inpath;
+			instance->comparisonRevision = revision;
+		});
+}
+
+void ComparePCKFileDialog()
+{
+	const auto& platform = gApp->GetPlatform();
+	std::string filePath = platform->mDialog.OpenFile({ pckFilter[0] });
+
+	if (!filePath.empty())
+		ComparePCKFile(filePath);
+	else
+		platform->ShowCancelledMessage();
 }
 
 void SetFilePropertiesDialog(PCKAssetFile& file)
@@ -301,9 +385,9 @@ void WriteFileDataDialog(const PCKAssetFile& file, bool includeProperties)
 	if (!outPath.empty())
 	{
 		if(includeProperties)
-			IO::WriteFile(outPath, file.getData(), file.getProperties());
+			IO::WriteFile(outPath, file.getData(), file.getFileSize(), file.getProperties());
 		else
-			IO::WriteFile(outPath, file.getData());
+			IO::WriteFile(outPath, file.getData(), file.getFileSize());
 
 		platform->ShowSuccessMessage();
 	}
@@ -16,6 +16,15 @@ void SavePCKFileDialog(Binary::Endianness endianness, const std::string& default
 // Saves PCK File to path
 void SavePCKFile(const std::string& outpath, Binary::Endianness endianness);
 
+// Converts the current PCK File as saved on disk to another endianness via file dialog, streaming it instead of loading it
+void ConvertPCKFileDialog(Binary::Endianness endianness);
+
+// Compares a PCK File on disk, as the old version, with the current one, only reading the file list and hashes of the one on disk
+void ComparePCKFile(const std::string& inpath);
+
+// Compares a PCK File picked via file dialog with the current one
+void ComparePCKFileDialog();
+
 // Replaces file properties via file dialog
 void SetFilePropertiesDialog(PCKAssetFile& file);
 
@@ -1,4 +1,10 @@
 #pragma once
 #include "PCK/PCKAssetFile.h"
 
-void PreviewSkin(PCKAssetFile& skinFile, bool reset = false);
\ No newline at end of file
+void PreviewSkin(PCKAssetFile& skinFile, bool reset = false);
+
+// Previews every model of a models.bin, with a list of models and the parts of the selected one
+void PreviewModels(PCKAssetFile& modelsFile);
+
+// Sets up a perspective projection matrix, like gluPerspective
+void glPerspective(float fovY, float aspect, float zNear, float zFar);
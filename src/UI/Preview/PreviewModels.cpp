@@ -0,0 +1,383 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <unordered_map>
+#include "Formats/ModelsFile.h"
+#include "PCK/PCKFile.h"
+#include "Program/ProgramInstance.h"
+#include "UI/Preview.h"
+#include "UI/Tree/TreeFunctions.h"
+#include "UI/UIImGui.h"
+#include "Util/Log.h"
+#include "Util/Trace.h"
+
+// Globals; taken from the asset cache again whenever the file or its data changes
+static std::shared_ptr<ModelsFile> gModelsFile = std::make_shared<ModelsFile>();
+static const PCKAssetFile* gModelsSource = nullptr;
+static uint32_t gModelsRevision = 0;
+static std::string gModelsError;
+static size_t gSelectedModel = 0;
+
+// Every model's boxes in one pooled buffer, uploaded once per read; each model draws its own range of it
+static std::vector<SkinVertex> gModelVertices{};
+static std::vector<size_t> gModelVertexStarts{}; // one more than there are models, so a model's range is [i, i + 1)
+static std::vector<const PCKAssetFile*> gModelTextures{}; // nullptr for models with no texture in the pack
+static const PCKFile* gModelTexturesPack = nullptr;
+static uint32_t gModelTexturesRevision = 0; // of the whole pack, since the assets move whenever its file list changes
+static GLuint gModelsVBO = 0;
+static bool gModelsVerticesDirty = true;
+
+static Texture gModelsPreviewTex{}, gModelsPreviewFBO{};
+static GLuint gModelsPreviewDepth = 0;
+static float gModelRotationX = 15.0f;
+static float gModelRotationY = 135.0f;
+static float gModelZoom = 40.0f;
+static float gModelCenter[3]{};
+
+// Everything the preview FBO depends on; the FBO is only re-rendered when this changes
+struct ModelPreviewState
+{
+    float rotationX{}, rotationY{}, zoom{};
+    int width{}, height{};
+    size_t model{};
+    unsigned int textureID{};
+
+    bool operator==(const ModelPreviewState& other) const
+    {
+        return rotationX == other.rotationX && rotationY == other.rotationY && zoom == other.zoom &&
+            width == other.width && height == other.height && model == other.model && textureID == other.textureID;
+    }
+
+    bool operator!=(const ModelPreviewState& other) const { return !(*this == other); }
+};
+
+static ModelPreviewState gLastModelPreviewState{};
+static bool gModelsPreviewDirty = true;
+
+static std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+// Maps the file name of every image in a pack and the nested packs read so far to its asset; the first one found wins
+static void CollectTextures(const PCKFile& pckFile, std::unordered_map<std::string, const PCKAssetFile*>& textures)
+{
+    for (const auto& file : pckFile.getFiles())
+    {
+        if (file.isImageType())
+            textures.try_emplace(ToLower(std::filesystem::path(file.getPath()).stem().string()), &file);
+        else if (const PCKFile* nested = file.getLoadedNestedPCK())
+            CollectTextures(*nested, textures);
+    }
+}
+
+// Points the preview at the selected model, fitting the camera around it
+static void FocusModel(size_t index)
+{
+    gSelectedModel = index;
+
+    float min[3]{ 0, 0, 0 }, max[3]{ 0, 0, 0 };
+    for (size_t v = gModelVertexStarts[index]; v < gModelVertexStarts[index + 1]; ++v)
+    {
+        const SkinVertex& vertex = gModelVertices[v];
+        const float position[3]{ vertex.x, vertex.y, vertex.z };
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (v == gModelVertexStarts[index] || position[axis] < min[axis]) min[axis] = position[axis];
+            if (v == gModelVertexStarts[index] || position[axis] > max[axis]) max[axis] = position[axis];
+        }
+    }
+
+    float radius = 0.0f;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        gModelCenter[axis] = (min[axis] + max[axis]) * 0.5f;
+        radius = std::max(radius, max[axis] - min[axis]);
+    }
+
+    gModelZoom = std::max(radius * 1.75f, 10.0f);
+}
+
+// Looks up the texture of every model in the current pack again
+static void FindModelTextures()
+{
+    PCKFile* pckFile = gApp->GetInstance()->GetCurrentPCKFile();
+    gModelTexturesPack = pckFile;
+    gModelTexturesRevision = gApp->GetInstance()->GetCurrentPCKRevision();
+
+    std::unordered_map<std::string, const PCKAssetFile*> textures;
+    if (pckFile)
+        CollectTextures(*pckFile, textures);
+
+    gModelTextures.clear();
+    for (const auto& model : gModelsFile->getModels())
+    {
+        auto it = textures.find(ToLower(model.name));
+        gModelTextures.push_back(it != textures.end() ? it->second : nullptr);
+    }
+}
+
+static void SetUpModelsPreview(PCKAssetFile& file)
+{
+    TRACE_SCOPE("Models preview setup");
+
+    gModelsSource = &file;
+    gModelsRevision = file.getRevision();
+    gModelsError.clear();
+    gModelVertices.clear();
+    gModelVertexStarts.assign(1, 0);
+    gModelTextures.clear();
+    gModelsVerticesDirty = true;
+    gModelsPreviewDirty = true;
+
+    try
+    {
+        gModelsFile = gApp->GetInstance()->assets.get<ModelsFile>(file);
+    }
+    catch (std::exception& ex)
+    {
+        gModelsFile = std::make_shared<ModelsFile>();
+        gModelsError = ex.what();
+        return;
+    }
+
+    // every model is batched up front, so picking another one is just a different range of the same buffer
+    size_t vertexCount = 0;
+    for (const auto& model : gModelsFile->getModels())
+        vertexCount += gModelsFile->getVertexCount(model);
+    gModelVertices.reserve(vertexCount);
+
+    for (const auto& model : gModelsFile->getModels())
+    {
+        gModelsFile->AppendVertices(model, gModelVertices);
+        gModelVertexStarts.push_back(gModelVertices.size());
+    }
+
+    if (gSelectedModel >= gModelsFile->getModels().size())
+        gSelectedModel = 0;
+    if (!gModelsFile->getModels().empty())
+        FocusModel(gSelectedModel);
+}
+
+// Renders the selected model into the preview FBO, (re)allocating its attachments only when the size changed
+static void RenderModelsPreviewFBO(int previewWidth, int previewHeight, bool resized, unsigned int textureID)
+{
+    TRACE_SCOPE("Models preview FBO");
+
+    if (gModelsPreviewTex.id == 0) glGenTextures(1, &gModelsPreviewTex.id);
+    if (gModelsPreviewFBO.id == 0) glGenFramebuffers(1, &gModelsPreviewFBO.id);
+    if (gModelsPreviewDepth == 0) glGenRenderbuffers(1, &gModelsPreviewDepth);
+    if (gModelsVBO == 0) glGenBuffers(1, &gModelsVBO);
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glEnable(GL_ALPHA_TEST);
+    glAlphaFunc(GL_GREATER, 0.01f);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, gModelsPreviewFBO.id);
+
+    if (resized)
+    {
+        glBindTexture(GL_TEXTURE_2D, gModelsPreviewTex.id);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, previewWidth, previewHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gModelsPreviewTex.id, 0);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, gModelsPreviewDepth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, previewWidth, previewHeight);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, gModelsPreviewDepth);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            LOG_ERROR("Models preview FBO not complete");
+    }
+
+    glViewport(0, 0, previewWidth, previewHeight);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glPerspective(45.0f, (float)previewWidth / previewHeight, 0.1f, 1000.0f);
+
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    glTranslatef(0.0f, 0.0f, -gModelZoom);
+    glRotatef(gModelRotationX, 1, 0, 0);
+    glRotatef(gModelRotationY, 0, 1, 0);
+    glTranslatef(-gModelCenter[0], -gModelCenter[1], -gModelCenter[2]);
+
+    glBindBuffer(GL_ARRAY_BUFFER, gModelsVBO);
+    if (gModelsVerticesDirty)
+    {
+        glBufferData(GL_ARRAY_BUFFER, gModelVertices.size() * sizeof(SkinVertex), gModelVertices.data(), GL_STATIC_DRAW);
+        gModelsVerticesDirty = false;
+    }
+
+    // models without a texture in the pack are drawn flat grey, so their shape still shows
+    if (textureID != 0)
+    {
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glEnable(GL_TEXTURE_2D);
+        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+    else
+        glColor4f(0.6f, 0.6f, 0.6f, 1.0f);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    size_t first = gModelVertexStarts[gSelectedModel];
+    size_t count = gModelVertexStarts[gSelectedModel + 1] - first;
+
+    glInterleavedArrays(GL_T2F_V3F, 0, nullptr);
+    glDrawArrays(GL_QUADS, (GLint)first, (GLsizei)count);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_BLEND);
+
+    // ImGui's renderer uses client side arrays, so the buffer must not stay bound
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_ALPHA_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void PreviewModels(PCKAssetFile& file)
+{
+    if (gModelsSource != &file || gModelsRevision != file.getRevision())
+        SetUpModelsPreview(file);
+
+    // deleting, moving or importing files, or a nested pack being read again, leaves the old texture assets dangling
+    const PCKFile* pckFile = gApp->GetInstance()->GetCurrentPCKFile();
+    if (gModelTextures.size() != gModelsFile->getModels().size() || gModelTexturesPack != pckFile || gModelTexturesRevision != gApp->GetInstance()->GetCurrentPCKRevision())
+        FindModelTextures();
+
+    if (!gModelsError.empty())
+    {
+        ImGui::Text("Failed to read models.bin: %s", gModelsError.c_str());
+        return;
+    }
+
+    const auto& models = gModelsFile->getModels();
+    if (models.empty())
+    {
+        ImGui::TextDisabled("No models");
+        return;
+    }
+
+    const ModelsFile::Model& model = models[gSelectedModel];
+
+    // only the rows on screen are drawn, since some packs have hundreds of models and parts
+    float listWidth = ImGui::GetContentRegionAvail().x * 0.25f;
+    float listHeight = ImGui::GetContentRegionAvail().y;
+
+    ImGui::BeginGroup();
+    ImGui::BeginChild("ModelList", ImVec2(listWidth, listHeight * 0.5f), true);
+    {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(models.size()));
+        while (clipper.Step())
+        {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+            {
+                ImGui::PushID(i);
+                if (ImGui::Selectable(models[i].name.c_str(), gSelectedModel == static_cast<size_t>(i)))
+                    FocusModel(i);
+                ImGui::PopID();
+            }
+        }
+    }
+    ImGui::EndChild();
+
+    ImGui::BeginChild("ModelParts", ImVec2(listWidth, 0), true);
+    if (ImGui::BeginTable("ModelPartTable", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_ScrollY))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Part", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Parent", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Boxes", ImGuiTableColumnFlags_WidthFixed, 40.0f);
+        ImGui::TableHeadersRow();
+
+        const auto& parts = gModelsFile->getParts();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(model.partCount));
+        while (clipper.Step())
+        {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+            {
+                const ModelsFile::Part& part = parts[model.firstPart + i];
+                ImGui::TableNextRow();
+
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextUnformatted(part.name.c_str());
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Pivot: %.2f, %.2f, %.2f\nRotation: %.2f, %.2f, %.2f",
+                        part.pivotX, part.pivotY, part.pivotZ, part.rotationX, part.rotationY, part.rotationZ);
+
+                ImGui::TableSetColumnIndex(1);
+                ImGui::TextUnformatted(part.parent.c_str());
+
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%u", part.boxCount);
+            }
+        }
+
+        ImGui::EndTable();
+    }
+    ImGui::EndChild();
+    ImGui::EndGroup();
+
+    ImGui::SameLine();
+
+    float previewWidth = ImGui::GetContentRegionAvail().x;
+    float previewHeight = listHeight - ImGui::GetTextLineHeightWithSpacing();
+
+    // the texture is shared with every other preview through the graphics texture cache
+    const PCKAssetFile* textureFile = gModelTextures[gSelectedModel];
+    unsigned int textureID = textureFile
+        ? gApp->GetGraphics()->GetCachedTexture(textureFile, textureFile->getRevision(), textureFile->getData(), textureFile->getFileSize()).id
+        : 0;
+
+    ModelPreviewState state{ gModelRotationX, gModelRotationY, gModelZoom, (int)previewWidth, (int)previewHeight, gSelectedModel, textureID };
+
+    if (state.width > 0 && state.height > 0 && (gModelsPreviewDirty || state != gLastModelPreviewState))
+    {
+        bool resized = gModelsPreviewDirty || state.width != gLastModelPreviewState.width || state.height != gLastModelPreviewState.height;
+        RenderModelsPreviewFBO(state.width, state.height, resized, textureID);
+
+        gLastModelPreviewState = state;
+        gModelsPreviewDirty = false;
+    }
+
+    ImGui::BeginGroup();
+    ImGui::Image((ImTextureID)(intptr_t)gModelsPreviewTex.id, ImVec2(previewWidth, previewHeight), ImVec2(0, 1), ImVec2(1, 0));
+
+    ImGuiIO& io = ImGui::GetIO();
+    if (ImGui::IsItemHovered())
+    {
+        if (ImGui::IsMouseDown(ImGuiMouseButton_Left))
+        {
+            gModelRotationY += io.MouseDelta.x * 0.25f;
+            gModelRotationX += io.MouseDelta.y * 0.25f;
+        }
+        if (io.MouseWheel != 0.0f)
+            gModelZoom = std::max(gModelZoom - io.MouseWheel * 2.0f, 1.0f);
+    }
+
+    if (textureFile)
+        ImGui::Text("%s: %u parts, %zu boxes, texture %s", model.name.c_str(), model.partCount,
+            (gModelVertexStarts[gSelectedModel + 1] - gModelVertexStarts[gSelectedModel]) / 24, textureFile->getPath().c_str());
+    else
+        ImGui::Text("%s: %u parts, %zu boxes, no texture found", model.name.c_str(), model.partCount,
+            (gModelVertexStarts[gSelectedModel + 1] - gModelVertexStarts[gSelectedModel]) / 24);
+    ImGui::EndGroup();
+}
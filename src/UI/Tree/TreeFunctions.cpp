@@ -1,20 +1,27 @@
 #include <functional>
+#include <iomanip>
+#include "PCK/PCKExtractor.h"
 #include "UI/MenuFunctions.h"
 #include "UI/Tree/TreeFunctions.h"
+#include "Util/Log.h"
 #include "Util/Util.h"
 
-void TreeToPCKFileCollection(std::vector<FileTreeNode>& treeNodes)
+// Reorders the files of a PCK File to match its tree; nested PCK Files that are in the tree get theirs done along the way
+static void ApplyTreeOrder(PCKFile& pckFile, const std::vector<FileTreeNode>& treeNodes)
 {
-	PCKFile* pckFile = gApp->GetInstance()->GetCurrentPCKFile();
-
-	if (!pckFile)
-		return;
-
-	std::vector<PCKAssetFile> files;
+	// the nodes point into the PCK's own file list, so the files can be moved into tree order instead of copied twice
+	std::vector<const PCKAssetFile*> files;
 
 	std::function<void(const FileTreeNode&)> collect = [&](const FileTreeNode& node) {
 		if (node.file)
-			files.push_back(*node.file);
+		{
+			files.push_back(node.file);
+
+			// the children of a file are a different PCK File entirely
+			if (PCKFile* nested = node.file->getLoadedNestedPCK())
+				ApplyTreeOrder(*nested, node.children);
+			return;
+		}
 
 		for (const auto& child : node.children)
 			collect(child);
@@ -34,25 +41,17 @@ void TreeToPCKFileCollection(std::vector<FileTreeNode>& treeNodes)
 			collect(node);
 	}
 
-	pckFile->clearFiles();
-
-	for (const auto& f : files)
-		pckFile->addFile(&f);
-
-	files.clear();
+	pckFile.reorderFiles(files);
 }
 
-FileTreeNode* FindNodeByPath(const std::string& path, std::vector<FileTreeNode>& nodes)
+void TreeToPCKFileCollection(std::vector<FileTreeNode>& treeNodes)
 {
-	for (auto& node : nodes)
-	{
-		if (node.path == path)
-			return &node;
+	PCKFile* pckFile = gApp->GetInstance()->GetCurrentPCKFile();
 
-		if (FileTreeNode* found = FindNodeByPath(path, node.children))
-			return found;
-	}
-	return nullptr;
+	if (!pckFile)
+		return;
+
+	ApplyTreeOrder(*pckFile, treeNodes);
 }
 
 void RenameDirectory(const std::string& targetPath, const std::string& newName, std::vector<FileTreeNode>& nodes)
@@ -61,7 +60,7 @@ void RenameDirectory(const std::string& targetPath, const std::string& newName,
 	{
 		if (node.file)
 		{
-			std::string oldPath = node.file->getPath();
+			std::string oldPath = node.packPath + node.file->getPath();
 			std::replace(oldPath.begin(), oldPath.end(), '\\', '/');
 
 			if (String::startsWith(oldPath, (targetPath)))
@@ -78,9 +77,14 @@ void RenameDirectory(const std::string& targetPath, const std::string& newName,
 
 				std::string newPathStr = newPath.generic_string();
 
-				printf("Renaming: %s -> %s\n", oldPath.c_str(), newPathStr.c_str());
+				// files can't be renamed out of the PCK File they're in
+				if (!String::startsWith(newPathStr, node.packPath))
+					throw std::runtime_error("Files can't be moved out of " + node.packPath);
 
-				node.file->setPath(newPathStr);
+				LOG_DEBUG("Renaming: %s -> %s", oldPath.c_str(), newPathStr.c_str());
+
+				node.file->setPath(newPathStr.substr(node.packPath.size()));
+				continue; // anything nested under a file is already covered by the rename
 			}
 		}
 
@@ -105,76 +109,13 @@ void DeleteNode(FileTreeNode& targetNode, std::vector<FileTreeNode>& nodes)
 	}
 }
 
-void SortTree(FileTreeNode& node) {
-	std::stable_sort(node.children.begin(), node.children.end(), [](const FileTreeNode& a, const FileTreeNode& b) {
-		if (!a.file && b.file) return true;
-		if (a.file && !b.file) return false;
-		if (!a.file && !b.file) return a.path < b.path;
-		return false;
-		});
-	for (auto& child : node.children)
-		if (!child.file)
-			SortTree(child);
-}
-
 void BuildFileTree() {
 	PCKFile* pckFile = gApp->GetInstance()->GetCurrentPCKFile();
 
 	if (!pckFile)
 		return;
 
-	gApp->GetInstance()->treeNodes.clear();
-
-	FileTreeNode root;
-	auto& files = pckFile->getFiles();
-
-	for (const auto& file : files) {
-		std::string fullPath = file.getPath();
-		size_t slashPos = fullPath.find_last_of("/\\");
-		std::string folderName = (slashPos != std::string::npos) ? fullPath.substr(0, slashPos) : "";
-
-		std::vector<std::string> parts;
-		size_t start = 0;
-		while (true) {
-			size_t pos = folderName.find_first_of("/\\", start);
-			if (pos == std::string::npos) {
-				parts.push_back(folderName.substr(start));
-				break;
-			}
-			parts.push_back(folderName.substr(start, pos - start));
-			start = pos + 1;
-		}
-
-		FileTreeNode* current = &root;
-		std::filesystem::path currentPath = root.path;
-
-		for (const auto& part : parts) {
-			if (part.empty()) continue;
-
-			currentPath /= part;
-
-			std::string normalizedCurrent = currentPath.string();
-			std::replace(normalizedCurrent.begin(), normalizedCurrent.end(), '\\', '/');
-
-			auto it = std::find_if(current->children.begin(), current->children.end(), [&](const FileTreeNode& n) {
-				return !n.file && n.path == normalizedCurrent;
-				});
-
-			if (it == current->children.end()) {
-				current->children.push_back(FileTreeNode{ normalizedCurrent, nullptr });
-				current = &current->children.back();
-			}
-			else {
-				current = &(*it);
-			}
-		}
-
-		std::filesystem::path filePath = file.getPath();
-		current->children.push_back(FileTreeNode{ filePath.string(), const_cast<PCKAssetFile*>(&file) });
-	}
-
-	SortTree(root);
-	gApp->GetInstance()->treeNodes = std::move(root.children);
+	gApp->GetInstance()->treeNodes = BuildFileTree(*pckFile);
 }
 
 // TODO: Move to UIBase
@@ -199,6 +140,12 @@ void ScrollToNode(bool& keyScrolled)
 
 void SavePCK(std::vector<FileTreeNode> nodes, Binary::Endianness endianness, const std::string& path, const std::string& defaultName)
 {
+	if (gApp->GetInstance()->jobs.IsBusy())
+		return;
+
+	// a field still being typed into hasn't been written back yet
+	gApp->GetUI()->FlushEdits();
+
 	TreeToPCKFileCollection(nodes);
 
 	if (!path.empty()) {
@@ -220,38 +167,64 @@ void WriteFolder(const FileTreeNode& node, bool includeProperties)
 		return;
 	}
 
-	try {
-		std::function<void(const FileTreeNode&, const std::string&)> saveRecursive =
-			[&](const FileTreeNode& n, const std::string& currentPath)
+	// edits to nested PCK Files only make it into their file's data once they're written back
+	if (node.pack)
+		node.pack->updateNestedFiles();
+
+	// the tree is rebuilt every frame, so the job gets its own list of files and where they go
+	std::vector<PCKExtractor::Entry> entries;
+
+	std::function<void(const FileTreeNode&, const std::filesystem::path&)> collect =
+		[&](const FileTreeNode& n, const std::filesystem::path& currentPath)
+		{
+			if (!n.file)
 			{
-				if (!n.file)
-				{
-					std::string folderPath = currentPath + "/" + std::filesystem::path(n.path).filename().string();
-					std::filesystem::create_directories(folderPath);
-
-					for (const auto& child : n.children)
-						saveRecursive(child, folderPath);
-				}
-				else
-				{
-					std::string fileName = std::filesystem::path(n.path).filename().string();
-					std::string filePath = currentPath + "/" + fileName;
-
-					std::ofstream outFile(filePath, std::ios::binary);
-					if (outFile)
-						outFile.write(reinterpret_cast<const char*>(n.file->getData().data()), n.file->getFileSize());
-
-					if (outFile.good() && includeProperties)
-					{
-						WriteFileProperties(*n.file, filePath + ".txt");
-					}
-				}
-			};
-
-		saveRecursive(node, targetDir);
-	}
-	catch (...)
-	{
-		SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", SDL_GetError(), platform->GetWindow());
-	}
+				std::filesystem::path folderPath = currentPath / std::filesystem::path(n.path).filename();
+
+				for (const auto& child : n.children)
+					collect(child, folderPath);
+			}
+			else
+			{
+				entries.push_back({ n.file, currentPath / std::filesystem::path(n.path).filename() });
+			}
+		};
+
+	collect(node, targetDir);
+
+	auto result = std::make_shared<PCKExtractor::Result>();
+
+	gApp->GetInstance()->jobs.Start("Extracting " + std::filesystem::path(node.path).filename().string(),
+		[entries = std::move(entries), includeProperties, result](JobProgress& progress) {
+			*result = PCKExtractor::Extract(entries, includeProperties, &progress);
+
+			if (result->cancelled)
+				throw JobCancelled();
+		},
+		[result]() {
+			std::ostringstream summary;
+			summary << "Extracted " << result->filesWritten << " file(s), "
+				<< std::fixed << std::setprecision(1) << result->bytesWritten / (1024.0 * 1024.0) << " MB in "
+				<< std::setprecision(2) << result->seconds << "s (" << std::setprecision(1) << result->getThroughput()
+				<< " MB/s on " << result->threadCount << " thread(s))";
+
+			LOG_INFO("%s", summary.str().c_str());
+
+			auto& fileDialog = gApp->GetPlatform()->mDialog;
+			if (result->errors.empty())
+			{
+				fileDialog.ShowInfo("Extracted", summary.str());
+				return;
+			}
+
+			// every failed file is listed, up to a point so the message box still fits on screen
+			const size_t maxListed = 20;
+			summary << "\n\n" << result->errors.size() << " file(s) failed:";
+			for (size_t i = 0; i < result->errors.size() && i < maxListed; ++i)
+				summary << "\n" << result->errors[i].outPath.string() << ": " << result->errors[i].message;
+			if (result->errors.size() > maxListed)
+				summary << "\n...";
+
+			fileDialog.ShowError("Extracted with errors", summary.str());
+		});
 }
\ No newline at end of file
@@ -14,19 +14,13 @@ void WriteFolder(const FileTreeNode& node, bool includeProperties = false);
 // Convert file tree to PCK File collection
 void TreeToPCKFileCollection(std::vector<FileTreeNode>& treeNodes);
 
-// Finds a node by path in a given file tree
-FileTreeNode* FindNodeByPath(const std::string& path, std::vector<FileTreeNode>& nodes);
-
 // Renames a directory
 void RenameDirectory(const std::string& targetPath, const std::string& newName, std::vector<FileTreeNode>& nodes);
 
 // Deletes a node in a given file tree
 void DeleteNode(FileTreeNode& targetNode, std::vector<FileTreeNode>& nodes);
 
-// Sorts a given file tree
-void SortTree(FileTreeNode& node);
-
-// Builds a given file tree
+// Builds the file tree of the current PCK File
 void BuildFileTree();
 
 // Scrolls to selected node when not visible
@@ -1,9 +1,4 @@
 #pragma once
 
-#include "PCK/PCKFile.h"
-
-struct FileTreeNode {
-    std::string path{};
-    PCKAssetFile* file{ nullptr };
-    std::vector<FileTreeNode> children;
-};
\ No newline at end of file
+// the tree itself doesn't need the UI, so it lives with the rest of the PCK code where the tools can use it too
+#include "PCK/PCKFileTree.h"
@@ -33,6 +33,18 @@ public:
 	// Renders the preview window in the main program form, takes file to preview
 	virtual void RenderPreviewWindow(PCKAssetFile& file) = 0;
 
+	// Renders the string table editor of a LOC file in place of the preview window
+	virtual void RenderLocalisationWindow(PCKAssetFile& file) = 0;
+
+	// Renders the rule tree of a GRF file with its attributes editable, in place of the preview window
+	virtual void RenderGameRulesWindow(PCKAssetFile& file) = 0;
+
+	// Renders the colour editor of a COL file in place of the preview window
+	virtual void RenderColourTableWindow(PCKAssetFile& file) = 0;
+
+	// Renders the 3D preview of a models.bin file in place of the preview window
+	virtual void RenderModelsWindow(PCKAssetFile& file) = 0;
+
 	// Renders the properties window in the main program form, takes file to get properties from lol
 	virtual void RenderPropertiesWindow(PCKAssetFile& file) = 0;
 
@@ -44,4 +56,28 @@ public:
 
 	// Handles keyboard input. I'm unsure if this really should be here or another class lol
 	virtual void HandleInput() = 0;
+
+	// Renders the progress of the running background job, if any
+	virtual void RenderJobProgress() = 0;
+
+	// Renders the zone timings of the last frame, if turned on
+	virtual void RenderTraceOverlay() = 0;
+
+	// Renders every set of files with identical data in the current PCK File and its nested ones, if turned on
+	virtual void RenderDuplicatesWindow() = 0;
+
+	// Renders the last comparison of another PCK File with the current one, if there is one
+	virtual void RenderComparisonWindow() = 0;
+
+	// Writes whatever the asset editors changed back into their files, like before the PCK File is saved or another file is selected
+	virtual void FlushEdits() = 0;
+
+	// Makes sure the glyphs of a UTF-8 string can be displayed, for UI frameworks that build their fonts lazily
+	virtual void RequestGlyphs(const std::string& text) = 0;
+
+	// Makes sure the glyphs of a UTF-16 string can be displayed, for UI frameworks that build their fonts lazily
+	virtual void RequestGlyphs(const std::u16string& text) = 0;
+
+	// Makes sure every file path and property value of a PCK file can be displayed
+	virtual void RequestGlyphs(const PCKFile& pckFile) = 0;
 };
\ No newline at end of file
@@ -1,27 +1,109 @@
+#include <algorithm>
+#include <functional>
 #include <sstream>
 #include <cstring>
+#include "Formats/BehavioursFile.h"
+#include "Formats/COLFile.h"
+#include "Formats/GRFFile.h"
+#include "Formats/LOCFile.h"
+#include "Formats/MaterialsFile.h"
+#include "PCK/PCKDeduplicator.h"
+#include "PCK/PCKImporter.h"
 #include "UI/Preview.h"
 #include "Program/ProgramInstance.h"
 #include "UI/UIImGui.h"
 #include "UI/MenuFunctions.h"
 #include "UI/Tree/TreeFunctions.h"
+#include "Util/Log.h"
+#include "Util/Trace.h"
 #include "Util/Util.h"
 
 // Preview globals
 std::string gPreviewTitle = "Preview";
 static const PCKAssetFile* gLastPreviewedFile = nullptr;
 
+// LOC editor globals; taken from the asset cache again whenever the file or its data changes
+static std::shared_ptr<LOCFile> gLocFile = std::make_shared<LOCFile>();
+static const PCKAssetFile* gLocSource = nullptr;
+static uint32_t gLocRevision = 0;
+static std::string gLocError;
+
+// Game rules editor globals; same deal, and the selected rule is kept as the path of child indices to it so it survives being decoded again
+static std::shared_ptr<GRFFile> gGrfFile = std::make_shared<GRFFile>();
+static const PCKAssetFile* gGrfSource = nullptr;
+static uint32_t gGrfRevision = 0;
+static std::string gGrfError;
+static std::vector<size_t> gGrfSelection;
+
+// COL editor globals; taken from the asset cache again whenever the file or its data changes
+static std::shared_ptr<COLFile> gColFile = std::make_shared<COLFile>();
+static const PCKAssetFile* gColSource = nullptr;
+static uint32_t gColRevision = 0;
+static std::string gColError;
+
+// Duplicate files globals; searched in a job, and kept showing once the PCK File changes until it's searched again. Rows are a group's header, then each of its files,
+// with their paths copied out, since the files may have moved by the time a stale report is drawn
+struct DuplicateRow
+{
+	size_t group{ 0 };
+	size_t file{ SIZE_MAX }; // in the group, or SIZE_MAX for the group's header
+	std::string pack{};
+	std::string path{};
+};
+
+static PCKDeduplicator::Result gDuplicates;
+static std::vector<DuplicateRow> gDuplicateRows;
+static const PCKFile* gDuplicatesSource = nullptr;
+static uint32_t gDuplicatesRevision = 0;
+static uint64_t gDuplicatesShared = 0;
+
 // globals for this file
 ProgramInstance* gInstance = nullptr;
 
 std::string gDroppedFilePath;
 bool gUpdatePCKCollection;
 
+// Finds the file an editor was opened on in the PCK File, or the nested ones read so far, by the revision it had; files keep their revision when they're moved
+// around but not their address, and get a new one when anything else changes them, so nothing is found if the file is gone or changed under the editor
+static PCKAssetFile* FindEditedFile(PCKFile& pckFile, const PCKAssetFile* source, uint32_t revision)
+{
+	PCKAssetFile* found = nullptr;
+	for (PCKAssetFile& file : pckFile.getFiles())
+	{
+		if (file.getRevision() == revision && (!found || &file == source))
+			found = &file;
+
+		if (PCKFile* nested = file.getLoadedNestedPCK())
+		{
+			PCKAssetFile* nestedFound = FindEditedFile(*nested, source, revision);
+			if (nestedFound && (!found || nestedFound == source))
+				found = nestedFound;
+		}
+	}
+	return found;
+}
+
+// Writes an editor's decoded file back into the file it was opened on; the editor takes it from the asset cache again next frame, since the revision changed
+template<typename T>
+static void WriteBackEdits(T& edited, PCKAssetFile& file)
+{
+	// nothing may touch the PCK while a job is working on it; the changes stay pinned in the cache until the next chance
+	if (!edited.isModified() || gInstance->jobs.IsBusy())
+		return;
+
+	std::vector<unsigned char> data;
+	edited.Write(data);
+
+	gInstance->assets.setPinned(file, false);
+	file.setData(std::move(data));
+}
+
 const char* PCK_FILE_DROP_POPUP_TITLE = "PCK File Functions";
 const char* IMPORT_FILE_POPUP_TITLE = "Import File";
 const char* IMPORT_DIRECTORY_POPUP_TITLE = "Import Directory";
 const char* RENAME_POPUP_TITLE = "Rename Node";
 const char* EDIT_PROPERTIES_POPUP_TITLE = "Edit Properties";
+const char* JOB_PROGRESS_POPUP_TITLE = "Working...";
 
 enum class PopupState {
 	NONE,
@@ -41,6 +123,45 @@ bool IsClicked()
 		(ImGui::IsMouseReleased(ImGuiMouseButton_Right) && ImGui::IsItemHovered());
 }
 
+// Reads files from disk on a job, then moves them into the current PCK all at once when done
+static void ImportFiles(const std::string& name, std::function<std::vector<PCKImporter::Entry>()> collectEntries)
+{
+	auto result = std::make_shared<PCKImporter::Result>();
+
+	gApp->GetInstance()->jobs.Start("Importing " + name,
+		[collectEntries = std::move(collectEntries), result](JobProgress& progress) {
+			progress.setStatus("Looking for files...");
+			*result = PCKImporter::Read(collectEntries(), &progress);
+
+			if (result->cancelled)
+				throw JobCancelled();
+		},
+		[result]() {
+			PCKFile* pckFile = gApp->GetInstance()->GetCurrentPCKFile();
+			if (!pckFile)
+				return;
+
+			LOG_INFO("Imported %zu file(s), %.1f MB in %.2fs", result->files.size(), result->bytesRead / (1024.0 * 1024.0), result->seconds);
+
+			pckFile->addFiles(std::move(result->files));
+
+			// one tree update for the whole import
+			gApp->GetUI()->RequestGlyphs(*pckFile);
+			gUpdatePCKCollection = true;
+
+			if (!result->errors.empty())
+			{
+				std::string message = std::to_string(result->errors.size()) + " file(s) couldn't be imported:";
+				for (size_t i = 0; i < result->errors.size() && i < 20; ++i)
+					message += "\n" + result->errors[i].diskPath.string() + ": " + result->errors[i].message;
+				if (result->errors.size() > 20)
+					message += "\n...";
+
+				gApp->GetPlatform()->mDialog.ShowError("Imported with errors", message);
+			}
+		});
+}
+
 void ResetPreviewWindow()
 {
 	gApp->GetGraphics()->DeleteTexture(gApp->GetPreviewTexture());
@@ -71,27 +192,8 @@ bool UIImGui::InitBackends(void* platformData, void* rendererData) {
     style.CellPadding = ImVec2(0, 0);
 	style.Colors[ImGuiCol_ModalWindowDimBg] = ImVec4(0, 0, 0, 0.0f); // make modal background transparent
 
-	ImFontAtlas* fonts = ImGui::GetIO().Fonts;
-
-    ImFontConfig config;
-    config.MergeMode = false;
-    config.PixelSnapH = true;
-
-	fonts->AddFontFromFileTTF("assets/fonts/ark-pixel-12px-monospaced-latin.ttf", 18.0f, &config);
-
-    config.MergeMode = true;
-
-    // Merge Chinese (Simplified)
-	fonts->AddFontFromFileTTF("assets/fonts/ark-pixel-12px-monospaced-zh_cn.ttf", 18.0f, &config, fonts->GetGlyphRangesChineseSimplifiedCommon());
-    // Merge Chinese (Traditional)
-	fonts->AddFontFromFileTTF("assets/fonts/ark-pixel-12px-monospaced-zh_tw.ttf", 18.0f, &config, fonts->GetGlyphRangesChineseFull());
-    // Merge Japanese
-	fonts->AddFontFromFileTTF("assets/fonts/ark-pixel-12px-monospaced-ja.ttf", 18.0f, &config, fonts->GetGlyphRangesJapanese());
-    // Merge Korean
-	fonts->AddFontFromFileTTF("assets/fonts/ark-pixel-12px-monospaced-ko.ttf", 18.0f, &config, fonts->GetGlyphRangesKorean());
-
-	fonts->Build();
-    return true;
+	// only Latin is baked here; CJK glyphs are added once some text needs them
+	return mFonts.Init();
 }
 
 void UIImGui::ProcessEvent(void* event) {
@@ -105,6 +207,13 @@ void UIImGui::NewFrame() {
     PlatformBackend* platformBackend = gApp->GetPlatformBackend();
     RendererBackend* rendererBackend = gApp->GetRendererBackend();
 
+    // bake glyphs requested during the last frame; the atlas can't change while a frame is in progress
+    if (mFonts.Update() && rendererBackend) {
+        rendererBackend->ReloadFonts();
+        // new glyphs only show up on the next frame
+        gApp->GetPlatform()->RequestRedraw();
+    }
+
     if (platformBackend)
         platformBackend->NewFrame();
     if (rendererBackend)
@@ -118,6 +227,10 @@ void UIImGui::Render() {
     ImGui::Render();
     if (rendererBackend)
         rendererBackend->Render();
+
+    // keeps the text cursor blinking while the main loop idles
+    if (ImGui::GetIO().WantTextInput)
+        gApp->GetPlatform()->RequestRedraw(400);
 }
 
 void UIImGui::Shutdown() {
@@ -148,7 +261,7 @@ void UIImGui::RenderPreviewWindow(PCKAssetFile& file)
 	}
 
 	if (gLastPreviewedFile != &file) {
-		gApp->SetPreviewTexture(gApp->GetGraphics()->LoadTextureFromMemory(file.getData().data(), file.getFileSize()));
+		gApp->SetPreviewTexture(gApp->GetGraphics()->LoadTextureFromMemory(file.getData(), file.getFileSize()));
 		gLastPreviewedFile = &file;
 		gPreviewTitle = file.getPath();
 
@@ -221,6 +334,507 @@ void UIImGui::RenderPreviewWindow(PCKAssetFile& file)
 	ImGui::End();
 }
 
+void UIImGui::RenderLocalisationWindow(PCKAssetFile& file)
+{
+	static char filter[256] = "";
+	static std::string lastFilter;
+	static std::vector<size_t> rows; // keys shown, after filtering
+	static std::vector<char> buffer;
+
+	if (gLocSource != &file || gLocRevision != file.getRevision())
+	{
+		gLocSource = &file;
+		gLocRevision = file.getRevision();
+		gLocError.clear();
+		lastFilter = "\x01"; // anything the filter can't be, so the rows are rebuilt
+
+		try
+		{
+			gLocFile = gInstance->assets.get<LOCFile>(file);
+
+			// requested all at once, so the font is only rebuilt the one time
+			for (size_t language = 0; language < gLocFile->getLanguageCount(); ++language)
+				for (size_t key = 0; key < gLocFile->getKeyCount(); ++key)
+					RequestGlyphs(std::string(gLocFile->getString(language, key)));
+		}
+		catch (std::exception& ex)
+		{
+			gLocFile = std::make_shared<LOCFile>();
+			gLocError = ex.what();
+		}
+	}
+
+	float windowPosX = ImGui::GetIO().DisplaySize.x * 0.25f;
+	ImVec2 windowSize(ImGui::GetIO().DisplaySize.x * 0.75f, ImGui::GetIO().DisplaySize.y - (ImGui::GetIO().DisplaySize.y * 0.35f));
+	ImGui::SetNextWindowPos(ImVec2(windowPosX, ImGui::GetFrameHeight()), ImGuiCond_Always);
+	ImGui::SetNextWindowSize(windowSize, ImGuiCond_Always);
+
+	std::string title = file.getPath() + " (" + std::to_string(gLocFile->getKeyCount()) + " keys, " +
+		std::to_string(gLocFile->getLanguageCount()) + " languages)###Preview";
+	ImGui::Begin(title.c_str(), nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize |
+		ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoBringToFrontOnFocus);
+
+	if (!gLocError.empty())
+	{
+		ImGui::Text("Failed to read LOC File: %s", gLocError.c_str());
+		ImGui::End();
+		return;
+	}
+
+	ImGui::SetNextItemWidth(-FLT_MIN);
+	ImGui::InputTextWithHint("##LocFilter", "Filter keys and strings", filter, IM_ARRAYSIZE(filter));
+
+	if (lastFilter != filter)
+	{
+		lastFilter = filter;
+		rows.clear();
+
+		for (size_t key = 0; key < gLocFile->getKeyCount(); ++key)
+		{
+			bool matches = lastFilter.empty() || gLocFile->getKey(key).find(lastFilter) != std::string_view::npos;
+
+			for (size_t language = 0; !matches && language < gLocFile->getLanguageCount(); ++language)
+				matches = gLocFile->getString(language, key).find(lastFilter) != std::string_view::npos;
+
+			if (matches)
+				rows.push_back(key);
+		}
+	}
+
+	const int columnCount = static_cast<int>(gLocFile->getLanguageCount()) + 1;
+	bool writeBack = false;
+	const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable |
+		ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
+
+	// only the rows on screen are drawn, since the tables are tens of thousands of strings
+	if (columnCount <= 512 && ImGui::BeginTable("LocTable", columnCount, flags))
+	{
+		ImGui::TableSetupScrollFreeze(1, 1);
+		ImGui::TableSetupColumn("Key", ImGuiTableColumnFlags_WidthFixed, 200.0f);
+		for (size_t language = 0; language < gLocFile->getLanguageCount(); ++language)
+			ImGui::TableSetupColumn(std::string(gLocFile->getLanguage(language)).c_str(), ImGuiTableColumnFlags_WidthFixed, 300.0f);
+		ImGui::TableHeadersRow();
+
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(rows.size()));
+		while (clipper.Step())
+		{
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+			{
+				size_t key = rows[row];
+				ImGui::TableNextRow();
+
+				ImGui::TableSetColumnIndex(0);
+				std::string_view keyName = gLocFile->getKey(key);
+				ImGui::TextUnformatted(keyName.data(), keyName.data() + keyName.size());
+
+				for (size_t language = 0; language < gLocFile->getLanguageCount(); ++language)
+				{
+					ImGui::TableSetColumnIndex(static_cast<int>(language) + 1);
+
+					if (!gLocFile->hasString(language, key))
+					{
+						ImGui::TextDisabled("-");
+						continue;
+					}
+
+					// room to type into, up to the most a LOC string can hold
+					std::string_view text = gLocFile->getString(language, key);
+					buffer.assign(std::min<size_t>(text.size() + 1024, 0x10000), '\0');
+					std::memcpy(buffer.data(), text.data(), std::min(text.size(), buffer.size() - 1));
+
+					ImGui::PushID(static_cast<int>(key * columnCount + language));
+					ImGui::SetNextItemWidth(-FLT_MIN);
+					if (ImGui::InputText("##String", buffer.data(), buffer.size()))
+					{
+						gLocFile->setString(language, key, buffer.data());
+						gInstance->assets.setPinned(file, true); // the change only lives in the decoded file until it's written back
+						RequestGlyphs(std::string(buffer.data()));
+					}
+					writeBack |= ImGui::IsItemDeactivatedAfterEdit();
+					ImGui::PopID();
+				}
+			}
+		}
+
+		ImGui::EndTable();
+
+		// written back once done typing instead of on every key press, even if the string scrolled out of view; selecting another file or saving flushes it too
+		if (writeBack || (gLocFile->isModified() && !ImGui::IsAnyItemActive()))
+			WriteBackEdits(*gLocFile, file);
+	}
+
+	ImGui::End();
+}
+
+// Renders the children of a game rule as tree nodes; children are only read from the file once their parent is opened
+static void RenderGameRuleChildren(UIImGui& ui, GRFFile::Rule& rule, std::vector<size_t>& path)
+{
+	for (size_t i = 0; i < rule.children.size(); ++i)
+	{
+		GRFFile::Rule& child = rule.children[i];
+		path.push_back(i);
+
+		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanAvailWidth;
+		if (child.childCount == 0)
+			flags |= ImGuiTreeNodeFlags_Leaf;
+		if (path == gGrfSelection)
+			flags |= ImGuiTreeNodeFlags_Selected;
+
+		// IDs go by index rather than address, so opened rules stay open after the file is read again
+		std::string_view name = gGrfFile->getString(child.nameID);
+		bool open = name.empty()
+			? ImGui::TreeNodeEx(reinterpret_cast<void*>(i), flags, "Rule %u", child.nameID)
+			: ImGui::TreeNodeEx(reinterpret_cast<void*>(i), flags, "%.*s", static_cast<int>(name.size()), name.data());
+
+		if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen())
+			gGrfSelection = path;
+
+		if (open)
+		{
+			if (!child.expanded)
+			{
+				gGrfFile->expandRule(child);
+				for (const auto& grandchild : child.children)
+					for (const auto& attribute : grandchild.attributes)
+						ui.RequestGlyphs(std::string(attribute.value));
+			}
+
+			RenderGameRuleChildren(ui, child, path);
+			ImGui::TreePop();
+		}
+
+		path.pop_back();
+	}
+}
+
+void UIImGui::RenderGameRulesWindow(PCKAssetFile& file)
+{
+	static std::vector<size_t> path;
+	static std::vector<char> buffer;
+
+	if (gGrfSource != &file || gGrfRevision != file.getRevision())
+	{
+		if (gGrfSource != &file)
+			gGrfSelection.clear();
+
+		gGrfSource = &file;
+		gGrfRevision = file.getRevision();
+		gGrfError.clear();
+
+		try
+		{
+			gGrfFile = gInstance->assets.get<GRFFile>(file);
+
+			for (uint32_t id = 0; id < gGrfFile->getStringCount(); ++id)
+				RequestGlyphs(std::string(gGrfFile->getString(id)));
+			for (const auto& rule : gGrfFile->getRoot().children)
+				for (const auto& attribute : rule.attributes)
+					RequestGlyphs(std::string(attribute.value));
+		}
+		catch (std::exception& ex)
+		{
+			gGrfFile = std::make_shared<GRFFile>();
+			gGrfError = ex.what();
+		}
+	}
+
+	float windowPosX = ImGui::GetIO().DisplaySize.x * 0.25f;
+	ImVec2 windowSize(ImGui::GetIO().DisplaySize.x * 0.75f, ImGui::GetIO().DisplaySize.y - (ImGui::GetIO().DisplaySize.y * 0.35f));
+	ImGui::SetNextWindowPos(ImVec2(windowPosX, ImGui::GetFrameHeight()), ImGuiCond_Always);
+	ImGui::SetNextWindowSize(windowSize, ImGuiCond_Always);
+
+	std::string title = file.getPath() + "###Preview";
+	ImGui::Begin(title.c_str(), nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize |
+		ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoBringToFrontOnFocus);
+
+	if (!gGrfError.empty())
+	{
+		ImGui::Text("Failed to read GRF File: %s", gGrfError.c_str());
+		ImGui::End();
+		return;
+	}
+
+	static const char* compressionNames[]{ "None", "RLE", "Compressed + RLE", "Compressed + RLE + CRC" };
+	ImGui::Text("Version %u, %s, %zu bytes of rules", gGrfFile->getVersion(),
+		compressionNames[static_cast<int>(gGrfFile->getCompression())], gGrfFile->getRulesSize());
+
+	// its CRC couldn't be written back to match, so edits would only make a file the game rejects
+	if (!gGrfFile->canWrite())
+	{
+		ImGui::SameLine();
+		ImGui::TextDisabled("(read only, unknown CRC)");
+	}
+
+	ImGui::BeginChild("GrfRules", ImVec2(ImGui::GetContentRegionAvail().x * 0.4f, 0), true);
+	path.clear();
+	RenderGameRuleChildren(*this, gGrfFile->getRoot(), path);
+	ImGui::EndChild();
+
+	ImGui::SameLine();
+
+	ImGui::BeginChild("GrfAttributes", ImVec2(0, 0), true);
+
+	bool writeBack = false;
+	GRFFile::Rule* selected = gGrfSelection.empty() ? nullptr : &gGrfFile->getRoot();
+	for (size_t index : gGrfSelection)
+	{
+		gGrfFile->expandRule(*selected);
+		if (index >= selected->children.size())
+		{
+			selected = nullptr;
+			break;
+		}
+		selected = &selected->children[index];
+	}
+
+	if (!selected)
+	{
+		ImGui::TextDisabled("Select a rule to edit its attributes");
+	}
+	else if (selected->attributes.empty())
+	{
+		ImGui::TextDisabled("No attributes");
+	}
+	else if (ImGui::BeginTable("GrfAttributeTable", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable))
+	{
+		ImGui::TableSetupColumn("Attribute", ImGuiTableColumnFlags_WidthFixed, 200.0f);
+		ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableHeadersRow();
+
+		for (size_t i = 0; i < selected->attributes.size(); ++i)
+		{
+			const GRFFile::Attribute& attribute = selected->attributes[i];
+			ImGui::TableNextRow();
+
+			ImGui::TableSetColumnIndex(0);
+			std::string_view name = gGrfFile->getString(attribute.nameID);
+			ImGui::TextUnformatted(name.data(), name.data() + name.size());
+
+			ImGui::TableSetColumnIndex(1);
+
+			// room to type into, up to the most an attribute can hold
+			buffer.assign(std::min<size_t>(attribute.value.size() + 1024, 0x10000), '\0');
+			std::memcpy(buffer.data(), attribute.value.data(), std::min(attribute.value.size(), buffer.size() - 1));
+
+			ImGui::PushID(static_cast<int>(i));
+			ImGui::SetNextItemWidth(-FLT_MIN);
+			ImGuiInputTextFlags flags = gGrfFile->canWrite() ? ImGuiInputTextFlags_None : ImGuiInputTextFlags_ReadOnly;
+			if (ImGui::InputText("##Value", buffer.data(), buffer.size(), flags))
+			{
+				gGrfFile->setAttribute(*selected, i, buffer.data());
+				gInstance->assets.setPinned(file, true);
+				RequestGlyphs(std::string(buffer.data()));
+			}
+			writeBack |= ImGui::IsItemDeactivatedAfterEdit();
+			ImGui::PopID();
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::EndChild();
+
+	// written back once done typing, like the LOC editor; recompressing is the slow part, so it's done on every core
+	if (writeBack || (gGrfFile->isModified() && !ImGui::IsAnyItemActive()))
+		WriteBackEdits(*gGrfFile, file);
+
+	ImGui::End();
+}
+
+// Shows an ARGB colour as a colour editor; returns true with the new colour if it was changed
+static bool ColourEditARGB(const char* label, uint32_t& argb)
+{
+	float colour[4]{
+		((argb >> 16) & 0xFF) / 255.0f,
+		((argb >> 8) & 0xFF) / 255.0f,
+		(argb & 0xFF) / 255.0f,
+		((argb >> 24) & 0xFF) / 255.0f
+	};
+
+	if (!ImGui::ColorEdit4(label, colour, ImGuiColorEditFlags_AlphaBar | ImGuiColorEditFlags_AlphaPreviewHalf | ImGuiColorEditFlags_DisplayHex))
+		return false;
+
+	auto toByte = [](float value) { return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+	argb = (toByte(colour[3]) << 24) | (toByte(colour[0]) << 16) | (toByte(colour[1]) << 8) | toByte(colour[2]);
+	return true;
+}
+
+void UIImGui::RenderColourTableWindow(PCKAssetFile& file)
+{
+	static char filter[256] = "";
+	static std::string lastFilter;
+	static std::vector<size_t> rows; // colours shown, after filtering
+	static std::vector<size_t> waterRows;
+
+	if (gColSource != &file || gColRevision != file.getRevision())
+	{
+		gColSource = &file;
+		gColRevision = file.getRevision();
+		gColError.clear();
+		lastFilter = "\x01"; // anything the filter can't be, so the rows are rebuilt
+
+		try
+		{
+			gColFile = gInstance->assets.get<COLFile>(file);
+		}
+		catch (std::exception& ex)
+		{
+			gColFile = std::make_shared<COLFile>();
+			gColError = ex.what();
+		}
+	}
+
+	float windowPosX = ImGui::GetIO().DisplaySize.x * 0.25f;
+	ImVec2 windowSize(ImGui::GetIO().DisplaySize.x * 0.75f, ImGui::GetIO().DisplaySize.y - (ImGui::GetIO().DisplaySize.y * 0.35f));
+	ImGui::SetNextWindowPos(ImVec2(windowPosX, ImGui::GetFrameHeight()), ImGuiCond_Always);
+	ImGui::SetNextWindowSize(windowSize, ImGuiCond_Always);
+
+	std::string title = file.getPath() + " (" + std::to_string(gColFile->getColourCount()) + " colours, " +
+		std::to_string(gColFile->getWaterColourCount()) + " water colours)###Preview";
+	ImGui::Begin(title.c_str(), nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize |
+		ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoBringToFrontOnFocus);
+
+	if (!gColError.empty())
+	{
+		ImGui::Text("Failed to read COL File: %s", gColError.c_str());
+		ImGui::End();
+		return;
+	}
+
+	ImGui::SetNextItemWidth(-FLT_MIN);
+	ImGui::InputTextWithHint("##ColFilter", "Filter names", filter, IM_ARRAYSIZE(filter));
+
+	if (lastFilter != filter)
+	{
+		lastFilter = filter;
+		rows.clear();
+		waterRows.clear();
+
+		for (size_t i = 0; i < gColFile->getColourCount(); ++i)
+			if (gColFile->getColourName(i).find(lastFilter) != std::string_view::npos)
+				rows.push_back(i);
+
+		for (size_t i = 0; i < gColFile->getWaterColourCount(); ++i)
+			if (gColFile->getWaterColourName(i).find(lastFilter) != std::string_view::npos)
+				waterRows.push_back(i);
+	}
+
+	const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+
+	if (ImGui::BeginTabBar("ColTabs"))
+	{
+		if (ImGui::BeginTabItem("Colours"))
+		{
+			if (ImGui::BeginTable("ColTable", 2, flags))
+			{
+				ImGui::TableSetupScrollFreeze(0, 1);
+				ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthFixed, 300.0f);
+				ImGui::TableSetupColumn("Colour", ImGuiTableColumnFlags_WidthStretch);
+				ImGui::TableHeadersRow();
+
+				ImGuiListClipper clipper;
+				clipper.Begin(static_cast<int>(rows.size()));
+				while (clipper.Step())
+				{
+					for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+					{
+						size_t index = rows[row];
+						ImGui::TableNextRow();
+
+						ImGui::TableSetColumnIndex(0);
+						std::string_view name = gColFile->getColourName(index);
+						ImGui::TextUnformatted(name.data(), name.data() + name.size());
+
+						ImGui::TableSetColumnIndex(1);
+						ImGui::PushID(static_cast<int>(index));
+						ImGui::SetNextItemWidth(-FLT_MIN);
+						uint32_t colour = gColFile->getColour(index);
+						if (ColourEditARGB("##Colour", colour))
+							gColFile->setColour(index, colour);
+						ImGui::PopID();
+					}
+				}
+
+				ImGui::EndTable();
+			}
+
+			ImGui::EndTabItem();
+		}
+
+		// only version 1 and up have water colours
+		if (gColFile->getVersion() > 0 && ImGui::BeginTabItem("Water Colours"))
+		{
+			if (ImGui::BeginTable("ColWaterTable", 4, flags))
+			{
+				ImGui::TableSetupScrollFreeze(0, 1);
+				ImGui::TableSetupColumn("Biome", ImGuiTableColumnFlags_WidthFixed, 200.0f);
+				ImGui::TableSetupColumn("Surface", ImGuiTableColumnFlags_WidthStretch);
+				ImGui::TableSetupColumn("Underwater", ImGuiTableColumnFlags_WidthStretch);
+				ImGui::TableSetupColumn("Fog", ImGuiTableColumnFlags_WidthStretch);
+				ImGui::TableHeadersRow();
+
+				ImGuiListClipper clipper;
+				clipper.Begin(static_cast<int>(waterRows.size()));
+				while (clipper.Step())
+				{
+					for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+					{
+						size_t index = waterRows[row];
+						ImGui::TableNextRow();
+
+						ImGui::TableSetColumnIndex(0);
+						std::string_view name = gColFile->getWaterColourName(index);
+						ImGui::TextUnformatted(name.data(), name.data() + name.size());
+
+						ImGui::PushID(static_cast<int>(index));
+						for (int column = 0; column < 3; ++column)
+						{
+							auto which = static_cast<COLFile::WaterColour>(column);
+
+							ImGui::TableSetColumnIndex(column + 1);
+							ImGui::PushID(column);
+							ImGui::SetNextItemWidth(-FLT_MIN);
+							uint32_t colour = gColFile->getWaterColour(index, which);
+							if (ColourEditARGB("##Colour", colour))
+								gColFile->setWaterColour(index, which, colour);
+							ImGui::PopID();
+						}
+						ImGui::PopID();
+					}
+				}
+
+				ImGui::EndTable();
+			}
+
+			ImGui::EndTabItem();
+		}
+
+		ImGui::EndTabBar();
+	}
+
+	// colours are changed right in the COL File's data, so writing it back is just a copy, and it's cheap enough to do on every change
+	WriteBackEdits(*gColFile, file);
+
+	ImGui::End();
+}
+
+void UIImGui::RenderModelsWindow(PCKAssetFile& file)
+{
+	float windowPosX = ImGui::GetIO().DisplaySize.x * 0.25f;
+	ImVec2 windowSize(ImGui::GetIO().DisplaySize.x * 0.75f, ImGui::GetIO().DisplaySize.y - (ImGui::GetIO().DisplaySize.y * 0.35f));
+	ImGui::SetNextWindowPos(ImVec2(windowPosX, ImGui::GetFrameHeight()), ImGuiCond_Always);
+	ImGui::SetNextWindowSize(windowSize, ImGuiCond_Always);
+
+	std::string title = file.getPath() + "###Preview";
+	ImGui::Begin(title.c_str(), nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize |
+		ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoBringToFrontOnFocus);
+
+	PreviewModels(file);
+
+	ImGui::End();
+}
+
 void UIImGui::RenderMenuBar()
 {
 	PCKFile* pckFile = gInstance->GetCurrentPCKFile();
@@ -242,6 +856,53 @@ void UIImGui::RenderMenuBar()
 			ImGui::EndMenu();
 		}
 
+		if (ImGui::BeginMenu("View")) {
+			const auto& platform = gApp->GetPlatform();
+
+			bool idleWait = platform->GetIdleWait();
+			if (ImGui::Checkbox("Power Saving (only redraw when something changes)", &idleWait))
+				platform->SetIdleWait(idleWait);
+
+			ImGui::NewLine();
+			ImGui::Text("Frame Rate Limit:");
+
+			static const int frameRateLimits[]{ 0, 30, 60, 120, 144 };
+			for (int limit : frameRateLimits) {
+				std::string label = (limit == 0) ? "Unlimited (VSync)" : std::to_string(limit) + " FPS";
+				if (ImGui::RadioButton(label.c_str(), platform->GetFrameRateLimit() == limit))
+					platform->SetFrameRateLimit(limit);
+			}
+
+			if (Trace::IsCompiledIn()) {
+				ImGui::NewLine();
+				ImGui::Text("Tracing:");
+
+				bool tracing = Trace::IsEnabled();
+				if (ImGui::Checkbox("Record Zones", &tracing))
+					Trace::SetEnabled(tracing);
+
+				ImGui::Checkbox("Show Zone Timings", &mShowTraceOverlay);
+
+				std::string saveLabel = "Save Trace... (" + std::to_string(Trace::GetEventCount()) + " zones)";
+				if (ImGui::MenuItem(saveLabel.c_str(), nullptr, nullptr, Trace::GetEventCount() > 0)) {
+					std::string path = platform->mDialog.SaveFile({ { "Chrome Trace (*.json)", "json" } }, "trace.json");
+					if (!path.empty()) {
+						try {
+							Trace::WriteChromeTrace(path);
+						}
+						catch (const std::exception& e) {
+							platform->mDialog.ShowError("Error", e.what());
+						}
+					}
+				}
+
+				if (ImGui::MenuItem("Clear Trace"))
+					Trace::Clear();
+			}
+
+			ImGui::EndMenu();
+		}
+
 		if (pckFile)
 		{
 			if (ImGui::BeginMenu("PCK"))
@@ -257,6 +918,19 @@ void UIImGui::RenderMenuBar()
 					gInstance->pckEndianness = Binary::Endianness::BIG;
 				}
 
+				ImGui::NewLine();
+				// works on the file as saved, so unsaved edits aren't part of the converted copy
+				bool saved = !pckFile->getFilePath().empty();
+				if (ImGui::MenuItem("Convert to Little Endian...", nullptr, nullptr, saved))
+					ConvertPCKFileDialog(Binary::Endianness::LITTLE);
+				if (ImGui::MenuItem("Convert to Big Endian...", nullptr, nullptr, saved))
+					ConvertPCKFileDialog(Binary::Endianness::BIG);
+
+				ImGui::NewLine();
+				ImGui::MenuItem("Duplicate Files", nullptr, &mShowDuplicates);
+				if (ImGui::MenuItem("Compare With..."))
+					ComparePCKFileDialog();
+
 				ImGui::NewLine();
 				if (ImGui::Checkbox("Full BOX Support (for Skins)", &gInstance->hasXMLSupport)) {
 					pckFile->setXMLSupport(gInstance->hasXMLSupport);
@@ -276,6 +950,10 @@ void UIImGui::HandleInput()
 		gInstance = gApp->GetInstance();
 	PCKFile* pckFile = gInstance->GetCurrentPCKFile();
 
+	// nothing may touch the PCK while a job is working on it
+	if (gInstance->jobs.IsBusy())
+		return;
+
 	const auto& platform = gApp->GetPlatform();
 
 	// make sure to pass false or else it will trigger multiple times
@@ -367,11 +1045,36 @@ void UIImGui::RenderFileTree()
 
 		if (selectedFile) break;
 	}
+	// whatever the last editor changed is written back before another file takes its place
+	static const PCKAssetFile* lastSelectedFile = nullptr;
+	if (selectedFile != lastSelectedFile)
+	{
+		FlushEdits();
+		lastSelectedFile = selectedFile;
+	}
+
 	if (selectedFile)
 	{
-		if (selectedFile->isImageType())
+		// assets with their own editor get it in place of the preview
+		switch (selectedFile->getAssetType())
 		{
-			RenderPreviewWindow(*selectedFile);
+		case PCKAssetFile::Type::LOCALISATION:
+			RenderLocalisationWindow(*selectedFile);
+			break;
+		case PCKAssetFile::Type::GAME_RULES:
+		case PCKAssetFile::Type::GAME_RULES_HEADER:
+			RenderGameRulesWindow(*selectedFile);
+			break;
+		case PCKAssetFile::Type::COLOUR_TABLE:
+			RenderColourTableWindow(*selectedFile);
+			break;
+		case PCKAssetFile::Type::MODELS:
+			RenderModelsWindow(*selectedFile);
+			break;
+		default:
+			if (selectedFile->isImageType())
+				RenderPreviewWindow(*selectedFile);
+			break;
 		}
 
 		RenderPropertiesWindow(*selectedFile);
@@ -395,7 +1098,7 @@ void UIImGui::RenderFileTree()
 		{
 			if (gApp->GetPlatform()->ShowYesNoMessagePrompt("Open PCK?", "Are you sure you want to open this PCK file? Your unsaved changes will be lost."))
 			{
-				gApp->GetInstance()->LoadPCKFile(gDroppedFilePath);
+				OpenPCKFile(gDroppedFilePath);
 				ImGui::CloseCurrentPopup();
 			}
 		}
@@ -433,19 +1136,11 @@ void UIImGui::RenderFileTree()
 
 		if (ImGui::Button("Import"))
 		{
-			try
-			{
-				pckFile->addFileFromDisk(gDroppedFilePath, std::string(new_path), static_cast<PCKAssetFile::Type>(typeIndex));
-				gUpdatePCKCollection = true;
-			}
-			catch (std::exception& ex)
-			{
-				platform->mDialog.ShowError("Error", ex.what());
-			}
-			catch (...)
-			{
-				platform->mDialog.ShowError("Error", "Unknown error occured");
-			}
+			std::string fileName = std::filesystem::path(gDroppedFilePath).filename().string();
+			std::string pckPath = std::string(new_path).empty() ? fileName : std::string(new_path);
+
+			PCKImporter::Entry entry{ gDroppedFilePath, pckPath, static_cast<PCKAssetFile::Type>(typeIndex) };
+			ImportFiles(fileName, [entry]() { return std::vector<PCKImporter::Entry>{ entry }; });
 			ImGui::CloseCurrentPopup();
 		}
 
@@ -476,22 +1171,13 @@ void UIImGui::RenderFileTree()
 		{
 			try
 			{
-				for (auto const& dir_entry : std::filesystem::recursive_directory_iterator(gDroppedFilePath))
-				{
-					if (!dir_entry.is_regular_file())
-						continue;
+				// walked on the job too, since big folders take a while just to list
+				std::filesystem::path directory = gDroppedFilePath;
+				std::string baseFolder = new_path;
 
-					// I don't know why it's not getting the name here but it was in the file pop up lol
-					std::string base_folder = std::string(new_path).empty() ? std::filesystem::path(gDroppedFilePath).filename().string() : std::string(new_path);
-
-					std::filesystem::path relativePath = std::filesystem::relative(dir_entry.path(), gDroppedFilePath);
-					std::string fullPathInPck = base_folder + "/" + relativePath.string();
-
-					SDL_Log("%s", new_path);
-
-					// Add file to PCK
-					pckFile->addFileFromDisk(dir_entry.path().string(), fullPathInPck, PCKAssetFile::getPreferredAssetType(dir_entry.path().string()));
-				}
+				ImportFiles(directory.filename().string(), [directory, baseFolder]() {
+					return PCKImporter::CollectDirectory(directory, baseFolder);
+				});
 			}
 			catch (std::exception& ex)
 			{
@@ -539,6 +1225,8 @@ void UIImGui::RenderFileTree()
 		{
 			try
 			{
+				RequestGlyphs(std::string(new_path));
+
 				if(selectedFile)
 					selectedFile->setPath(new_path);
 				else
@@ -611,6 +1299,7 @@ void UIImGui::RenderFileTree()
 				std::string key = line.substr(0, spacePos);
 				std::string value = line.substr(spacePos + 1);
 				selectedFile->addProperty(key, Binary::ToUTF16(value));
+				RequestGlyphs(value);
 			}
 
 			ImGui::CloseCurrentPopup();
@@ -639,6 +1328,7 @@ void UIImGui::RenderContextMenu(FileTreeNode& node)
 		if (ImGui::BeginMenu("Extract")) {
 			if (isFile && ImGui::MenuItem("File"))
 			{
+				node.file->updateNestedData(); // edits in a nested PCK File aren't in its data until written back
 				WriteFileDataDialog(*node.file);
 			}
 			if (!isFile && ImGui::MenuItem("Files"))
@@ -659,6 +1349,7 @@ void UIImGui::RenderContextMenu(FileTreeNode& node)
 
 			if (isFile && hasProperties && ImGui::MenuItem("File with Properties"))
 			{
+				node.file->updateNestedData();
 				WriteFileDataDialog(*node.file, true);
 			}
 
@@ -713,6 +1404,263 @@ static void RenderPropertiesContextMenu(PCKAssetFile& file, int propertyIndex =
 	}
 }
 
+// Shows a string as a text box; returns true with the new string if it was changed
+static bool InputString(const char* label, std::string& value)
+{
+	char buffer[0x100];
+	std::size_t len = std::min(value.size(), sizeof(buffer) - 1);
+	std::memcpy(buffer, value.data(), len);
+	buffer[len] = '\0';
+
+	if (!ImGui::InputText(label, buffer, sizeof(buffer)))
+		return false;
+
+	value = buffer;
+	return true;
+}
+
+// Renders the materials of an entityMaterials.bin as an editable table; every change is written straight back to just that asset
+static void RenderMaterialsEditor(PCKAssetFile& file)
+{
+	static std::shared_ptr<MaterialsFile> materials = std::make_shared<MaterialsFile>();
+	static const PCKAssetFile* source = nullptr;
+	static uint32_t revision = 0;
+	static std::string error;
+
+	if (source != &file || revision != file.getRevision())
+	{
+		source = &file;
+		revision = file.getRevision();
+		error.clear();
+
+		try
+		{
+			materials = gInstance->assets.get<MaterialsFile>(file);
+		}
+		catch (std::exception& ex)
+		{
+			materials = std::make_shared<MaterialsFile>();
+			error = ex.what();
+		}
+	}
+
+	ImGui::Separator();
+
+	if (!error.empty())
+	{
+		ImGui::Text("Failed to read entityMaterials.bin: %s", error.c_str());
+		return;
+	}
+
+	auto& entries = materials->getMaterials();
+	bool modified = false;
+	int removed = -1;
+
+	ImGui::Text("Entity Materials (%zu)", entries.size());
+
+	if (ImGui::BeginTable("MaterialsTable", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+	{
+		ImGui::TableSetupColumn("Entity");
+		ImGui::TableSetupColumn("Material");
+		ImGui::TableSetupColumn("##Remove", ImGuiTableColumnFlags_WidthFixed, ImGui::GetFrameHeight());
+		ImGui::TableHeadersRow();
+
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			auto& material = entries[i];
+			ImGui::PushID(static_cast<int>(i));
+			ImGui::TableNextRow();
+
+			ImGui::TableSetColumnIndex(0);
+			ImGui::SetNextItemWidth(-FLT_MIN);
+			modified |= InputString("##Name", material.name);
+
+			// any type can be typed in, but the known ones are a click away
+			ImGui::TableSetColumnIndex(1);
+			ImGui::SetNextItemWidth(-FLT_MIN);
+			if (ImGui::BeginCombo("##Type", material.type.c_str()))
+			{
+				for (const auto& type : MaterialsFile::getKnownTypes())
+				{
+					if (ImGui::Selectable(type.c_str(), type == material.type))
+					{
+						material.type = type;
+						modified = true;
+					}
+				}
+				ImGui::EndCombo();
+			}
+
+			ImGui::TableSetColumnIndex(2);
+			if (ImGui::Button("X"))
+				removed = static_cast<int>(i);
+
+			ImGui::PopID();
+		}
+
+		ImGui::EndTable();
+	}
+
+	if (removed >= 0)
+	{
+		entries.erase(entries.begin() + removed);
+		modified = true;
+	}
+
+	if (ImGui::Button("Add Material"))
+	{
+		entries.push_back({ "entity", MaterialsFile::getKnownTypes()[1] });
+		modified = true;
+	}
+
+	if (modified)
+	{
+		std::vector<unsigned char> data;
+		materials->Write(data);
+		file.setData(std::move(data));
+		revision = file.getRevision(); // already up to date, so it isn't read again
+	}
+}
+
+// Renders the rider positions of a behaviours.bin as editable tables; every change is written straight back to just that asset
+static void RenderBehavioursEditor(PCKAssetFile& file)
+{
+	static std::shared_ptr<BehavioursFile> behaviours = std::make_shared<BehavioursFile>();
+	static const PCKAssetFile* source = nullptr;
+	static uint32_t revision = 0;
+	static std::string error;
+
+	if (source != &file || revision != file.getRevision())
+	{
+		source = &file;
+		revision = file.getRevision();
+		error.clear();
+
+		try
+		{
+			behaviours = gInstance->assets.get<BehavioursFile>(file);
+		}
+		catch (std::exception& ex)
+		{
+			behaviours = std::make_shared<BehavioursFile>();
+			error = ex.what();
+		}
+	}
+
+	ImGui::Separator();
+
+	if (!error.empty())
+	{
+		ImGui::Text("Failed to read behaviours.bin: %s", error.c_str());
+		return;
+	}
+
+	auto& entries = behaviours->getBehaviours();
+	bool modified = false;
+	int removed = -1;
+
+	ImGui::Text("Behaviours (%zu)", entries.size());
+
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		auto& behaviour = entries[i];
+		ImGui::PushID(static_cast<int>(i));
+
+		bool open = ImGui::TreeNodeEx("##Behaviour", ImGuiTreeNodeFlags_AllowOverlap, "%s (%zu)", behaviour.name.c_str(), behaviour.overrides.size());
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Remove"))
+			removed = static_cast<int>(i);
+
+		if (open)
+		{
+			ImGui::SetNextItemWidth(200.0f);
+			modified |= InputString("Entity", behaviour.name);
+
+			int removedOverride = -1;
+
+			if (ImGui::BeginTable("OverridesTable", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+			{
+				ImGui::TableSetupColumn("Tamed", ImGuiTableColumnFlags_WidthFixed);
+				ImGui::TableSetupColumn("Saddled", ImGuiTableColumnFlags_WidthFixed);
+				ImGui::TableSetupColumn("Rider Position");
+				ImGui::TableSetupColumn("##Remove", ImGuiTableColumnFlags_WidthFixed, ImGui::GetFrameHeight());
+				ImGui::TableHeadersRow();
+
+				for (size_t j = 0; j < behaviour.overrides.size(); ++j)
+				{
+					auto& positionOverride = behaviour.overrides[j];
+					ImGui::PushID(static_cast<int>(j));
+					ImGui::TableNextRow();
+
+					ImGui::TableSetColumnIndex(0);
+					bool tamed = positionOverride.isTamed();
+					if (ImGui::Checkbox("##Tamed", &tamed))
+					{
+						positionOverride.setTamed(tamed);
+						modified = true;
+					}
+
+					ImGui::TableSetColumnIndex(1);
+					bool saddled = positionOverride.isSaddled();
+					if (ImGui::Checkbox("##Saddled", &saddled))
+					{
+						positionOverride.setSaddled(saddled);
+						modified = true;
+					}
+
+					ImGui::TableSetColumnIndex(2);
+					ImGui::SetNextItemWidth(-FLT_MIN);
+					modified |= ImGui::DragFloat3("##Position", &positionOverride.x, 0.0625f);
+
+					ImGui::TableSetColumnIndex(3);
+					if (ImGui::Button("X"))
+						removedOverride = static_cast<int>(j);
+
+					ImGui::PopID();
+				}
+
+				ImGui::EndTable();
+			}
+
+			if (removedOverride >= 0)
+			{
+				behaviour.overrides.erase(behaviour.overrides.begin() + removedOverride);
+				modified = true;
+			}
+
+			if (ImGui::Button("Add Position"))
+			{
+				behaviour.overrides.emplace_back();
+				modified = true;
+			}
+
+			ImGui::TreePop();
+		}
+
+		ImGui::PopID();
+	}
+
+	if (removed >= 0)
+	{
+		entries.erase(entries.begin() + removed);
+		modified = true;
+	}
+
+	if (ImGui::Button("Add Behaviour"))
+	{
+		entries.push_back({ "entity", { {} } });
+		modified = true;
+	}
+
+	if (modified)
+	{
+		std::vector<unsigned char> data;
+		behaviours->Write(data);
+		file.setData(std::move(data));
+		revision = file.getRevision(); // already up to date, so it isn't read again
+	}
+}
+
 void UIImGui::RenderPropertiesWindow(PCKAssetFile& file)
 {
 	if (gLastPreviewedFile != &file) {
@@ -807,6 +1755,7 @@ void UIImGui::RenderPropertiesWindow(PCKAssetFile& file)
 						c = std::toupper(c);
 
 					file.setPropertyAtIndex(propertyIndex, keyText.empty() ? "KEY" : keyText, Binary::ToUTF16(valueBuffer));
+					RequestGlyphs(std::string(valueBuffer));
 				}
 
 				++propertyIndex;
@@ -816,6 +1765,19 @@ void UIImGui::RenderPropertiesWindow(PCKAssetFile& file)
 		}
 	}
 
+	// small binary assets have no preview, so their editors go under the properties
+	switch (file.getAssetType())
+	{
+	case PCKAssetFile::Type::MATERIALS:
+		RenderMaterialsEditor(file);
+		break;
+	case PCKAssetFile::Type::BEHAVIOURS:
+		RenderBehavioursEditor(file);
+		break;
+	default:
+		break;
+	}
+
 	ImGui::End();
 }
 
@@ -833,7 +1795,10 @@ void UpdateNodePathRecursive(FileTreeNode& node, const std::string& newBasePath)
 	node.path = newBasePath;
 
 	if (node.file)
-		node.file->setPath(newBasePath);
+	{
+		node.file->setPath(GetPathInPack(node));
+		return; // a nested PCK File's own files keep their paths
+	}
 
 	for (auto& child : node.children) {
 		std::filesystem::path rel = std::filesystem::relative(child.path, oldBase);
@@ -859,7 +1824,8 @@ void UIImGui::RenderNode(FileTreeNode& node, std::vector<const FileTreeNode*>* v
 
 	if (isFolder)
 	{
-		ImGui::Image((void*)(intptr_t)gApp->GetFolderIcon().id, ImVec2(48, 48));
+		const TextureRegion& icon = gApp->GetFolderIcon();
+		ImGui::Image((void*)(intptr_t)icon.id, ImVec2(48, 48), ImVec2(icon.u0, icon.v0), ImVec2(icon.u1, icon.v1));
 		ImGui::SameLine();
 
 		if (node.path == gInstance->selectedNodePath && (openFolder || closeFolder))
@@ -888,7 +1854,7 @@ void UIImGui::RenderNode(FileTreeNode& node, std::vector<const FileTreeNode*>* v
 				if (draggedPath != node.path && draggedPath != targetFolder && !(IsDescendantPath(targetFolder, draggedPath))) {
 					FileTreeNode* draggedNode = FindNodeByPath(draggedPath, gApp->GetInstance()->treeNodes);
 
-					if (draggedNode) {
+					if (draggedNode && draggedNode->pack == node.pack) {
 						std::filesystem::path newPath = std::filesystem::path(targetFolder) /
 							std::filesystem::path(draggedNode->path).filename();
 
@@ -907,14 +1873,40 @@ void UIImGui::RenderNode(FileTreeNode& node, std::vector<const FileTreeNode*>* v
 	}
 	else if (node.file) // File Nodes
 	{
-		const PCKAssetFile& file = *node.file;
-		ImGui::Image((void*)(intptr_t)gApp->GetFileIcon(file.getAssetType()).id, ImVec2(48, 48));
+		PCKAssetFile& file = *node.file;
+		const TextureRegion& icon = gApp->GetFileIcon(file.getAssetType());
+		ImGui::Image((void*)(intptr_t)icon.id, ImVec2(48, 48), ImVec2(icon.u0, icon.v0), ImVec2(icon.u1, icon.v1));
 		ImGui::SameLine();
 
 		std::string label = std::filesystem::path(file.getPath()).filename().string();
 		std::string id = label + "###" + file.getPath();
 
-		if (ImGui::Selectable(id.c_str(), isSelected) || IsClicked())
+		bool open = false;
+		if (file.isPCKType())
+		{
+			// nested PCK Files open like folders, and aren't read until they are
+			if (isSelected && (openFolder || closeFolder))
+				ImGui::SetNextItemOpen(openFolder, ImGuiCond_Always);
+
+			open = ImGui::TreeNodeEx(id.c_str(), flags);
+
+			if (open && !file.getLoadedNestedPCK())
+			{
+				try
+				{
+					file.getNestedPCK();
+				}
+				catch (std::exception& ex)
+				{
+					ImGui::GetStateStorage()->SetInt(ImGui::GetItemID(), 0); // closed again, or it'd try every frame
+					platform->mDialog.ShowError("Error", "Failed to read " + file.getPath() + ": " + ex.what());
+				}
+			}
+
+			if (IsClicked())
+				gInstance->selectedNodePath = node.path;
+		}
+		else if (ImGui::Selectable(id.c_str(), isSelected) || IsClicked())
 			gInstance->selectedNodePath = node.path;
 
 		gApp->GetUI()->RenderContextMenu(node);
@@ -935,9 +1927,9 @@ void UIImGui::RenderNode(FileTreeNode& node, std::vector<const FileTreeNode*>* v
 				if (draggedPath != node.path && !IsDescendantPath(draggedPath, node.path)) {
 					FileTreeNode* draggedNode = FindNodeByPath(draggedPath, gApp->GetInstance()->treeNodes);
 
-					// move file to folder AND index of the file it was dropped on
-					if (draggedNode && draggedNode->file && node.file) {
-						PCKFile* pckFile = gInstance->GetCurrentPCKFile();
+					// move file to folder AND index of the file it was dropped on; only within the same PCK File
+					if (draggedNode && draggedNode->file && node.file && draggedNode->pack == node.pack) {
+						PCKFile* pckFile = node.pack;
 						const PCKAssetFile* draggedFile = draggedNode->file;
 						const PCKAssetFile* targetFile = node.file;
 
@@ -966,6 +1958,12 @@ void UIImGui::RenderNode(FileTreeNode& node, std::vector<const FileTreeNode*>* v
 			}
 			ImGui::EndDragDropTarget();
 		}
+
+		if (open) {
+			for (auto& child : node.children)
+				RenderNode(child, visibleList, shouldScroll, openFolder, closeFolder);
+			ImGui::TreePop();
+		}
 	}
 
 	ImGui::PopID();
@@ -973,10 +1971,10 @@ void UIImGui::RenderNode(FileTreeNode& node, std::vector<const FileTreeNode*>* v
 
 void UIImGui::ShowFileDropPopUp(const std::string& filepath)
 {
-	if (gPopupState != PopupState::NONE)
+	if (gPopupState != PopupState::NONE || gApp->GetInstance()->jobs.IsBusy())
 		return;
 
-	printf("DROPPED PATH: %s\n", gDroppedFilePath.c_str());
+	LOG_DEBUG("Dropped path: %s", gDroppedFilePath.c_str());
 
 	std::filesystem::path path = std::filesystem::path(filepath);
 
@@ -993,7 +1991,7 @@ void UIImGui::ShowFileDropPopUp(const std::string& filepath)
 
 		// if initially dropped when there is no PCK file opened
 		if (!pckExists)
-			gApp->GetInstance()->LoadPCKFile(gDroppedFilePath);
+			OpenPCKFile(gDroppedFilePath);
 	}
 	else if(pckExists) // only accept non pck file drag and drop when a pck is already opened
 	{
@@ -1007,4 +2005,418 @@ void UIImGui::ShowFileDropPopUp(const std::string& filepath)
 			gPopupState = PopupState::IMPORT_DIRECTORY; // insert directory
 		}
 	}
-}
\ No newline at end of file
+}
+
+void UIImGui::RenderJobProgress()
+{
+	JobSystem& jobs = gApp->GetInstance()->jobs;
+
+	if (jobs.IsBusy() && !ImGui::IsPopupOpen(JOB_PROGRESS_POPUP_TITLE))
+		ImGui::OpenPopup(JOB_PROGRESS_POPUP_TITLE);
+
+	// modal, so nothing else can be clicked while the job runs
+	ImGui::SetNextWindowPos(ImGui::GetMainViewport()->GetCenter(), ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+	if (ImGui::BeginPopupModal(JOB_PROGRESS_POPUP_TITLE, nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoMove))
+	{
+		const JobProgress* progress = jobs.GetProgress();
+
+		if (!progress)
+		{
+			ImGui::CloseCurrentPopup();
+		}
+		else
+		{
+			ImGui::TextUnformatted(jobs.GetName().c_str());
+			ImGui::TextDisabled("%s", progress->getStatus().c_str());
+
+			char overlay[64];
+			snprintf(overlay, sizeof(overlay), "%.1f / %.1f MB", progress->getDone() / (1024.0 * 1024.0), progress->getTotal() / (1024.0 * 1024.0));
+			ImGui::ProgressBar(progress->getFraction(), ImVec2(400.0f, 0.0f), overlay);
+
+			if (progress->isCancelled())
+				ImGui::TextUnformatted("Cancelling...");
+			else if (ImGui::Button("Cancel"))
+				jobs.Cancel();
+
+			// keeps the bar moving while the main loop would otherwise idle
+			gApp->GetPlatform()->RequestRedraw(100);
+		}
+
+		ImGui::EndPopup();
+	}
+}
+
+void UIImGui::RenderTraceOverlay()
+{
+	if (!mShowTraceOverlay)
+		return;
+
+	// top right, out of the way of the tree
+	const ImGuiViewport* viewport = ImGui::GetMainViewport();
+	ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - 10.0f, viewport->WorkPos.y + 10.0f), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+	ImGui::SetNextWindowBgAlpha(0.75f);
+
+	ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings |
+		ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove;
+
+	if (ImGui::Begin("Zone Timings", &mShowTraceOverlay, flags))
+	{
+		if (!Trace::IsEnabled())
+		{
+			ImGui::TextDisabled("Turn on View > Record Zones to see timings");
+		}
+		else if (ImGui::BeginTable("Zones", 3, ImGuiTableFlags_SizingFixedFit))
+		{
+			std::vector<Trace::ZoneTiming> zones = Trace::GetLastFrame();
+			std::sort(zones.begin(), zones.end(), [](const Trace::ZoneTiming& a, const Trace::ZoneTiming& b) {
+				return a.milliseconds > b.milliseconds;
+				});
+
+			for (const Trace::ZoneTiming& zone : zones)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(zone.name);
+				ImGui::TableNextColumn();
+				ImGui::Text(" %8.3f ms", zone.milliseconds);
+				ImGui::TableNextColumn();
+				ImGui::TextDisabled(" x%u", zone.count);
+			}
+
+			ImGui::EndTable();
+		}
+	}
+	ImGui::End();
+}
+
+// Searches the PCK File for duplicate files in a job; nested PCK Files are read first, here, so the job only ever reads the PCK
+static void FindDuplicateFiles(PCKFile& pckFile)
+{
+	auto entries = std::make_shared<std::vector<PCKDeduplicator::Entry>>();
+	PCKDeduplicator::CollectFiles(pckFile, pckFile.getFileName(), *entries);
+	uint32_t revision = pckFile.getRevision(); // after collecting, since nested PCK Files read for the first time bump it
+
+	gDuplicatesSource = &pckFile;
+	auto result = std::make_shared<PCKDeduplicator::Result>();
+
+	gInstance->jobs.Start("Finding duplicate files in " + pckFile.getFileName(),
+		[entries, result](JobProgress& progress) {
+			*result = PCKDeduplicator::FindDuplicates(*entries, &progress);
+		},
+		[result, revision]() {
+			gDuplicates = std::move(*result);
+			gDuplicatesRevision = revision;
+			gDuplicatesShared = 0;
+
+			gDuplicateRows.clear();
+			for (size_t group = 0; group < gDuplicates.groups.size(); ++group)
+			{
+				gDuplicateRows.push_back({ group });
+				const auto& files = gDuplicates.groups[group].files;
+				for (size_t file = 0; file < files.size(); ++file)
+					gDuplicateRows.push_back({ group, file, files[file].pack, files[file].file->getPath() });
+			}
+		});
+}
+
+void UIImGui::RenderDuplicatesWindow()
+{
+	PCKFile* pckFile = gInstance ? gInstance->GetCurrentPCKFile() : nullptr;
+	if (!mShowDuplicates || !pckFile)
+		return;
+
+	bool busy = gInstance->jobs.IsBusy();
+
+	// searched by itself the first time, then only when asked to, so edits don't set off a search every time
+	if (gDuplicatesSource != pckFile && !busy)
+	{
+		gDuplicates = {};
+		gDuplicateRows.clear();
+		FindDuplicateFiles(*pckFile);
+		busy = true;
+	}
+
+	// the report only points at the files it found for as long as nothing changed; reading the revision is fine while a job reads the PCK too
+	bool stale = gDuplicatesRevision != gInstance->GetCurrentPCKRevision();
+
+	ImGui::SetNextWindowSize(ImVec2(ImGui::GetIO().DisplaySize.x * 0.5f, ImGui::GetIO().DisplaySize.y * 0.5f), ImGuiCond_FirstUseEver);
+	if (ImGui::Begin("Duplicate Files", &mShowDuplicates))
+	{
+		ImGui::Text("%zu duplicate(s) of %zu file(s), %llu bytes wasted", gDuplicates.getDuplicateCount(), gDuplicates.groups.size(),
+			(unsigned long long)gDuplicates.getWastedSize());
+
+		// nothing may touch the PCK while a job is working on it
+		if (!busy)
+		{
+			ImGui::SameLine();
+			if (stale)
+			{
+				ImGui::TextDisabled("(edited since)");
+				ImGui::SameLine();
+				if (ImGui::SmallButton("Search Again"))
+					FindDuplicateFiles(*pckFile);
+			}
+			else
+			{
+				if (ImGui::Button("Share Duplicate Data"))
+					gDuplicatesShared += PCKDeduplicator::ShareDuplicates(gDuplicates);
+				if (ImGui::IsItemHovered())
+					ImGui::SetTooltip("Holds identical data in memory only once; the saved PCK File stays the same");
+			}
+		}
+
+		if (gDuplicatesShared > 0)
+		{
+			ImGui::SameLine();
+			ImGui::TextDisabled("%llu bytes freed", (unsigned long long)gDuplicatesShared);
+		}
+
+		const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+		if (ImGui::BeginTable("Duplicates", 2, flags))
+		{
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableSetupColumn("Pack", ImGuiTableColumnFlags_WidthFixed, 200.0f);
+			ImGui::TableSetupColumn("File", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableHeadersRow();
+
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(gDuplicateRows.size()));
+			while (clipper.Step())
+			{
+				for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+				{
+					const DuplicateRow& duplicateRow = gDuplicateRows[row];
+					const PCKDeduplicator::Group& group = gDuplicates.groups[duplicateRow.group];
+					ImGui::TableNextRow();
+
+					if (duplicateRow.file == SIZE_MAX)
+					{
+						ImGui::TableSetColumnIndex(0);
+						ImGui::TextDisabled("%016llx", (unsigned long long)group.hash);
+						ImGui::TableSetColumnIndex(1);
+						ImGui::TextDisabled("%zu bytes x %zu, %llu bytes wasted", group.size, group.files.size(), (unsigned long long)group.getWastedSize());
+						continue;
+					}
+
+					ImGui::TableSetColumnIndex(0);
+					ImGui::TextUnformatted(duplicateRow.pack.c_str());
+					ImGui::TableSetColumnIndex(1);
+					ImGui::TextUnformatted(duplicateRow.path.c_str());
+				}
+			}
+
+			ImGui::EndTable();
+		}
+	}
+	ImGui::End();
+}
+
+void UIImGui::RenderComparisonWindow()
+{
+	PCKFile* pckFile = gInstance ? gInstance->GetCurrentPCKFile() : nullptr;
+
+	// nothing may touch the PCK while a job is working on it
+	if (!pckFile || !gInstance->comparison || gInstance->jobs.IsBusy())
+		return;
+
+	const PCKDiff& diff = *gInstance->comparison;
+	static const PCKDiff* rowsSource = nullptr;
+	static int filter = -1; // the change type shown, or -1 for all of them
+	static int rowsFilter = -1;
+	static std::vector<size_t> rows; // changes shown, after filtering
+	static size_t selected = PCKDiff::NONE;
+
+	if (rowsSource != &diff)
+	{
+		// the PCK File on disk wasn't loaded, so its paths and changed values haven't been baked into the font yet
+		for (const PCKDiff::Change& change : diff.getChanges())
+		{
+			if (change.oldFile != PCKDiff::NONE)
+				RequestGlyphs(diff.getOldFiles()[change.oldFile].path);
+			for (const PCKDiff::PropertyChange& property : change.properties)
+				RequestGlyphs(property.oldValue);
+		}
+
+		selected = PCKDiff::NONE;
+	}
+
+	if (rowsSource != &diff || rowsFilter != filter)
+	{
+		rowsSource = &diff;
+		rowsFilter = filter;
+		rows.clear();
+		for (size_t i = 0; i < diff.getChanges().size(); ++i)
+			if (filter < 0 || diff.getChanges()[i].type == static_cast<PCKDiff::ChangeType>(filter))
+				rows.push_back(i);
+	}
+
+	std::string oldName = std::filesystem::path(gInstance->comparisonPath).filename().string();
+
+	ImGui::SetNextWindowSize(ImVec2(ImGui::GetIO().DisplaySize.x * 0.75f, ImGui::GetIO().DisplaySize.y * 0.6f), ImGuiCond_FirstUseEver);
+
+	bool open = true;
+	std::string title = "Compare " + oldName + " with " + pckFile->getFileName() + "###Comparison";
+	if (ImGui::Begin(title.c_str(), &open))
+	{
+		ImGui::Text("%zu added, %zu removed, %zu renamed, %zu changed, %zu unchanged",
+			diff.getChangeCount(PCKDiff::ChangeType::ADDED), diff.getChangeCount(PCKDiff::ChangeType::REMOVED),
+			diff.getChangeCount(PCKDiff::ChangeType::RENAMED), diff.getChangeCount(PCKDiff::ChangeType::CHANGED), diff.getUnchangedCount());
+
+		if (gInstance->GetCurrentPCKRevision() != gInstance->comparisonRevision)
+		{
+			ImGui::SameLine();
+			ImGui::TextDisabled("(edited since)");
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Compare Again"))
+				ComparePCKFile(gInstance->comparisonPath);
+		}
+
+		ImGui::RadioButton("All", &filter, -1);
+		for (int type = 0; type <= static_cast<int>(PCKDiff::ChangeType::CHANGED); ++type)
+		{
+			ImGui::SameLine();
+			ImGui::RadioButton(PCKDiff::getChangeTypeString(static_cast<PCKDiff::ChangeType>(type)), &filter, type);
+		}
+
+		const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+		float detailsHeight = ImGui::GetContentRegionAvail().y * 0.35f;
+
+		// only the rows on screen are drawn, since updates can touch thousands of files
+		if (ImGui::BeginTable("Changes", 3, flags, ImVec2(0, -detailsHeight)))
+		{
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableSetupColumn("Change", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+			ImGui::TableSetupColumn(oldName.c_str(), ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableSetupColumn(pckFile->getFileName().c_str(), ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableHeadersRow();
+
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(rows.size()));
+			while (clipper.Step())
+			{
+				for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+				{
+					const PCKDiff::Change& change = diff.getChanges()[rows[row]];
+					ImGui::TableNextRow();
+					ImGui::PushID(row);
+
+					ImGui::TableSetColumnIndex(0);
+					if (ImGui::Selectable(PCKDiff::getChangeTypeString(change.type), selected == rows[row], ImGuiSelectableFlags_SpanAllColumns))
+					{
+						selected = rows[row];
+
+						// follows along in the tree, as long as the file is still in the current PCK File
+						if (change.newFile != PCKDiff::NONE)
+							gInstance->selectedNodePath = diff.getNewFiles()[change.newFile].path;
+					}
+
+					ImGui::TableSetColumnIndex(1);
+					if (change.oldFile != PCKDiff::NONE)
+						ImGui::TextUnformatted(diff.getOldFiles()[change.oldFile].path.c_str());
+
+					ImGui::TableSetColumnIndex(2);
+					if (change.newFile != PCKDiff::NONE)
+						ImGui::TextUnformatted(diff.getNewFiles()[change.newFile].path.c_str());
+
+					ImGui::PopID();
+				}
+			}
+
+			ImGui::EndTable();
+		}
+
+		if (selected < diff.getChanges().size())
+		{
+			const PCKDiff::Change& change = diff.getChanges()[selected];
+			const PCKFile::IndexEntry* oldFile = change.oldFile != PCKDiff::NONE ? &diff.getOldFiles()[change.oldFile] : nullptr;
+			const PCKFile::IndexEntry* newFile = change.newFile != PCKDiff::NONE ? &diff.getNewFiles()[change.newFile] : nullptr;
+
+			if (!oldFile || !newFile)
+			{
+				const PCKFile::IndexEntry& file = oldFile ? *oldFile : *newFile;
+				ImGui::Text("%s, %llu bytes, %zu properties", file.path.c_str(), (unsigned long long)file.size, file.properties.size());
+			}
+			else
+			{
+				if (change.dataChanged)
+					ImGui::Text("Data: %llu -> %llu bytes", (unsigned long long)oldFile->size, (unsigned long long)newFile->size);
+				if (change.typeChanged)
+					ImGui::Text("Type: %s -> %s", PCKAssetFile::getAssetTypeStringDisplay(oldFile->type), PCKAssetFile::getAssetTypeStringDisplay(newFile->type));
+
+				if (!change.properties.empty() && ImGui::BeginTable("PropertyChanges", 3, flags))
+				{
+					ImGui::TableSetupScrollFreeze(0, 1);
+					ImGui::TableSetupColumn("Key", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+					ImGui::TableSetupColumn(oldName.c_str(), ImGuiTableColumnFlags_WidthStretch);
+					ImGui::TableSetupColumn(pckFile->getFileName().c_str(), ImGuiTableColumnFlags_WidthStretch);
+					ImGui::TableHeadersRow();
+
+					for (const PCKDiff::PropertyChange& property : change.properties)
+					{
+						ImGui::TableNextRow();
+						ImGui::TableSetColumnIndex(0);
+						ImGui::TextUnformatted(property.key.c_str());
+						ImGui::TableSetColumnIndex(1);
+						if (property.hasOld)
+							ImGui::TextUnformatted(Binary::ToUTF8(property.oldValue).c_str());
+						ImGui::TableSetColumnIndex(2);
+						if (property.hasNew)
+							ImGui::TextUnformatted(Binary::ToUTF8(property.newValue).c_str());
+					}
+
+					ImGui::EndTable();
+				}
+			}
+		}
+	}
+	ImGui::End();
+
+	if (!open)
+	{
+		gInstance->comparison.reset();
+		rowsSource = nullptr;
+	}
+}
+
+void UIImGui::FlushEdits()
+{
+	PCKFile* pckFile = gInstance ? gInstance->GetCurrentPCKFile() : nullptr;
+	if (!pckFile)
+		return;
+
+	// only looked for if there's something to write, since it goes through every file
+	if (gLocFile->isModified())
+		if (PCKAssetFile* file = FindEditedFile(*pckFile, gLocSource, gLocRevision))
+			WriteBackEdits(*gLocFile, *file);
+
+	if (gGrfFile->isModified())
+		if (PCKAssetFile* file = FindEditedFile(*pckFile, gGrfSource, gGrfRevision))
+			WriteBackEdits(*gGrfFile, *file);
+
+	if (gColFile->isModified())
+		if (PCKAssetFile* file = FindEditedFile(*pckFile, gColSource, gColRevision))
+			WriteBackEdits(*gColFile, *file);
+}
+
+void UIImGui::RequestGlyphs(const std::string& text)
+{
+	mFonts.RequestGlyphs(text);
+}
+
+void UIImGui::RequestGlyphs(const std::u16string& text)
+{
+	mFonts.RequestGlyphs(text);
+}
+
+void UIImGui::RequestGlyphs(const PCKFile& pckFile)
+{
+	RequestGlyphs(pckFile.getFileName());
+
+	for (const PCKAssetFile& file : pckFile.getFiles())
+	{
+		RequestGlyphs(file.getPath());
+
+		for (const auto& [key, value] : file.getProperties())
+			RequestGlyphs(value);
+	}
+}
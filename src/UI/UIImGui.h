@@ -4,6 +4,7 @@
 #include <imgui.h>
 #include "Backends/PlatformBackend.h"
 #include "Backends/RendererBackend.h"
+#include "UI/FontAtlas.h"
 #include "UI/UIBase.h"
 
 class UIImGui : public UIBase {
@@ -41,6 +42,18 @@ public:
     // Renders the preview window in the main program form using ImGui elements, takes file to preview
     void RenderPreviewWindow(PCKAssetFile& file) override;
 
+    // Renders a virtualized table of every key and language of a LOC file, with every string editable
+    void RenderLocalisationWindow(PCKAssetFile& file) override;
+
+    // Renders the rule tree of a GRF file, reading rules as they're opened, next to a table of the selected rule's attributes
+    void RenderGameRulesWindow(PCKAssetFile& file) override;
+
+    // Renders every colour and water colour of a COL file with a colour picker, filtered by name
+    void RenderColourTableWindow(PCKAssetFile& file) override;
+
+    // Renders every model of a models.bin file from one pooled vertex buffer, next to virtualized lists of models and parts
+    void RenderModelsWindow(PCKAssetFile& file) override;
+
     // Renders the properties window in the main program form using ImGui elements, takes file to get properties from lol
     void RenderPropertiesWindow(PCKAssetFile& file) override;
 
@@ -52,6 +65,35 @@ public:
 
     // Handles keyboard input using ImGui and SDL, respectively
     void HandleInput() override;
+
+    // Renders a modal with the progress of the running job, with a button to cancel it
+    void RenderJobProgress() override;
+
+    // Renders a small window listing every zone of the last frame and how long it took
+    void RenderTraceOverlay() override;
+
+    // Renders a virtualized table of every set of files with identical data, and how many bytes the copies take up
+    void RenderDuplicatesWindow() override;
+
+    // Renders the changes between the compared PCK File and the current one side by side, with the property changes of the selected one below
+    void RenderComparisonWindow() override;
+
+    // Writes the changes of the LOC, GRF and COL editors back into the files they were opened on, if those are still in the PCK File
+    void FlushEdits() override;
+
+    // Queues the glyphs of a UTF-8 string to be baked into the font atlas before the next frame
+    void RequestGlyphs(const std::string& text) override;
+
+    // Queues the glyphs of a UTF-16 string to be baked into the font atlas before the next frame
+    void RequestGlyphs(const std::u16string& text) override;
+
+    // Queues the glyphs of every file path and property value of a PCK file
+    void RequestGlyphs(const PCKFile& pckFile) override;
+
+private:
+    FontAtlas mFonts{};
+    bool mShowTraceOverlay{ false };
+    bool mShowDuplicates{ false };
 };
 
 // Helpful opertaors for ImVec2
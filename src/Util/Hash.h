@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Fast non-cryptographic hashing, for telling apart file data without comparing all of it, and the checksums file formats store
+namespace Hash
+{
+	// Gets the 64-bit xxHash (XXH64) of some data; four independent lanes per 32 byte stripe, so the compiler can keep them all in flight at once
+	uint64_t XXH64(const void* data, size_t size, uint64_t seed = 0);
+
+	// Gets the CRC-32 of some data, the same one zlib and PNG use, continuing from a previous CRC if given one
+	uint32_t CRC32(const void* data, size_t size, uint32_t crc = 0);
+}
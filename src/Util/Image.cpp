@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include "Util/Hash.h"
+#include "Util/Image.h"
+#include "Util/Trace.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+Image Image::Decode(const void* data, size_t size)
+{
+	TRACE_SCOPE("Image decode");
+
+	int width, height, channels;
+	stbi_uc* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(data), static_cast<int>(size), &width, &height, &channels, 4);
+	if (!pixels)
+		return {};
+
+	Image image;
+	image.width = width;
+	image.height = height;
+	image.pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+
+	stbi_image_free(pixels);
+
+	return image;
+}
+
+Image Image::Resize(int newWidth, int newHeight) const
+{
+	Image resized(newWidth, newHeight);
+	if (empty() || newWidth <= 0 || newHeight <= 0)
+		return resized;
+
+	const float scaleX = (float)width / newWidth;
+	const float scaleY = (float)height / newHeight;
+
+	for (int y = 0; y < newHeight; ++y)
+	{
+		int y0 = (int)(y * scaleY);
+		int y1 = std::max(y0 + 1, std::min(height, (int)((y + 1) * scaleY)));
+
+		for (int x = 0; x < newWidth; ++x)
+		{
+			int x0 = (int)(x * scaleX);
+			int x1 = std::max(x0 + 1, std::min(width, (int)((x + 1) * scaleX)));
+
+			// premultiplied so transparent pixels don't bleed their color into the edges
+			float r = 0, g = 0, b = 0, a = 0;
+			int count = 0;
+
+			for (int sy = y0; sy < y1; ++sy)
+			{
+				for (int sx = x0; sx < x1; ++sx)
+				{
+					const unsigned char* p = &pixels[(static_cast<size_t>(sy) * width + sx) * 4];
+					float alpha = p[3] / 255.0f;
+					r += p[0] * alpha;
+					g += p[1] * alpha;
+					b += p[2] * alpha;
+					a += p[3];
+					++count;
+				}
+			}
+
+			unsigned char* out = &resized.pixels[(static_cast<size_t>(y) * newWidth + x) * 4];
+			float coverage = a / 255.0f;
+			if (coverage > 0.0f)
+			{
+				out[0] = static_cast<unsigned char>(std::min(255.0f, r / coverage + 0.5f));
+				out[1] = static_cast<unsigned char>(std::min(255.0f, g / coverage + 0.5f));
+				out[2] = static_cast<unsigned char>(std::min(255.0f, b / coverage + 0.5f));
+			}
+			out[3] = static_cast<unsigned char>(a / count + 0.5f);
+		}
+	}
+
+	return resized;
+}
+
+void Image::Blit(const Image& source, int x, int y)
+{
+	for (int row = 0; row < source.height; ++row)
+	{
+		int targetY = y + row;
+		if (targetY < 0 || targetY >= height)
+			continue;
+
+		int start = std::max(0, -x);
+		int end = std::min(source.width, width - x);
+		if (start >= end)
+			continue;
+
+		std::copy(source.pixels.begin() + (static_cast<size_t>(row) * source.width + start) * 4,
+			source.pixels.begin() + (static_cast<size_t>(row) * source.width + end) * 4,
+			pixels.begin() + (static_cast<size_t>(targetY) * width + x + start) * 4);
+	}
+}
+
+static void PutInt32BE(std::vector<unsigned char>& out, uint32_t value)
+{
+	out.push_back(static_cast<unsigned char>(value >> 24));
+	out.push_back(static_cast<unsigned char>(value >> 16));
+	out.push_back(static_cast<unsigned char>(value >> 8));
+	out.push_back(static_cast<unsigned char>(value));
+}
+
+static void PutChunk(std::vector<unsigned char>& out, const char* type, const std::vector<unsigned char>& data)
+{
+	PutInt32BE(out, static_cast<uint32_t>(data.size()));
+
+	size_t typeStart = out.size();
+	out.insert(out.end(), type, type + 4);
+	out.insert(out.end(), data.begin(), data.end());
+
+	PutInt32BE(out, Hash::CRC32(out.data() + typeStart, out.size() - typeStart));
+}
+
+std::vector<unsigned char> Image::EncodePNG() const
+{
+	static const unsigned char PNG_SIGNATURE[8]{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	std::vector<unsigned char> png(std::begin(PNG_SIGNATURE), std::end(PNG_SIGNATURE));
+
+	std::vector<unsigned char> header;
+	PutInt32BE(header, static_cast<uint32_t>(width));
+	PutInt32BE(header, static_cast<uint32_t>(height));
+	header.insert(header.end(), { 8, 6, 0, 0, 0 }); // 8 bit RGBA, no interlacing
+	PutChunk(png, "IHDR", header);
+
+	// every scanline is prefixed with its filter type; 0 is none
+	const size_t stride = static_cast<size_t>(width) * 4;
+	std::vector<unsigned char> raw;
+	raw.reserve((stride + 1) * height);
+	for (int y = 0; y < height; ++y)
+	{
+		raw.push_back(0);
+		raw.insert(raw.end(), pixels.begin() + y * stride, pixels.begin() + (y + 1) * stride);
+	}
+
+	// zlib stream made of stored deflate blocks
+	std::vector<unsigned char> zlib{ 0x78, 0x01 };
+	zlib.reserve(raw.size() + raw.size() / 0xFFFF * 5 + 16);
+
+	size_t pos = 0;
+	do
+	{
+		uint16_t blockSize = static_cast<uint16_t>(std::min<size_t>(raw.size() - pos, 0xFFFF));
+		bool last = pos + blockSize == raw.size();
+
+		zlib.push_back(last ? 1 : 0);
+		zlib.push_back(static_cast<unsigned char>(blockSize));
+		zlib.push_back(static_cast<unsigned char>(blockSize >> 8));
+		zlib.push_back(static_cast<unsigned char>(~blockSize));
+		zlib.push_back(static_cast<unsigned char>(~blockSize >> 8));
+		zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + blockSize);
+
+		pos += blockSize;
+	} while (pos < raw.size());
+
+	uint32_t a = 1, b = 0;
+	for (unsigned char c : raw)
+	{
+		a = (a + c) % 65521;
+		b = (b + a) % 65521;
+	}
+	PutInt32BE(zlib, (b << 16) | a);
+
+	PutChunk(png, "IDAT", zlib);
+	PutChunk(png, "IEND", {});
+
+	return png;
+}
+
+bool Image::WritePNG(const std::string& path) const
+{
+	if (empty())
+		return false;
+
+	std::vector<unsigned char> png = EncodePNG();
+
+	std::ofstream out(path, std::ios::binary);
+	if (!out)
+		return false;
+
+	out.write(reinterpret_cast<const char*>(png.data()), png.size());
+	return out.good();
+}
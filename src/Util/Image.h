@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Decoded 8 bit RGBA image, top row first; for CPU side image work that doesn't need a graphics context
+struct Image
+{
+	int width{ 0 };
+	int height{ 0 };
+	std::vector<unsigned char> pixels{};
+
+	Image() = default;
+	Image(int width, int height) : width(width), height(height), pixels(static_cast<size_t>(width) * height * 4, 0) {}
+
+	// Is there any image data?
+	bool empty() const { return width <= 0 || height <= 0 || pixels.empty(); }
+
+	// Decodes PNG or TGA data; returns an empty image on failure
+	static Image Decode(const void* data, size_t size);
+
+	// Gets a resized copy; downscaling averages every covered pixel (weighted by alpha) so small icons stay smooth
+	Image Resize(int newWidth, int newHeight) const;
+
+	// Copies another image into this one at the given position; parts outside of this image are cut off
+	void Blit(const Image& source, int x, int y);
+
+	// Encodes the image as an uncompressed (stored deflate) PNG
+	std::vector<unsigned char> EncodePNG() const;
+
+	// Writes the image to disk as PNG
+	bool WritePNG(const std::string& path) const;
+};
@@ -0,0 +1,188 @@
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "Util/ImageAtlas.h"
+
+static const char ATLAS_MAGIC[8]{ 'P', 'C', 'K', 'P', 'P', 'A', 'T', 'L' };
+static const uint32_t ATLAS_FORMAT_VERSION = 1;
+
+// Smallest a region takes up in a cache file: its name length, an empty name, and its x, y, width and height
+static const size_t ATLAS_MIN_REGION_SIZE = sizeof(uint32_t) + 4 * sizeof(int);
+
+ImageAtlas ImageAtlas::Pack(const std::vector<std::pair<std::string, Image>>& images, int cellSize, int padding)
+{
+	ImageAtlas atlas;
+
+	const int count = static_cast<int>(images.size());
+	const int columns = std::max(1, (int)std::ceil(std::sqrt((double)count)));
+	const int rows = std::max(1, (count + columns - 1) / columns);
+	const int stride = cellSize + padding * 2;
+
+	atlas.mImage = Image(columns * stride, rows * stride);
+
+	for (int i = 0; i < count; ++i)
+	{
+		const auto& [name, image] = images[i];
+
+		int x = (i % columns) * stride + padding;
+		int y = (i / columns) * stride + padding;
+
+		if (!image.empty())
+		{
+			const Image& cell = (image.width == cellSize && image.height == cellSize) ? image : image.Resize(cellSize, cellSize);
+			atlas.mImage.Blit(cell, x, y);
+		}
+
+		atlas.mRegions.push_back({ name, x, y, cellSize, cellSize });
+	}
+
+	return atlas;
+}
+
+const ImageAtlas::Region* ImageAtlas::findRegion(const std::string& name) const
+{
+	for (const Region& region : mRegions)
+	{
+		if (region.name == name)
+			return &region;
+	}
+	return nullptr;
+}
+
+uint64_t ImageAtlas::FingerprintFiles(const std::vector<std::string>& paths, uint32_t salt)
+{
+	// FNV-1a
+	uint64_t hash = 0xCBF29CE484222325ull;
+	auto mix = [&hash](const void* data, size_t size) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001B3ull;
+		}
+	};
+
+	mix(&salt, sizeof(salt));
+
+	for (const std::string& path : paths)
+	{
+		std::error_code error;
+		uint64_t size = std::filesystem::file_size(path, error);
+		int64_t time = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+		mix(path.data(), path.size());
+		mix(&size, sizeof(size));
+		mix(&time, sizeof(time));
+	}
+
+	return hash;
+}
+
+// The cache is only ever read back by the machine that wrote it, so values are stored in native byte order
+template<typename T>
+static void WriteValue(std::ofstream& out, const T& value)
+{
+	out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool ReadValue(const std::vector<char>& blob, size_t& pos, T& value)
+{
+	if (pos + sizeof(T) > blob.size())
+		return false;
+	std::memcpy(&value, blob.data() + pos, sizeof(T));
+	pos += sizeof(T);
+	return true;
+}
+
+bool ImageAtlas::Save(const std::string& path, uint64_t fingerprint) const
+{
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+	std::ofstream out(path, std::ios::binary);
+	if (!out)
+		return false;
+
+	out.write(ATLAS_MAGIC, sizeof(ATLAS_MAGIC));
+	WriteValue(out, ATLAS_FORMAT_VERSION);
+	WriteValue(out, fingerprint);
+	WriteValue(out, mImage.width);
+	WriteValue(out, mImage.height);
+	WriteValue(out, static_cast<uint32_t>(mRegions.size()));
+
+	for (const Region& region : mRegions)
+	{
+		WriteValue(out, static_cast<uint32_t>(region.name.size()));
+		out.write(region.name.data(), region.name.size());
+		WriteValue(out, region.x);
+		WriteValue(out, region.y);
+		WriteValue(out, region.width);
+		WriteValue(out, region.height);
+	}
+
+	out.write(reinterpret_cast<const char*>(mImage.pixels.data()), mImage.pixels.size());
+	return out.good();
+}
+
+bool ImageAtlas::Load(const std::string& path, uint64_t fingerprint, ImageAtlas& atlas)
+{
+	// one read for the whole blob, pixels included
+	std::ifstream in(path, std::ios::binary | std::ios::ate);
+	if (!in)
+		return false;
+
+	std::streamoff size = in.tellg();
+	if (size < 0)
+		return false;
+
+	std::vector<char> blob(static_cast<size_t>(size));
+	in.seekg(0);
+	if (!in.read(blob.data(), blob.size()))
+		return false;
+
+	size_t pos = sizeof(ATLAS_MAGIC);
+	if (blob.size() < pos || std::memcmp(blob.data(), ATLAS_MAGIC, sizeof(ATLAS_MAGIC)) != 0)
+		return false;
+
+	uint32_t version = 0, regionCount = 0;
+	uint64_t cachedFingerprint = 0;
+	Image image;
+
+	if (!ReadValue(blob, pos, version) || version != ATLAS_FORMAT_VERSION)
+		return false;
+	if (!ReadValue(blob, pos, cachedFingerprint) || cachedFingerprint != fingerprint)
+		return false;
+	if (!ReadValue(blob, pos, image.width) || !ReadValue(blob, pos, image.height) || !ReadValue(blob, pos, regionCount))
+		return false;
+
+	// a broken count is a cache miss like any other, rather than a huge allocation
+	if (regionCount > (blob.size() - pos) / ATLAS_MIN_REGION_SIZE)
+		return false;
+
+	std::vector<Region> regions(regionCount);
+	for (Region& region : regions)
+	{
+		uint32_t nameLength = 0;
+		if (!ReadValue(blob, pos, nameLength) || pos + nameLength > blob.size())
+			return false;
+
+		region.name.assign(blob.data() + pos, nameLength);
+		pos += nameLength;
+
+		if (!ReadValue(blob, pos, region.x) || !ReadValue(blob, pos, region.y) ||
+			!ReadValue(blob, pos, region.width) || !ReadValue(blob, pos, region.height))
+			return false;
+	}
+
+	size_t pixelSize = static_cast<size_t>(image.width) * image.height * 4;
+	if (image.width <= 0 || image.height <= 0 || blob.size() - pos != pixelSize)
+		return false;
+
+	image.pixels.assign(blob.begin() + pos, blob.end());
+
+	atlas.mImage = std::move(image);
+	atlas.mRegions = std::move(regions);
+	return true;
+}
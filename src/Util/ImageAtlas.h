@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Util/Image.h"
+
+// Many small images packed into one, so they can be uploaded and drawn from a single texture.
+// Can be cached to disk as one blob, so later runs skip decoding and packing the source images.
+class ImageAtlas
+{
+public:
+	// Named rectangle of the atlas, in pixels
+	struct Region
+	{
+		std::string name;
+		int x{ 0 }, y{ 0 };
+		int width{ 0 }, height{ 0 };
+	};
+
+	// Packs images into a grid of square cells, downscaling them to cellSize; padding keeps filtering from bleeding between cells
+	static ImageAtlas Pack(const std::vector<std::pair<std::string, Image>>& images, int cellSize, int padding = 2);
+
+	// Loads a cached atlas; fails if the file is missing, corrupt or was made from different sources
+	static bool Load(const std::string& path, uint64_t fingerprint, ImageAtlas& atlas);
+
+	// Caches the atlas to disk along with the fingerprint of the sources it was made from
+	bool Save(const std::string& path, uint64_t fingerprint) const;
+
+	// Gets the packed image
+	const Image& getImage() const { return mImage; }
+
+	// Gets all packed regions
+	const std::vector<Region>& getRegions() const { return mRegions; }
+
+	// Finds a region by name; nullptr if there is none
+	const Region* findRegion(const std::string& name) const;
+
+	// Fingerprints source files by their path, size and modification time, to know when a cached atlas is stale
+	static uint64_t FingerprintFiles(const std::vector<std::string>& paths, uint32_t salt = 0);
+
+private:
+	Image mImage{};
+	std::vector<Region> mRegions{};
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+// Thrown by long operations when they notice they were cancelled
+class JobCancelled : public std::runtime_error
+{
+public:
+	JobCancelled() : std::runtime_error("Operation was cancelled.") {}
+};
+
+// Progress and cancellation shared between a long running operation and whoever is watching it, from any thread
+class JobProgress
+{
+public:
+	// Sets the total amount of bytes to process
+	void setTotal(uint64_t bytes) { mTotal = bytes; }
+
+	// Adds to the amount of bytes processed
+	void advance(uint64_t bytes) { mDone += bytes; }
+
+	// Gets the amount of bytes processed
+	uint64_t getDone() const { return mDone; }
+
+	// Gets the total amount of bytes to process
+	uint64_t getTotal() const { return mTotal; }
+
+	// Gets the progress from 0 to 1
+	float getFraction() const
+	{
+		uint64_t total = mTotal;
+		return total > 0 ? static_cast<float>(static_cast<double>(mDone) / total) : 0.0f;
+	}
+
+	// Sets what's being worked on, like the current file path
+	void setStatus(const std::string& status)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStatus = status;
+	}
+
+	// Gets what's being worked on
+	std::string getStatus() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mStatus;
+	}
+
+	// Asks the operation to stop at its next check
+	void cancel() { mCancelled = true; }
+
+	// Checks whether the operation was asked to stop
+	bool isCancelled() const { return mCancelled; }
+
+	// Throws JobCancelled if the operation was asked to stop; call between units of work
+	void throwIfCancelled() const
+	{
+		if (mCancelled)
+			throw JobCancelled();
+	}
+
+private:
+	std::atomic<uint64_t> mDone{ 0 };
+	std::atomic<uint64_t> mTotal{ 0 };
+	std::atomic<bool> mCancelled{ false };
+	mutable std::mutex mMutex{};
+	std::string mStatus{};
+};
@@ -0,0 +1,187 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Util/Log.h"
+
+namespace Log
+{
+	static std::atomic<int> gLevel{ (int)Level::Info };
+
+	// A formatted message waiting to be written
+	struct Message
+	{
+		Level level;
+		std::string text;
+	};
+
+	// Writes queued messages on its own thread, so slow consoles don't hold up whoever logged them
+	class Sink
+	{
+	public:
+		~Sink()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				mStopping = true;
+			}
+			mWake.notify_one();
+
+			if (mThread.joinable())
+				mThread.join();
+		}
+
+		void Push(Level level, std::string&& text)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				if (mStopping)
+				{
+					// already shutting down, so there's nobody left to write it
+					WriteMessage({ level, std::move(text) });
+					return;
+				}
+
+				if (!mThread.joinable())
+					mThread = std::thread(&Sink::Run, this);
+
+				mQueue.push_back({ level, std::move(text) });
+			}
+			mWake.notify_one();
+		}
+
+		void Flush()
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mDrained.wait(lock, [this] { return mQueue.empty() && !mWriting; });
+		}
+
+	private:
+		static void WriteMessage(const Message& message)
+		{
+			// warnings and errors go to stderr, so they still show when stdout is piped somewhere
+			FILE* out = message.level >= Level::Warning ? stderr : stdout;
+			fwrite(message.text.data(), 1, message.text.size(), out);
+		}
+
+		void Run()
+		{
+			std::deque<Message> batch;
+			std::unique_lock<std::mutex> lock(mMutex);
+
+			while (true)
+			{
+				mWake.wait(lock, [this] { return mStopping || !mQueue.empty(); });
+
+				if (mQueue.empty() && mStopping)
+					break;
+
+				// everything queued so far is written in one go, without holding the lock
+				batch.swap(mQueue);
+				mWriting = true;
+				lock.unlock();
+
+				for (const Message& message : batch)
+					WriteMessage(message);
+				batch.clear();
+				fflush(stdout);
+
+				lock.lock();
+				mWriting = false;
+				mDrained.notify_all();
+			}
+		}
+
+		std::mutex mMutex;
+		std::condition_variable mWake;
+		std::condition_variable mDrained;
+		std::deque<Message> mQueue;
+		std::thread mThread;
+		bool mWriting{ false };
+		bool mStopping{ false };
+	};
+
+	// made on first use and destroyed at exit, which writes whatever is still queued
+	static Sink& GetSink()
+	{
+		static Sink sink;
+		return sink;
+	}
+
+	void SetLevel(Level level)
+	{
+		gLevel = (int)level;
+	}
+
+	Level GetLevel()
+	{
+		return (Level)gLevel.load();
+	}
+
+	bool IsEnabled(Level level)
+	{
+		return (int)level >= gLevel.load(std::memory_order_relaxed);
+	}
+
+	void Write(Level level, const char* format, ...)
+	{
+		static const char* prefixes[] = { "[debug] ", "", "[warning] ", "[error] " };
+
+		if (level >= Level::None)
+			return;
+
+		std::string text = prefixes[(int)level];
+		size_t prefixLength = text.size();
+
+		char buffer[512];
+
+		va_list args;
+		va_start(args, format);
+		int length = vsnprintf(buffer, sizeof(buffer), format, args);
+		va_end(args);
+
+		if (length < 0)
+			return;
+
+		if ((size_t)length < sizeof(buffer))
+		{
+			text.append(buffer, length);
+		}
+		else
+		{
+			text.resize(prefixLength + length + 1);
+			va_start(args, format);
+			vsnprintf(&text[prefixLength], length + 1, format, args);
+			va_end(args);
+			text.resize(prefixLength + length);
+		}
+
+		text += '\n';
+		GetSink().Push(level, std::move(text));
+	}
+
+	void Flush()
+	{
+		GetSink().Flush();
+	}
+
+	bool ParseLevel(const char* text, Level& level)
+	{
+		static const char* names[] = { "debug", "info", "warning", "error", "none" };
+
+		for (int i = 0; i < 5; ++i)
+		{
+			if (std::strcmp(text, names[i]) == 0)
+			{
+				level = (Level)i;
+				return true;
+			}
+		}
+		return false;
+	}
+}
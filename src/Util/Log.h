@@ -0,0 +1,50 @@
+#pragma once
+
+// Lowest level that's compiled in at all; anything below it costs nothing, not even a check. Set by CMake
+#ifndef PCKPP_LOG_LEVEL
+#define PCKPP_LOG_LEVEL 0
+#endif
+
+// Leveled logging; messages are only formatted when their level is on, and are written out by a background thread
+namespace Log
+{
+	// spelled like this since DEBUG and ERROR are macros on some platforms
+	enum class Level
+	{
+		Debug,
+		Info,
+		Warning,
+		Error,
+		None
+	};
+
+	// Sets the lowest level that gets written; Info by default
+	void SetLevel(Level level);
+
+	// Gets the lowest level that gets written
+	Level GetLevel();
+
+	// Whether messages of a level get written
+	bool IsEnabled(Level level);
+
+	// Formats a message printf style and queues it to be written; use the LOG_ macros so the arguments are only evaluated when needed
+	void Write(Level level, const char* format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+		__attribute__((format(printf, 2, 3)))
+#endif
+		;
+
+	// Waits until every queued message was written
+	void Flush();
+
+	// Parses "debug", "info", "warning", "error" or "none"
+	bool ParseLevel(const char* text, Level& level);
+}
+
+#define PCKPP_LOG(level, minimum, ...) do { if (PCKPP_LOG_LEVEL <= (minimum) && Log::IsEnabled(level)) Log::Write(level, __VA_ARGS__); } while (0)
+
+// Per entry dumps and other things only wanted while chasing down a problem
+#define LOG_DEBUG(...) PCKPP_LOG(Log::Level::Debug, 0, __VA_ARGS__)
+#define LOG_INFO(...) PCKPP_LOG(Log::Level::Info, 1, __VA_ARGS__)
+#define LOG_WARNING(...) PCKPP_LOG(Log::Level::Warning, 2, __VA_ARGS__)
+#define LOG_ERROR(...) PCKPP_LOG(Log::Level::Error, 3, __VA_ARGS__)
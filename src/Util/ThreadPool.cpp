@@ -0,0 +1,65 @@
+#include <algorithm>
+#include "Util/ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	mWorkers.reserve(threadCount);
+	for (unsigned int i = 0; i < threadCount; ++i)
+		mWorkers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+	mTaskAvailable.notify_all();
+
+	for (std::thread& worker : mWorkers)
+		worker.join();
+}
+
+void ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mIdle.wait(lock, [this] { return mTasks.empty() && mActiveTasks == 0; });
+}
+
+size_t ThreadPool::getThreadCount() const
+{
+	return mWorkers.size();
+}
+
+void ThreadPool::WorkerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mTaskAvailable.wait(lock, [this] { return mStopping || !mTasks.empty(); });
+
+			// keep draining the queue on shutdown so no future is left without a value
+			if (mTasks.empty())
+				return;
+
+			task = std::move(mTasks.front());
+			mTasks.pop();
+			++mActiveTasks;
+		}
+
+		task(); // packaged tasks store exceptions in their future, so nothing escapes here
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			--mActiveTasks;
+			if (mTasks.empty() && mActiveTasks == 0)
+				mIdle.notify_all();
+		}
+	}
+}
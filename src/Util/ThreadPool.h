@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed size pool of worker threads for fanning out independent jobs, like rendering skins or writing files
+class ThreadPool
+{
+public:
+	// Starts the workers; 0 uses one thread per hardware thread
+	explicit ThreadPool(unsigned int threadCount = 0);
+
+	// Finishes all queued tasks, then joins the workers
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Queues a task; the returned future holds its result or the exception it threw
+	template<typename F>
+	auto Submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+	{
+		using Result = std::invoke_result_t<std::decay_t<F>>;
+
+		auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+		std::future<Result> future = packaged->get_future();
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mTasks.emplace([packaged] { (*packaged)(); });
+		}
+		mTaskAvailable.notify_one();
+
+		return future;
+	}
+
+	// Blocks until every queued task has finished
+	void Wait();
+
+	// Gets the amount of worker threads
+	size_t getThreadCount() const;
+
+private:
+	void WorkerLoop();
+
+	std::vector<std::thread> mWorkers{};
+	std::queue<std::function<void()>> mTasks{};
+	std::mutex mMutex{};
+	std::condition_variable mTaskAvailable{};
+	std::condition_variable mIdle{};
+	size_t mActiveTasks{ 0 };
+	bool mStopping{ false };
+};
@@ -0,0 +1,151 @@
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include "Util/Trace.h"
+
+namespace Trace
+{
+	std::atomic<bool> gEnabled{ false };
+
+	// A finished zone; times are in nanoseconds since the program started
+	struct Event
+	{
+		const char* name;
+		uint64_t start;
+		uint64_t duration;
+		uint32_t threadId;
+	};
+
+	// past this many events new ones are dropped, so leaving tracing on can't eat all memory
+	static const size_t MAX_EVENTS = 1 << 20;
+
+	static const auto gStartTime = std::chrono::steady_clock::now();
+	static std::atomic<uint32_t> gNextThreadId{ 0 };
+
+	static std::mutex gMutex;
+	static std::vector<Event> gEvents;
+	static size_t gDroppedEvents = 0;
+	static std::vector<ZoneTiming> gCurrentFrame;
+	static std::vector<ZoneTiming> gLastFrame;
+
+	static uint32_t GetThreadId()
+	{
+		thread_local uint32_t threadId = gNextThreadId.fetch_add(1);
+		return threadId;
+	}
+
+	uint64_t Zone::Now()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - gStartTime).count();
+	}
+
+	void Zone::Record(const char* name, uint64_t start, uint64_t end)
+	{
+		uint32_t threadId = GetThreadId();
+		std::lock_guard<std::mutex> lock(gMutex);
+
+		if (gEvents.size() < MAX_EVENTS)
+			gEvents.push_back({ name, start, end - start, threadId });
+		else
+			++gDroppedEvents;
+
+		// few different zones run per frame, so a flat list beats a map here
+		for (ZoneTiming& timing : gCurrentFrame)
+		{
+			if (timing.name == name)
+			{
+				++timing.count;
+				timing.milliseconds += (end - start) / 1000000.0;
+				return;
+			}
+		}
+		gCurrentFrame.push_back({ name, 1, (end - start) / 1000000.0 });
+	}
+
+	void SetEnabled(bool enabled)
+	{
+		gEnabled = enabled && IsCompiledIn();
+	}
+
+	bool IsEnabled()
+	{
+		return gEnabled;
+	}
+
+	void BeginFrame()
+	{
+		std::lock_guard<std::mutex> lock(gMutex);
+		gLastFrame.swap(gCurrentFrame);
+		gCurrentFrame.clear();
+	}
+
+	std::vector<ZoneTiming> GetLastFrame()
+	{
+		std::lock_guard<std::mutex> lock(gMutex);
+		return gLastFrame;
+	}
+
+	size_t GetEventCount()
+	{
+		std::lock_guard<std::mutex> lock(gMutex);
+		return gEvents.size();
+	}
+
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock(gMutex);
+		gEvents.clear();
+		gEvents.shrink_to_fit();
+		gDroppedEvents = 0;
+	}
+
+	// Writes a zone name as a JSON string; names are usually plain literals, but better safe
+	static void WriteJSONString(FILE* out, const char* text)
+	{
+		fputc('"', out);
+		for (const char* c = text; *c; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+				fputc('\\', out);
+			if ((unsigned char)*c >= 0x20)
+				fputc(*c, out);
+		}
+		fputc('"', out);
+	}
+
+	void WriteChromeTrace(const std::string& path)
+	{
+		// copied out, so zones on other threads aren't held up while the file is written
+		std::vector<Event> events;
+		size_t droppedEvents;
+		{
+			std::lock_guard<std::mutex> lock(gMutex);
+			events = gEvents;
+			droppedEvents = gDroppedEvents;
+		}
+
+		FILE* out = fopen(path.c_str(), "wb");
+		if (!out)
+			throw std::runtime_error("Could not open trace file for writing: " + path);
+
+		fprintf(out, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":%zu},\"traceEvents\":[", droppedEvents);
+
+		for (size_t i = 0; i < events.size(); ++i)
+		{
+			const Event& event = events[i];
+			fprintf(out, "%s\n{\"name\":", i == 0 ? "" : ",");
+			WriteJSONString(out, event.name);
+			fprintf(out, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				event.threadId, event.start / 1000.0, event.duration / 1000.0);
+		}
+
+		fprintf(out, "\n]}\n");
+
+		bool failed = ferror(out) != 0;
+		fclose(out);
+
+		if (failed)
+			throw std::runtime_error("Failed to write trace file: " + path);
+	}
+}
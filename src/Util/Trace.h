@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Scoped timing zones for finding out where time goes; compiled in with PCKPP_ENABLE_TRACING and recorded only while turned on
+namespace Trace
+{
+	// How long a zone took in total over the last frame
+	struct ZoneTiming
+	{
+		const char* name{ nullptr };
+		uint32_t count{ 0 };
+		double milliseconds{ 0.0 };
+	};
+
+	// Whether zones were compiled in at all
+	constexpr bool IsCompiledIn()
+	{
+#ifdef PCKPP_ENABLE_TRACING
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	// Turns recording of zones on or off
+	void SetEnabled(bool enabled);
+
+	// Whether zones are being recorded
+	bool IsEnabled();
+
+	// Ends the current frame, so its zone timings show up in GetLastFrame; called once per frame by the main loop
+	void BeginFrame();
+
+	// Gets the zone timings of the last finished frame, including zones of other threads that ended during it
+	std::vector<ZoneTiming> GetLastFrame();
+
+	// Gets how many zones were recorded since the last clear
+	size_t GetEventCount();
+
+	// Forgets every recorded zone
+	void Clear();
+
+	// Writes every recorded zone as Chrome trace JSON, for chrome://tracing or Perfetto
+	void WriteChromeTrace(const std::string& path);
+
+	// Checked inline by zones, so a disabled zone costs one relaxed load
+	extern std::atomic<bool> gEnabled;
+
+	// Records the time between its construction and destruction; use TRACE_SCOPE instead of this directly
+	class Zone
+	{
+	public:
+		explicit Zone(const char* name)
+		{
+			if (gEnabled.load(std::memory_order_relaxed))
+			{
+				mName = name;
+				mStart = Now();
+			}
+		}
+
+		~Zone()
+		{
+			if (mName)
+				Record(mName, mStart, Now());
+		}
+
+		Zone(const Zone&) = delete;
+		Zone& operator=(const Zone&) = delete;
+
+	private:
+		static uint64_t Now();
+		static void Record(const char* name, uint64_t start, uint64_t end);
+
+		const char* mName{ nullptr };
+		uint64_t mStart{ 0 };
+	};
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// Times the rest of the enclosing scope under a name, which must be a string literal or otherwise live forever
+#ifdef PCKPP_ENABLE_TRACING
+#define TRACE_SCOPE(name) Trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#endif
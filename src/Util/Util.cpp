@@ -1,4 +1,5 @@
 #include "Binary/Binary.h"
+#include "Util/Log.h"
 #include "Util/Util.h"
 
 std::vector<unsigned char> IO::ReadFile(const std::string& path) {
@@ -7,14 +8,14 @@ std::vector<unsigned char> IO::ReadFile(const std::string& path) {
     return std::vector<unsigned char>(std::istreambuf_iterator<char>(file), {});
 }
 
-void IO::WriteFile(const std::string& path, const std::vector<unsigned char>& fileData, const std::vector<PCKAssetFile::Property>& properties) {
+void IO::WriteFile(const std::string& path, const unsigned char* fileData, size_t size, const std::vector<PCKAssetFile::Property>& properties) {
     std::ofstream ofile(path, std::ios::binary);
     if (!ofile.is_open()) {
-        printf("Failed to open file for writing: %s\n", path.c_str());
+        LOG_ERROR("Failed to open file for writing: %s", path.c_str());
         return;
     }
 
-    ofile.write(reinterpret_cast<const char*>(fileData.data()), fileData.size());
+    ofile.write(reinterpret_cast<const char*>(fileData), size);
     ofile.close();
 
     if (!properties.empty()) {
@@ -10,8 +10,8 @@ namespace IO
 	// Read file from disk to byte vector
 	std::vector<unsigned char> ReadFile(const std::string& path);
 
-	// Write file to disk from byte vector
-	void WriteFile(const std::string& path, const std::vector<unsigned char>& fileData, const std::vector<PCKAssetFile::Property>& properties = {});
+	// Write file to disk from bytes
+	void WriteFile(const std::string& path, const unsigned char* fileData, size_t size, const std::vector<PCKAssetFile::Property>& properties = {});
 }
 
 namespace String
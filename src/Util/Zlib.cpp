@@ -0,0 +1,608 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "Util/ThreadPool.h"
+#include "Util/Trace.h"
+#include "Util/Zlib.h"
+
+// Base lengths and distances of every length and distance code, and how many extra bits they take
+static const uint16_t LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const uint8_t CODE_LENGTH_ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+// Furthest back a match can reach
+static const size_t WINDOW_SIZE = 32768;
+
+// Codes up to this many bits are decoded with one table lookup
+static const int FAST_BITS = 9;
+
+// Input is compressed in pieces of this size, one per task
+static const size_t DEFLATE_CHUNK_SIZE = 128 * 1024;
+
+// Most earlier positions looked at for a match; higher compresses better and slower
+static const int MAX_CHAIN = 64;
+
+static uint32_t ReverseBits(uint32_t code, int length)
+{
+	uint32_t reversed = 0;
+	for (int i = 0; i < length; ++i)
+	{
+		reversed = (reversed << 1) | (code & 1);
+		code >>= 1;
+	}
+	return reversed;
+}
+
+namespace
+{
+	// Canonical Huffman code; counts and symbols for the slow path, and a lookup table for short codes
+	struct Huffman
+	{
+		uint16_t count[16]{};
+		uint16_t symbol[288]{};
+		uint16_t fast[1 << FAST_BITS]{}; // symbol << 4 | length, 0 if the code is longer
+	};
+
+	// Decompresses a whole zlib stream, keeping only the last window of output around
+	class Inflater
+	{
+	public:
+		Inflater(const unsigned char* data, size_t size, const Zlib::Sink& sink)
+			: mData(data), mSize(size), mSink(sink), mWindow(WINDOW_SIZE * 2)
+		{
+		}
+
+		void Run()
+		{
+			if (mSize < 6)
+				throw std::runtime_error("zlib data too short");
+
+			uint32_t cmf = Bits(8);
+			uint32_t flg = Bits(8);
+			if ((cmf & 0x0F) != 8 || ((cmf << 8) | flg) % 31 != 0)
+				throw std::runtime_error("Invalid zlib header");
+			if (flg & 0x20)
+				throw std::runtime_error("zlib preset dictionaries aren't supported");
+
+			bool last;
+			do
+			{
+				last = Bits(1);
+				switch (Bits(2))
+				{
+				case 0: Stored(); break;
+				case 1: Fixed(); break;
+				case 2: Dynamic(); break;
+				default: throw std::runtime_error("Invalid deflate block type");
+				}
+			} while (!last);
+
+			Flush();
+
+			// the checksum starts on the next byte
+			Bits(mBitCount % 8);
+			uint32_t expected = 0;
+			for (int i = 0; i < 4; ++i)
+				expected = (expected << 8) | Bits(8);
+
+			if (expected != mAdler)
+				throw std::runtime_error("zlib checksum mismatch");
+		}
+
+	private:
+		void Refill()
+		{
+			while (mBitCount <= 56)
+			{
+				uint64_t byte = mPosition < mSize ? mData[mPosition] : 0; // zeros past the end, caught in Consume
+				++mPosition;
+				mBitBuffer |= byte << mBitCount;
+				mBitCount += 8;
+			}
+		}
+
+		void Consume(int count)
+		{
+			mBitBuffer >>= count;
+			mBitCount -= count;
+
+			if (mPosition * 8 - mBitCount > mSize * 8)
+				throw std::runtime_error("zlib data cut off");
+		}
+
+		uint32_t Bits(int count)
+		{
+			if (count == 0)
+				return 0;
+			if (mBitCount < count)
+				Refill();
+
+			uint32_t value = static_cast<uint32_t>(mBitBuffer & ((1ull << count) - 1));
+			Consume(count);
+			return value;
+		}
+
+		static void Build(Huffman& huffman, const uint8_t* lengths, int count)
+		{
+			huffman = {};
+
+			for (int i = 0; i < count; ++i)
+				++huffman.count[lengths[i]];
+
+			// over-subscribed codes can't be decoded; incomplete ones are fine, like a single distance code
+			int left = 1;
+			for (int length = 1; length < 16; ++length)
+			{
+				left = (left << 1) - huffman.count[length];
+				if (left < 0)
+					throw std::runtime_error("Invalid deflate code lengths");
+			}
+
+			uint16_t offsets[16]{};
+			for (int length = 1; length < 15; ++length)
+				offsets[length + 1] = offsets[length] + huffman.count[length];
+
+			for (int i = 0; i < count; ++i)
+			{
+				if (lengths[i])
+					huffman.symbol[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+			}
+
+			uint32_t next[16]{};
+			uint32_t code = 0;
+			for (int length = 1; length < 16; ++length)
+			{
+				code = (code + (length > 1 ? huffman.count[length - 1] : 0)) << 1;
+				next[length] = code;
+			}
+
+			for (int i = 0; i < count; ++i)
+			{
+				int length = lengths[i];
+				if (length == 0)
+					continue;
+
+				uint32_t assigned = next[length]++;
+				if (length > FAST_BITS)
+					continue;
+
+				for (uint32_t j = ReverseBits(assigned, length); j < (1u << FAST_BITS); j += 1u << length)
+					huffman.fast[j] = static_cast<uint16_t>(i << 4 | length);
+			}
+		}
+
+		int Decode(const Huffman& huffman)
+		{
+			if (mBitCount < 15)
+				Refill();
+
+			uint16_t entry = huffman.fast[mBitBuffer & ((1 << FAST_BITS) - 1)];
+			if (entry)
+			{
+				Consume(entry & 15);
+				return entry >> 4;
+			}
+
+			// longer codes are walked a bit at a time
+			int code = 0, first = 0, index = 0;
+			for (int length = 1; length < 16; ++length)
+			{
+				code |= Bits(1);
+				int count = huffman.count[length];
+				if (code - count < first)
+					return huffman.symbol[index + (code - first)];
+				index += count;
+				first = (first + count) << 1;
+				code <<= 1;
+			}
+
+			throw std::runtime_error("Invalid deflate code");
+		}
+
+		void Emit(unsigned char byte)
+		{
+			if (mHave == mWindow.size())
+				Slide();
+			mWindow[mHave++] = byte;
+		}
+
+		// Hands everything not yet handed out to the sink, then keeps just the last window for matches
+		void Slide()
+		{
+			Flush();
+			std::memmove(mWindow.data(), mWindow.data() + mHave - WINDOW_SIZE, WINDOW_SIZE);
+			mHave = WINDOW_SIZE;
+			mFlushed = WINDOW_SIZE;
+		}
+
+		void Flush()
+		{
+			if (mHave == mFlushed)
+				return;
+
+			mAdler = Zlib::Adler32(mWindow.data() + mFlushed, mHave - mFlushed, mAdler);
+			mSink(mWindow.data() + mFlushed, mHave - mFlushed);
+			mFlushed = mHave;
+		}
+
+		void Stored()
+		{
+			Bits(mBitCount % 8);
+
+			uint32_t length = Bits(16);
+			uint32_t complement = Bits(16);
+			if (length != (~complement & 0xFFFF))
+				throw std::runtime_error("Invalid stored block length");
+
+			for (uint32_t i = 0; i < length; ++i)
+				Emit(static_cast<unsigned char>(Bits(8)));
+		}
+
+		void Codes(const Huffman& lengths, const Huffman& distances)
+		{
+			while (true)
+			{
+				int symbol = Decode(lengths);
+
+				if (symbol < 256)
+				{
+					Emit(static_cast<unsigned char>(symbol));
+					continue;
+				}
+				if (symbol == 256)
+					return;
+
+				symbol -= 257;
+				if (symbol >= 29)
+					throw std::runtime_error("Invalid deflate length code");
+				size_t length = LENGTH_BASE[symbol] + Bits(LENGTH_EXTRA[symbol]);
+
+				int distanceSymbol = Decode(distances);
+				if (distanceSymbol >= 30)
+					throw std::runtime_error("Invalid deflate distance code");
+				size_t distance = DISTANCE_BASE[distanceSymbol] + Bits(DISTANCE_EXTRA[distanceSymbol]);
+
+				if (distance > mHave)
+					throw std::runtime_error("Deflate distance too far back");
+
+				for (size_t i = 0; i < length; ++i)
+					Emit(mWindow[mHave - distance]);
+			}
+		}
+
+		void Fixed()
+		{
+			struct FixedCodes
+			{
+				Huffman lengths, distances;
+			};
+
+			// built once, by whichever thread gets there first
+			static const FixedCodes codes = []() {
+				FixedCodes built;
+				uint8_t codeLengths[288];
+				std::fill(codeLengths, codeLengths + 144, 8);
+				std::fill(codeLengths + 144, codeLengths + 256, 9);
+				std::fill(codeLengths + 256, codeLengths + 280, 7);
+				std::fill(codeLengths + 280, codeLengths + 288, 8);
+				Build(built.lengths, codeLengths, 288);
+
+				std::fill(codeLengths, codeLengths + 30, 5);
+				Build(built.distances, codeLengths, 30);
+				return built;
+			}();
+
+			Codes(codes.lengths, codes.distances);
+		}
+
+		void Dynamic()
+		{
+			int lengthCount = Bits(5) + 257;
+			int distanceCount = Bits(5) + 1;
+			int codeLengthCount = Bits(4) + 4;
+
+			if (lengthCount > 286 || distanceCount > 30)
+				throw std::runtime_error("Invalid deflate code counts");
+
+			uint8_t codeLengths[19]{};
+			for (int i = 0; i < codeLengthCount; ++i)
+				codeLengths[CODE_LENGTH_ORDER[i]] = static_cast<uint8_t>(Bits(3));
+
+			Huffman codeLengthCodes;
+			Build(codeLengthCodes, codeLengths, 19);
+
+			uint8_t lengths[316]{};
+			int index = 0;
+			while (index < lengthCount + distanceCount)
+			{
+				int symbol = Decode(codeLengthCodes);
+
+				if (symbol < 16)
+				{
+					lengths[index++] = static_cast<uint8_t>(symbol);
+					continue;
+				}
+
+				uint8_t repeated = 0;
+				int repeat;
+				if (symbol == 16)
+				{
+					if (index == 0)
+						throw std::runtime_error("Deflate length repeat with nothing before it");
+					repeated = lengths[index - 1];
+					repeat = 3 + Bits(2);
+				}
+				else if (symbol == 17)
+					repeat = 3 + Bits(3);
+				else
+					repeat = 11 + Bits(7);
+
+				if (index + repeat > lengthCount + distanceCount)
+					throw std::runtime_error("Too many deflate code lengths");
+
+				while (repeat--)
+					lengths[index++] = repeated;
+			}
+
+			if (lengths[256] == 0)
+				throw std::runtime_error("Deflate block without an end code");
+
+			Huffman lengthCodes, distanceCodes;
+			Build(lengthCodes, lengths, lengthCount);
+			Build(distanceCodes, lengths + lengthCount, distanceCount);
+
+			Codes(lengthCodes, distanceCodes);
+		}
+
+		const unsigned char* mData;
+		size_t mSize;
+		size_t mPosition{ 0 };
+		uint64_t mBitBuffer{ 0 };
+		int mBitCount{ 0 };
+		const Zlib::Sink& mSink;
+		std::vector<unsigned char> mWindow;
+		size_t mHave{ 0 }; // bytes in the window
+		size_t mFlushed{ 0 }; // bytes of the window already handed to the sink
+		uint32_t mAdler{ 1 };
+	};
+
+	// Writes bits the way deflate packs them, lowest first
+	class BitWriter
+	{
+	public:
+		explicit BitWriter(std::vector<unsigned char>& out)
+			: mOut(out)
+		{
+		}
+
+		void Write(uint32_t bits, int count)
+		{
+			mBuffer |= static_cast<uint64_t>(bits) << mCount;
+			mCount += count;
+			while (mCount >= 8)
+			{
+				mOut.push_back(static_cast<unsigned char>(mBuffer));
+				mBuffer >>= 8;
+				mCount -= 8;
+			}
+		}
+
+		// Huffman codes go in highest bit first
+		void WriteCode(uint32_t code, int length)
+		{
+			Write(ReverseBits(code, length), length);
+		}
+
+		void Align()
+		{
+			if (mCount > 0)
+				Write(0, 8 - mCount);
+		}
+
+	private:
+		std::vector<unsigned char>& mOut;
+		uint64_t mBuffer{ 0 };
+		int mCount{ 0 };
+	};
+}
+
+// Writes a literal or length symbol with the fixed Huffman code
+static void WriteFixedSymbol(BitWriter& writer, int symbol)
+{
+	if (symbol <= 143)
+		writer.WriteCode(0x30 + symbol, 8);
+	else if (symbol <= 255)
+		writer.WriteCode(0x190 + symbol - 144, 9);
+	else if (symbol <= 279)
+		writer.WriteCode(symbol - 256, 7);
+	else
+		writer.WriteCode(0xC0 + symbol - 280, 8);
+}
+
+static uint32_t Hash(const unsigned char* data)
+{
+	return ((data[0] << 10) ^ (data[1] << 5) ^ data[2]) & (WINDOW_SIZE - 1);
+}
+
+// Compresses one piece of the input as fixed Huffman deflate, ending on a byte boundary so the pieces can just be joined. Matches can reach back into the window before the piece, so splitting it up barely costs anything
+static std::vector<unsigned char> DeflateChunk(const unsigned char* data, size_t start, size_t end)
+{
+	std::vector<unsigned char> out;
+	out.reserve((end - start) / 2);
+
+	BitWriter writer(out);
+	writer.Write(0, 1); // not the last block; that's an empty one at the very end
+	writer.Write(1, 2); // fixed Huffman codes
+
+	std::vector<int64_t> head(WINDOW_SIZE, -1);
+	std::vector<int64_t> previous(WINDOW_SIZE, -1);
+
+	auto insert = [&](size_t position) {
+		if (position + 3 > end)
+			return;
+		uint32_t hash = Hash(data + position);
+		previous[position & (WINDOW_SIZE - 1)] = head[hash];
+		head[hash] = static_cast<int64_t>(position);
+	};
+
+	for (size_t position = start > WINDOW_SIZE ? start - WINDOW_SIZE : 0; position < start; ++position)
+		insert(position);
+
+	size_t position = start;
+	while (position < end)
+	{
+		size_t bestLength = 0;
+		size_t bestDistance = 0;
+
+		if (position + 3 <= end)
+		{
+			size_t maxLength = std::min<size_t>(258, end - position);
+			int64_t candidate = head[Hash(data + position)];
+
+			for (int chain = 0; candidate >= 0 && position - candidate <= WINDOW_SIZE && chain < MAX_CHAIN; ++chain)
+			{
+				const unsigned char* a = data + candidate;
+				const unsigned char* b = data + position;
+
+				size_t length = 0;
+				while (length < maxLength && a[length] == b[length])
+					++length;
+
+				if (length > bestLength)
+				{
+					bestLength = length;
+					bestDistance = position - candidate;
+					if (length == maxLength)
+						break;
+				}
+
+				candidate = previous[candidate & (WINDOW_SIZE - 1)];
+			}
+		}
+
+		if (bestLength >= 3)
+		{
+			int lengthCode = static_cast<int>(std::upper_bound(LENGTH_BASE, LENGTH_BASE + 29, bestLength) - LENGTH_BASE) - 1;
+			WriteFixedSymbol(writer, 257 + lengthCode);
+			writer.Write(static_cast<uint32_t>(bestLength - LENGTH_BASE[lengthCode]), LENGTH_EXTRA[lengthCode]);
+
+			int distanceCode = static_cast<int>(std::upper_bound(DISTANCE_BASE, DISTANCE_BASE + 30, bestDistance) - DISTANCE_BASE) - 1;
+			writer.WriteCode(distanceCode, 5);
+			writer.Write(static_cast<uint32_t>(bestDistance - DISTANCE_BASE[distanceCode]), DISTANCE_EXTRA[distanceCode]);
+
+			for (size_t i = 0; i < bestLength; ++i)
+				insert(position + i);
+			position += bestLength;
+		}
+		else
+		{
+			WriteFixedSymbol(writer, data[position]);
+			insert(position);
+			++position;
+		}
+	}
+
+	WriteFixedSymbol(writer, 256); // end of block
+
+	// an empty stored block, which pads out to the next byte
+	writer.Write(0, 1);
+	writer.Write(0, 2);
+	writer.Align();
+	out.insert(out.end(), { 0x00, 0x00, 0xFF, 0xFF });
+
+	return out;
+}
+
+void Zlib::Inflate(const unsigned char* data, size_t size, const Sink& sink)
+{
+	TRACE_SCOPE("Zlib::Inflate");
+
+	Inflater inflater(data, size, sink);
+	inflater.Run();
+}
+
+std::vector<unsigned char> Zlib::Deflate(const unsigned char* data, size_t size, unsigned int threadCount)
+{
+	TRACE_SCOPE("Zlib::Deflate");
+
+	size_t chunkCount = (size + DEFLATE_CHUNK_SIZE - 1) / DEFLATE_CHUNK_SIZE;
+
+	std::vector<std::vector<unsigned char>> chunks(chunkCount);
+	uint32_t adler;
+
+	if (chunkCount <= 1)
+	{
+		if (chunkCount == 1)
+			chunks[0] = DeflateChunk(data, 0, size);
+		adler = Adler32(data, size);
+	}
+	else
+	{
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		ThreadPool pool(static_cast<unsigned int>(std::min<size_t>(threadCount, chunkCount)));
+
+		std::vector<std::future<std::vector<unsigned char>>> futures;
+		futures.reserve(chunkCount);
+
+		for (size_t i = 0; i < chunkCount; ++i)
+		{
+			size_t start = i * DEFLATE_CHUNK_SIZE;
+			size_t end = std::min(size, start + DEFLATE_CHUNK_SIZE);
+			futures.push_back(pool.Submit([data, start, end]() { return DeflateChunk(data, start, end); }));
+		}
+
+		adler = Adler32(data, size); // while the pieces are being compressed
+
+		for (size_t i = 0; i < chunkCount; ++i)
+			chunks[i] = futures[i].get();
+	}
+
+	size_t totalSize = 2 + 2 + 4;
+	for (const auto& chunk : chunks)
+		totalSize += chunk.size();
+
+	std::vector<unsigned char> out;
+	out.reserve(totalSize);
+	out.insert(out.end(), { 0x78, 0x9C });
+
+	for (const auto& chunk : chunks)
+		out.insert(out.end(), chunk.begin(), chunk.end());
+
+	// last block: empty, with fixed codes, so it's just the end code
+	out.insert(out.end(), { 0x03, 0x00 });
+
+	for (int shift = 24; shift >= 0; shift -= 8)
+		out.push_back(static_cast<unsigned char>(adler >> shift));
+
+	return out;
+}
+
+uint32_t Zlib::Adler32(const unsigned char* data, size_t size, uint32_t adler)
+{
+	const uint32_t MOD = 65521;
+	const size_t MAX_RUN = 5552; // most bytes before the sums could overflow
+
+	uint32_t a = adler & 0xFFFF;
+	uint32_t b = adler >> 16;
+
+	while (size > 0)
+	{
+		size_t run = std::min(size, MAX_RUN);
+		size -= run;
+
+		while (run--)
+		{
+			a += *data++;
+			b += a;
+		}
+
+		a %= MOD;
+		b %= MOD;
+	}
+
+	return (b << 16) | a;
+}
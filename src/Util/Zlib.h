@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Just enough zlib for the game's compressed files, since there's no zlib to link against
+namespace Zlib
+{
+	// Gets called with every piece of decompressed data, in order
+	using Sink = std::function<void(const unsigned char* data, size_t size)>;
+
+	// Decompresses a zlib stream, handing the output to the sink in pieces as it goes instead of building it all up first. Throws if the data is broken
+	void Inflate(const unsigned char* data, size_t size, const Sink& sink);
+
+	// Compresses data into a zlib stream; pieces of it are compressed at the same time on a thread pool. 0 threads uses one per hardware thread
+	std::vector<unsigned char> Deflate(const unsigned char* data, size_t size, unsigned int threadCount = 0);
+
+	// Gets the Adler-32 checksum of some data, continuing from a previous checksum if given one
+	uint32_t Adler32(const unsigned char* data, size_t size, uint32_t adler = 1);
+}
@@ -1,12 +1,28 @@
 ﻿// PCK++ by May/MattNL :3
 
+#include <chrono>
+#include <cstdlib>
+
 #include "Application/Application.h"
 #include "Program/Program.h"
+#include "Util/Log.h"
+#include "Util/Trace.h"
 
 #include "Backends/ImGuiSDLPlatformBackend.hpp"
 #include "Backends/ImGuiOpenGLRendererBackend.hpp"
 
 int main(int argc, char* argv[]) {
+	// for keeping an eye on cold start time
+	const auto startTime = std::chrono::steady_clock::now();
+	bool firstFrame = true;
+
+	// PCKPP_LOG=debug dumps every entry of opened packs
+	Log::Level logLevel;
+	if (const char* logSetting = std::getenv("PCKPP_LOG")) {
+		if (Log::ParseLevel(logSetting, logLevel))
+			Log::SetLevel(logLevel);
+	}
+
 	if (!gApp->Init(argc, argv))
 		return 1;
 
@@ -41,12 +57,29 @@ int main(int argc, char* argv[]) {
 
 	while (!platform->ShouldClose()) {
 		platform->PollEvents(backend);
-		ui->NewFrame();
-		graphics->NewFrame();
-		gApp->Update();
-		ui->Render();
-		graphics->Render();
-		SDL_GL_SwapWindow(window);
+		Trace::BeginFrame(); // after waiting for events, so idle time isn't counted as part of the frame
+
+		{
+			TRACE_SCOPE("Frame");
+			ui->NewFrame();
+			graphics->NewFrame();
+			{
+				TRACE_SCOPE("Update");
+				gApp->Update();
+			}
+			{
+				TRACE_SCOPE("Render");
+				ui->Render();
+				graphics->Render();
+				SDL_GL_SwapWindow(window);
+			}
+		}
+
+		if (firstFrame) {
+			firstFrame = false;
+			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+			LOG_INFO("Time to first frame: %lld ms", (long long)elapsed.count());
+		}
 	}
 
 	ui->Shutdown();